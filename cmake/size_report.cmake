@@ -0,0 +1,33 @@
+# Post-build RAM report for CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SIZE_REPORT. Reads the
+# __rip_size_* absolute symbols from the linked image and prints the per-processor layout.
+#
+#   cmake -DNM=<nm> -DELF=<zephyr.elf> -P size_report.cmake
+
+execute_process(
+    COMMAND ${NM} ${ELF}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(WARNING "runtime input processor size report: '${NM} ${ELF}' failed")
+    return()
+endif()
+
+foreach(name size_data size_state size_plan size_config plan_slots instances)
+    if(NOT symbols MATCHES "([0-9a-fA-F]+) [aA] __rip_${name}\n")
+        message(WARNING "runtime input processor size report: __rip_${name} not found in ${ELF}")
+        return()
+    endif()
+    math(EXPR ${name} "0x${CMAKE_MATCH_1}")
+endforeach()
+
+math(EXPR plans "${size_plan} * ${plan_slots}")
+math(EXPR configs "${size_config} * 2")
+math(EXPR other "${size_data} - ${size_state} - ${plans} - ${configs}")
+math(EXPR total "${size_data} * ${instances}")
+
+message("Runtime input processors: ${instances} x ${size_data} B = ${total} B")
+message("  event path state    ${size_state} B")
+message("  plans               ${plans} B (${plan_slots} x ${size_plan} B)")
+message("  current/persistent  ${configs} B (2 x ${size_config} B)")
+message("  other               ${other} B (flags, keep map, profiles, settings, stats)")
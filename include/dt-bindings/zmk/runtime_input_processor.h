@@ -23,4 +23,23 @@
 /** Snap to Y axis (vertical only) */
 #define AXIS_SNAP_MODE_Y 2
 
+/** Snap to whichever axis leads the start of each gesture */
+#define AXIS_SNAP_MODE_AUTO 3
+
+/**
+ * @brief Acceleration curves for runtime input processor
+ */
+
+/** No acceleration */
+#define ACCEL_CURVE_NONE 0
+
+/** Gain rises linearly with speed */
+#define ACCEL_CURVE_LINEAR 1
+
+/** Gain rises with a power of speed */
+#define ACCEL_CURVE_POWER 2
+
+/** Gain interpolated from a lookup table */
+#define ACCEL_CURVE_LUT 3
+
 #endif /* ZMK_DT_BINDINGS_INPUT_PROCESSOR_H_ */
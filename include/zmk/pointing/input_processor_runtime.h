@@ -16,8 +16,28 @@ enum zmk_input_processor_axis_snap_mode {
     ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE = 0,
     ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_X = 1,
     ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_Y = 2,
+    ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_AUTO = 3, // Lock to the axis leading each gesture
 };
 
+/**
+ * @brief Pointer acceleration curve
+ */
+enum zmk_input_processor_accel_curve {
+    ZMK_INPUT_PROCESSOR_ACCEL_CURVE_NONE = 0,
+    ZMK_INPUT_PROCESSOR_ACCEL_CURVE_LINEAR = 1, // Gain rises linearly up to accel_gain_max
+    ZMK_INPUT_PROCESSOR_ACCEL_CURVE_POWER = 2,  // Gain rises with speed^accel_exponent
+    ZMK_INPUT_PROCESSOR_ACCEL_CURVE_LUT = 3,    // Gain is interpolated from accel_lut
+};
+
+/** Maximum number of points in a custom acceleration lookup table */
+#define ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS 16
+
+/** Largest smoothing filter shift (the filter moves 1/2^shift of the way per event) */
+#define ZMK_INPUT_PROCESSOR_FILTER_IIR_SHIFT_MAX 8
+
+/** Largest high-resolution scroll multiplier (wheel units per detent) */
+#define ZMK_INPUT_PROCESSOR_SCROLL_HIRES_MAX 120
+
 /**
  * @brief Runtime input processor configuration
  */
@@ -25,23 +45,165 @@ struct zmk_input_processor_runtime_config {
     uint32_t scale_multiplier;
     uint32_t scale_divisor;
     int32_t rotation_degrees;
+    // Active layers bitmask (0 = all layers, otherwise each bit represents a layer)
+    uint32_t active_layers;
     // Temp-layer layer settings
-    bool temp_layer_enabled;
-    uint8_t temp_layer_layer;
     uint16_t temp_layer_activation_delay_ms;
     uint16_t temp_layer_deactivation_delay_ms;
-    // Active layers bitmask (0 = all layers, otherwise each bit represents a layer)
-    uint32_t active_layers;
+    // Temp-layer motion gate: the layer activates once the motion magnitude
+    // (|x| + |y| input counts, decayed with a temp_layer_motion_window_ms
+    // half-life, 0 = each event on its own) reaches
+    // temp_layer_activation_threshold, and only motion keeping it at
+    // temp_layer_release_threshold or above holds the layer active (both 0 =
+    // any motion, as without the gate)
+    uint16_t temp_layer_activation_threshold;
+    uint16_t temp_layer_release_threshold;
+    uint16_t temp_layer_motion_window_ms;
     // Axis snap settings
-    uint8_t axis_snap_mode;        // zmk_input_processor_axis_snap_mode
     uint16_t axis_snap_threshold;  // Threshold for unsnapping
     uint16_t axis_snap_timeout_ms; // Time window for checking threshold
-    // Code mapping settings
-    bool xy_to_scroll_enabled; // Map X/Y to horizontal/vertical scroll
-    bool xy_swap_enabled;      // Swap X and Y axes
-    // Axis reverse settings
-    bool x_invert; // Whether to invert X axis
-    bool y_invert; // Whether to invert Y axis
+    // Acceleration settings (speed is measured on input counts per second)
+    uint16_t accel_speed_max; // Speed at which the curve reaches its last point
+    uint16_t accel_gain_max;  // Gain at accel_speed_max for linear/power (percent)
+    uint16_t accel_exponent;  // Power curve exponent (hundredths, 100 = linear)
+    // Gains (percent) at evenly spaced speeds from 0 to accel_speed_max
+    uint16_t accel_lut[ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS];
+    // Jitter filter settings, applied before the other stages: input is idle
+    // until it travels more than filter_dead_zone counts on one axis within
+    // filter_idle_ms, and filter_iir_shift sets the smoothing (0 = off)
+    uint16_t filter_dead_zone;
+    uint16_t filter_idle_ms;
+    // Scroll sub-pipeline for XY-to-scroll, used when both scale values are
+    // non-zero (otherwise the pointer scaling applies): input is scaled by
+    // scroll_scale_multiplier / scroll_scale_divisor detents per count and
+    // passed on in whole wheel units of 1/scroll_hires_multiplier detent (0 or
+    // 1 = whole detents)
+    uint16_t scroll_scale_multiplier;
+    uint16_t scroll_scale_divisor;
+    uint8_t accel_lut_len;  // Number of points in accel_lut
+    uint8_t accel_curve;    // zmk_input_processor_accel_curve
+    uint8_t axis_snap_mode; // zmk_input_processor_axis_snap_mode
+    uint8_t temp_layer_layer;
+    uint8_t filter_iir_shift;
+    uint8_t scroll_hires_multiplier;
+    // Flags, packed into one byte
+    bool temp_layer_enabled : 1;
+    bool xy_to_scroll_enabled : 1; // Map X/Y to horizontal/vertical scroll
+    bool xy_swap_enabled : 1;      // Swap X and Y axes
+    bool x_invert : 1;             // Whether to invert X axis
+    bool y_invert : 1;             // Whether to invert Y axis
+    bool scroll_snap : 1;          // Only scroll along the dominant axis
+};
+
+/**
+ * @brief Entry of the runtime input processor table, indexed by processor ID
+ */
+struct zmk_input_processor_runtime_entry {
+    const struct device *dev;
+    const char *name;
+    // Live persistent configuration. Updated in place by the setters, so
+    // copy it if a consistent snapshot across a setter call is needed.
+    const struct zmk_input_processor_runtime_config *config;
+};
+
+/**
+ * @brief Field selectors for zmk_input_processor_runtime_set_config()
+ */
+enum zmk_input_processor_runtime_config_field {
+    ZMK_INPUT_PROCESSOR_CONFIG_SCALE_MULTIPLIER = BIT(0),
+    ZMK_INPUT_PROCESSOR_CONFIG_SCALE_DIVISOR = BIT(1),
+    ZMK_INPUT_PROCESSOR_CONFIG_ROTATION_DEGREES = BIT(2),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED = BIT(3),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER = BIT(4),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_DELAY = BIT(5),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_DEACTIVATION_DELAY = BIT(6),
+    ZMK_INPUT_PROCESSOR_CONFIG_ACTIVE_LAYERS = BIT(7),
+    ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE = BIT(8),
+    ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_THRESHOLD = BIT(9),
+    ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_TIMEOUT = BIT(10),
+    ZMK_INPUT_PROCESSOR_CONFIG_XY_TO_SCROLL_ENABLED = BIT(11),
+    ZMK_INPUT_PROCESSOR_CONFIG_XY_SWAP_ENABLED = BIT(12),
+    ZMK_INPUT_PROCESSOR_CONFIG_X_INVERT = BIT(13),
+    ZMK_INPUT_PROCESSOR_CONFIG_Y_INVERT = BIT(14),
+    ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE = BIT(15),
+    ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_SPEED_MAX = BIT(16),
+    ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_GAIN_MAX = BIT(17),
+    ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_EXPONENT = BIT(18),
+    ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT = BIT(19), // accel_lut_len and accel_lut
+    ZMK_INPUT_PROCESSOR_CONFIG_FILTER_DEAD_ZONE = BIT(20),
+    ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT = BIT(21),
+    ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IDLE = BIT(22),
+    ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_MULTIPLIER = BIT(23),
+    ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_DIVISOR = BIT(24),
+    ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_HIRES = BIT(25),
+    ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SNAP = BIT(26),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD = BIT(27),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD = BIT(28),
+    ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_MOTION_WINDOW = BIT(29),
+};
+
+/** All fields of struct zmk_input_processor_runtime_config */
+#define ZMK_INPUT_PROCESSOR_CONFIG_ALL (BIT(30) - 1)
+
+/**
+ * @brief Transform stages counted in zmk_input_processor_runtime_stats
+ */
+enum zmk_input_processor_stats_stage {
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_REMAP = 0,      // XY swap / XY-to-scroll
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_TEMP_LAYER = 1, // Temp-layer activation tracking
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_ROTATE = 2,     // Rotation matrix
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_LINEAR = 3,     // Per-axis scale / inversion
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_AXIS_SNAP = 4,  // Cross-axis suppression
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_SCALE = 5,      // Scaling after axis snap
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_ACCEL = 6,      // Pointer acceleration
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_FILTER = 7,     // Dead zone and smoothing
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_SCROLL = 8,     // Scroll scaling to whole wheel units
+    ZMK_INPUT_PROCESSOR_STATS_STAGE_COUNT,
+};
+
+/** Number of buckets in the event handler cycle histogram */
+#define ZMK_INPUT_PROCESSOR_STATS_HISTOGRAM_BUCKETS 16
+
+/**
+ * @brief Event path statistics (CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+ */
+struct zmk_input_processor_runtime_stats {
+    uint32_t events;    // Events of the processor's type and codes
+    uint32_t processed; // Events that ran at least one stage
+    // Processed events per stage in the plan, indexed by zmk_input_processor_stats_stage
+    uint32_t stage_events[ZMK_INPUT_PROCESSOR_STATS_STAGE_COUNT];
+    uint32_t snap_suppressed;        // Cross-axis values zeroed by axis snap
+    uint32_t rotation_dropped;       // Values zeroed while waiting for the other axis
+    uint32_t overflows;              // Values saturated to the int16 range
+    uint32_t temp_layer_activations; // Times the temp-layer layer was activated
+    uint32_t coalesced;              // Events held back by coalescing
+    uint32_t filter_dropped;         // Idle input dropped by the filter dead zone
+    uint32_t scroll_held;            // Scroll events held back below a whole wheel unit
+    uint32_t cycles_max;             // Longest event handler call (hardware cycles)
+    // Event handler duration: bucket 0 counts calls taking 0 cycles, bucket i
+    // [2^(i-1), 2^i) cycles and the last bucket everything longer
+    uint32_t cycle_histogram[ZMK_INPUT_PROCESSOR_STATS_HISTOGRAM_BUCKETS];
+};
+
+/**
+ * @brief One live telemetry window (CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+ *
+ * Aggregates the events of the processor's type and codes over
+ * CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_INTERVAL_MS. Axis 0 is the
+ * input X axis and axis 1 the input Y axis; out[] is what the processor
+ * passed on for them, whatever code it was remapped to.
+ */
+struct zmk_input_processor_telemetry_sample {
+    uint32_t time_ms; // Window start (k_uptime_get_32())
+    int32_t in[2];    // Sum of the values handed to the processor
+    int32_t out[2];   // Sum of the values passed on (0 for stopped events)
+    uint16_t events;  // Events in the window
+    // Windows dropped right before this one because the reader fell behind
+    uint16_t lost;
+    // State at the end of the window
+    int8_t snap_axis;       // Axis snap is locked to (0 = X, 1 = Y), or -1
+    bool snap_unlocked;     // Cross-axis motion is past the axis snap threshold
+    bool temp_layer_active; // The temp-layer layer is active
 };
 
 /**
@@ -67,6 +229,84 @@ int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t m
 int zmk_input_processor_runtime_set_rotation(const struct device *dev, int32_t degrees,
                                              bool persistent);
 
+/**
+ * @brief Apply several configuration fields at once
+ *
+ * All selected fields are validated before anything is changed, then applied
+ * together with a single config publish, one state changed event and one
+ * settings save. Fields not selected in field_mask are left untouched.
+ *
+ * @param dev Pointer to the device structure
+ * @param config New values; only fields selected in field_mask are read
+ * @param field_mask Bitwise OR of zmk_input_processor_runtime_config_field values
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, -EINVAL if any selected value is invalid (nothing is changed)
+ */
+int zmk_input_processor_runtime_set_config(const struct device *dev,
+                                           const struct zmk_input_processor_runtime_config *config,
+                                           uint32_t field_mask, bool persistent);
+
+/**
+ * @brief Store a named configuration profile
+ *
+ * The profile's transform plan is precompiled so that selecting it later does
+ * not rebuild anything. Saving to settings is debounced.
+ *
+ * @param dev Pointer to the device structure
+ * @param index Profile index (< CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILES)
+ * @param name Profile name (truncated to CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILE_NAME_MAX_LEN)
+ * @param config Profile configuration, or NULL to use the current persistent configuration
+ * @return 0 on success, -EINVAL on invalid arguments, -ENOTSUP if profiles are disabled
+ */
+int zmk_input_processor_runtime_save_profile(
+    const struct device *dev, uint8_t index, const char *name,
+    const struct zmk_input_processor_runtime_config *config);
+
+/**
+ * @brief Delete a configuration profile
+ *
+ * @param dev Pointer to the device structure
+ * @param index Profile index
+ * @return 0 on success, -EINVAL on invalid arguments, -ENOTSUP if profiles are disabled
+ */
+int zmk_input_processor_runtime_delete_profile(const struct device *dev, uint8_t index);
+
+/**
+ * @brief Switch to a configuration profile
+ *
+ * Applies every field of the profile and swaps in its precompiled plan.
+ *
+ * @param dev Pointer to the device structure
+ * @param index Profile index
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, -ENOENT if the profile is empty, -EINVAL on invalid arguments,
+ *         -ENOTSUP if profiles are disabled
+ */
+int zmk_input_processor_runtime_select_profile(const struct device *dev, uint8_t index,
+                                               bool persistent);
+
+/**
+ * @brief Get a configuration profile
+ *
+ * @param dev Pointer to the device structure
+ * @param index Profile index
+ * @param name Pointer to store the profile name (can be NULL)
+ * @param config Pointer to store the profile configuration (can be NULL)
+ * @return 0 on success, -ENOENT if the profile is empty, -EINVAL on invalid arguments,
+ *         -ENOTSUP if profiles are disabled
+ */
+int zmk_input_processor_runtime_get_profile(const struct device *dev, uint8_t index,
+                                            const char **name,
+                                            struct zmk_input_processor_runtime_config *config);
+
+/**
+ * @brief Get the profile the current configuration was selected from
+ *
+ * @param dev Pointer to the device structure
+ * @return Profile index, or -1 if the configuration changed since (or no profile was selected)
+ */
+int zmk_input_processor_runtime_get_active_profile(const struct device *dev);
+
 /**
  * @brief Reset processor to default values and save to persistent storage
  *
@@ -93,9 +333,84 @@ void zmk_input_processor_runtime_restore_persistent(const struct device *dev);
 int zmk_input_processor_runtime_get_config(const struct device *dev, const char **name,
                                            struct zmk_input_processor_runtime_config *config);
 
+/**
+ * @brief Get the number of output values saturated to the int16 range
+ *
+ * @param dev Pointer to the device structure
+ * @return Overflow count, or 0 if CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_OVERFLOW_COUNTER is disabled
+ */
+uint32_t zmk_input_processor_runtime_get_overflow_count(const struct device *dev);
+
+/**
+ * @brief Get the event path statistics of a runtime input processor
+ *
+ * Counters are updated without locking, so a snapshot taken while events are
+ * being processed may be off by the event in flight.
+ *
+ * @param dev Pointer to the device structure
+ * @param stats Pointer to store the statistics
+ * @return 0 on success, -ENOTSUP if CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS is disabled,
+ *         negative error code on failure
+ */
+int zmk_input_processor_runtime_get_stats(const struct device *dev,
+                                          struct zmk_input_processor_runtime_stats *stats);
+
+/**
+ * @brief Clear the event path statistics of a runtime input processor
+ *
+ * @param dev Pointer to the device structure
+ * @return 0 on success, -ENOTSUP if CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS is disabled,
+ *         negative error code on failure
+ */
+int zmk_input_processor_runtime_reset_stats(const struct device *dev);
+
+/**
+ * @brief Start or stop sampling live telemetry for a runtime input processor
+ *
+ * Not persistent. While enabled, the event path closes a window every
+ * CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_INTERVAL_MS of motion into a
+ * ring buffer that zmk_input_processor_runtime_read_telemetry() drains. A
+ * window is closed by the first event after it ends, so the last window of a
+ * gesture is published when motion resumes.
+ *
+ * @param dev Pointer to the device structure
+ * @param enabled Whether to sample telemetry
+ * @return 0 on success, -ENOTSUP if CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY is disabled,
+ *         negative error code on failure
+ */
+int zmk_input_processor_runtime_set_telemetry(const struct device *dev, bool enabled);
+
+/**
+ * @brief Check whether live telemetry is being sampled for a runtime input processor
+ *
+ * @param dev Pointer to the device structure
+ * @return true if enabled, false if disabled or not supported
+ */
+bool zmk_input_processor_runtime_get_telemetry_enabled(const struct device *dev);
+
+/**
+ * @brief Take the oldest closed telemetry windows off the ring buffer
+ *
+ * The event path never waits for the reader: windows that find the ring full
+ * are dropped and counted in the lost field of the next one. Only one thread
+ * may read the telemetry of a processor. Windows left over from before
+ * telemetry was last enabled are discarded.
+ *
+ * @param dev Pointer to the device structure
+ * @param samples Array to store the windows in, oldest first
+ * @param max Number of entries in samples
+ * @return Number of windows stored, -ENOTSUP if CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY
+ *         is disabled, negative error code on failure
+ */
+int zmk_input_processor_runtime_read_telemetry(
+    const struct device *dev, struct zmk_input_processor_telemetry_sample *samples, size_t max);
+
 /**
  * @brief Find a runtime input processor by name
  *
+ * Linear in the number of processors; prefer resolving the device through a
+ * devicetree phandle where one is available.
+ *
  * @param name Name of the processor to find
  * @return Pointer to the device structure, or NULL if not found
  */
@@ -109,14 +424,33 @@ const struct device *zmk_input_processor_runtime_find_by_name(const char *name);
  */
 const struct device *zmk_input_processor_runtime_find_by_id(uint8_t id);
 
+/**
+ * @brief Get the processor table entry for an ID
+ *
+ * Unlike zmk_input_processor_runtime_get_config(), the configuration is not
+ * copied; the entry points at the live persistent values.
+ *
+ * @param id ID of the processor
+ * @return Pointer to the entry, or NULL if not found
+ */
+const struct zmk_input_processor_runtime_entry *zmk_input_processor_runtime_get_entry(uint8_t id);
+
 /**
  * @brief Get the ID of a runtime input processor
  *
  * @param dev Pointer to the device structure
- * @return ID of the processor, or -1 if not found
+ * @return ID of the processor, or -1 if dev is not a runtime input processor
  */
 int zmk_input_processor_runtime_get_id(const struct device *dev);
 
+/**
+ * @brief Get the name of a runtime input processor
+ *
+ * @param dev Pointer to the device structure
+ * @return Name of the processor, or NULL if dev is not a runtime input processor
+ */
+const char *zmk_input_processor_runtime_get_name(const struct device *dev);
+
 /**
  * @brief Iterate over all runtime input processors
  *
@@ -188,6 +522,30 @@ int zmk_input_processor_runtime_set_temp_layer_deactivation_delay(const struct d
                                                                   uint32_t deactivation_delay_ms,
                                                                   bool persistent);
 
+/**
+ * @brief Set the temp-layer motion gate
+ *
+ * Motion is accumulated as |x| + |y| input counts that decay with a window_ms
+ * half-life, and a key press clears it. The layer only activates once the
+ * accumulated motion reaches activation_threshold, so a bump of the desk does
+ * not switch layers. While the layer is active, only motion that keeps the
+ * accumulator at release_threshold or above restarts the deactivation delay,
+ * so the layer is released when the pointer settles instead of being held by
+ * sensor noise. With both thresholds at 0 any motion counts.
+ *
+ * @param dev Pointer to the device structure
+ * @param activation_threshold Accumulated motion that activates the layer (counts)
+ * @param release_threshold Accumulated motion that keeps the layer active
+ *                          (counts, at most activation_threshold)
+ * @param window_ms Half-life of the accumulated motion (ms, 0 = each event on its own)
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_input_processor_runtime_set_temp_layer_motion(const struct device *dev,
+                                                      uint16_t activation_threshold,
+                                                      uint16_t release_threshold,
+                                                      uint16_t window_ms, bool persistent);
+
 /**
  * @brief Set active layers bitmask
  *
@@ -300,3 +658,79 @@ int zmk_input_processor_runtime_set_x_invert(const struct device *dev, bool inve
  */
 int zmk_input_processor_runtime_set_y_invert(const struct device *dev, bool invert,
                                              bool persistent);
+
+/**
+ * @brief Set the acceleration curve for a runtime input processor
+ *
+ * Linear and power curves start at a gain of 1x at rest and reach gain_max at
+ * speed_max. The lookup table curve uses the points set with
+ * zmk_input_processor_runtime_set_accel_lut(). The curve is sampled into a
+ * fixed-point table when set, so the event path only interpolates.
+ *
+ * @param dev Pointer to the device structure
+ * @param curve Curve type (zmk_input_processor_accel_curve)
+ * @param speed_max Input speed in counts per second where the curve ends (must be > 0)
+ * @param gain_max Gain at speed_max in percent (100 = 1x), used by linear/power
+ * @param exponent Power curve exponent in hundredths (e.g. 150 = 1.5)
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_input_processor_runtime_set_accel(const struct device *dev, uint8_t curve,
+                                          uint16_t speed_max, uint16_t gain_max,
+                                          uint16_t exponent, bool persistent);
+
+/**
+ * @brief Set the acceleration lookup table for a runtime input processor
+ *
+ * @param dev Pointer to the device structure
+ * @param gains Gains in percent at evenly spaced speeds from 0 to accel_speed_max
+ * @param len Number of points (at most ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS)
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_input_processor_runtime_set_accel_lut(const struct device *dev, const uint16_t *gains,
+                                              uint8_t len, bool persistent);
+
+/**
+ * @brief Set the jitter filter for a runtime input processor
+ *
+ * Input is idle until it travels more than dead_zone counts on one axis
+ * within idle_ms, and becomes idle again after idle_ms without such travel.
+ * Idle input is dropped (the events are stopped) before any other stage runs,
+ * so sensor noise at rest does not reach temp-layer or later processors. With
+ * idle_ms at 0, the dead zone applies to each event on its own. The smoothing
+ * filter is a one-pole IIR low-pass on the remaining input that moves
+ * 1/2^iir_shift of the way to each new value.
+ *
+ * @param dev Pointer to the device structure
+ * @param dead_zone Travel in counts that ends idle (0 disables the dead zone)
+ * @param iir_shift Smoothing shift (0 disables smoothing, at most
+ *                  ZMK_INPUT_PROCESSOR_FILTER_IIR_SHIFT_MAX)
+ * @param idle_ms Time without travel beyond the dead zone after which input is idle (ms)
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_input_processor_runtime_set_filter(const struct device *dev, uint16_t dead_zone,
+                                           uint8_t iir_shift, uint16_t idle_ms, bool persistent);
+
+/**
+ * @brief Set the scroll sub-pipeline for a runtime input processor
+ *
+ * Used while XY-to-scroll is enabled, in place of the pointer scaling: input
+ * is scaled by multiplier / divisor detents per count into a per-axis
+ * accumulator and only passed on in whole wheel units, so most events are held
+ * back (stopped). Reversing direction drops the sub-unit rest. With snap, only
+ * the axis with the larger accumulated scroll moves.
+ *
+ * @param dev Pointer to the device structure
+ * @param multiplier Scroll scaling multiplier
+ * @param divisor Scroll scaling divisor (0 disables the sub-pipeline)
+ * @param hires_multiplier Wheel units per detent for high-resolution scrolling (0 or 1 for
+ *                         whole detents, at most ZMK_INPUT_PROCESSOR_SCROLL_HIRES_MAX)
+ * @param snap Whether to scroll along the dominant axis only
+ * @param persistent If true, save to persistent storage; if false, temporary
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_input_processor_runtime_set_scroll(const struct device *dev, uint16_t multiplier,
+                                           uint16_t divisor, uint8_t hires_multiplier, bool snap,
+                                           bool persistent);
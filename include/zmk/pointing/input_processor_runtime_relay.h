@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <zmk/pointing/input_processor_runtime.h>
+
+// Configuration relay from the central to a runtime input processor that runs
+// on a split peripheral. The central invokes the relay behavior
+// (zmk,behavior-input-processor-relay) on the peripheral once per changed
+// field and once more to apply the staged fields, so every step fits in the
+// two binding parameters: param1 = command | argument << 8, param2 = value.
+
+/**
+ * @brief Relay commands
+ */
+enum zmk_input_processor_relay_command {
+    // Stage the field whose zmk_input_processor_runtime_config_field bit index is
+    // the argument. The value of ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT is accel_lut_len.
+    ZMK_INPUT_PROCESSOR_RELAY_FIELD = 0,
+    // Stage accel_lut points 2 * argument (low half of param2) and 2 * argument + 1
+    ZMK_INPUT_PROCESSOR_RELAY_LUT_PAIR = 1,
+    // Apply the staged fields selected by the mask in param2
+    ZMK_INPUT_PROCESSOR_RELAY_APPLY = 2,
+};
+
+#define ZMK_INPUT_PROCESSOR_RELAY_PARAM1(command, argument) ((command) | ((argument) << 8))
+#define ZMK_INPUT_PROCESSOR_RELAY_COMMAND(param1) ((param1) & 0xff)
+#define ZMK_INPUT_PROCESSOR_RELAY_ARGUMENT(param1) (((param1) >> 8) & 0xff)
+
+/**
+ * @brief Read a configuration field as a relay value
+ *
+ * @param config Configuration to read from
+ * @param field Bit index of the zmk_input_processor_runtime_config_field
+ * @return The field value, or 0 for an unknown field
+ */
+static inline uint32_t
+zmk_input_processor_relay_get_field(const struct zmk_input_processor_runtime_config *config,
+                                    uint8_t field) {
+    switch (BIT(field)) {
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCALE_MULTIPLIER:
+        return config->scale_multiplier;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCALE_DIVISOR:
+        return config->scale_divisor;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ROTATION_DEGREES:
+        return (uint32_t)config->rotation_degrees;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED:
+        return config->temp_layer_enabled;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER:
+        return config->temp_layer_layer;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_DELAY:
+        return config->temp_layer_activation_delay_ms;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_DEACTIVATION_DELAY:
+        return config->temp_layer_deactivation_delay_ms;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACTIVE_LAYERS:
+        return config->active_layers;
+    case ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE:
+        return config->axis_snap_mode;
+    case ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_THRESHOLD:
+        return config->axis_snap_threshold;
+    case ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_TIMEOUT:
+        return config->axis_snap_timeout_ms;
+    case ZMK_INPUT_PROCESSOR_CONFIG_XY_TO_SCROLL_ENABLED:
+        return config->xy_to_scroll_enabled;
+    case ZMK_INPUT_PROCESSOR_CONFIG_XY_SWAP_ENABLED:
+        return config->xy_swap_enabled;
+    case ZMK_INPUT_PROCESSOR_CONFIG_X_INVERT:
+        return config->x_invert;
+    case ZMK_INPUT_PROCESSOR_CONFIG_Y_INVERT:
+        return config->y_invert;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE:
+        return config->accel_curve;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_SPEED_MAX:
+        return config->accel_speed_max;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_GAIN_MAX:
+        return config->accel_gain_max;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_EXPONENT:
+        return config->accel_exponent;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT:
+        return config->accel_lut_len;
+    case ZMK_INPUT_PROCESSOR_CONFIG_FILTER_DEAD_ZONE:
+        return config->filter_dead_zone;
+    case ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT:
+        return config->filter_iir_shift;
+    case ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IDLE:
+        return config->filter_idle_ms;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_MULTIPLIER:
+        return config->scroll_scale_multiplier;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_DIVISOR:
+        return config->scroll_scale_divisor;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_HIRES:
+        return config->scroll_hires_multiplier;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SNAP:
+        return config->scroll_snap;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD:
+        return config->temp_layer_activation_threshold;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD:
+        return config->temp_layer_release_threshold;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_MOTION_WINDOW:
+        return config->temp_layer_motion_window_ms;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Write a relay value to a configuration field
+ *
+ * Values are stored as is; zmk_input_processor_runtime_set_config() validates them.
+ *
+ * @param config Configuration to write to
+ * @param field Bit index of the zmk_input_processor_runtime_config_field
+ * @param value Field value
+ * @return 0 on success, -EINVAL for an unknown field
+ */
+static inline int
+zmk_input_processor_relay_set_field(struct zmk_input_processor_runtime_config *config,
+                                    uint8_t field, uint32_t value) {
+    switch (BIT(field)) {
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCALE_MULTIPLIER:
+        config->scale_multiplier = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCALE_DIVISOR:
+        config->scale_divisor = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ROTATION_DEGREES:
+        config->rotation_degrees = (int32_t)value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED:
+        config->temp_layer_enabled = value != 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER:
+        config->temp_layer_layer = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_DELAY:
+        config->temp_layer_activation_delay_ms = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_DEACTIVATION_DELAY:
+        config->temp_layer_deactivation_delay_ms = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACTIVE_LAYERS:
+        config->active_layers = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE:
+        config->axis_snap_mode = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_THRESHOLD:
+        config->axis_snap_threshold = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_TIMEOUT:
+        config->axis_snap_timeout_ms = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_XY_TO_SCROLL_ENABLED:
+        config->xy_to_scroll_enabled = value != 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_XY_SWAP_ENABLED:
+        config->xy_swap_enabled = value != 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_X_INVERT:
+        config->x_invert = value != 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_Y_INVERT:
+        config->y_invert = value != 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE:
+        config->accel_curve = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_SPEED_MAX:
+        config->accel_speed_max = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_GAIN_MAX:
+        config->accel_gain_max = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_EXPONENT:
+        config->accel_exponent = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT:
+        // Out of range lengths are rejected when the fields are applied
+        config->accel_lut_len = MIN(value, UINT8_MAX);
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_FILTER_DEAD_ZONE:
+        config->filter_dead_zone = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT:
+        config->filter_iir_shift = MIN(value, UINT8_MAX);
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IDLE:
+        config->filter_idle_ms = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_MULTIPLIER:
+        config->scroll_scale_multiplier = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_DIVISOR:
+        config->scroll_scale_divisor = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_HIRES:
+        config->scroll_hires_multiplier = MIN(value, UINT8_MAX);
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SNAP:
+        config->scroll_snap = value != 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD:
+        config->temp_layer_activation_threshold = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD:
+        config->temp_layer_release_threshold = value;
+        break;
+    case ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_MOTION_WINDOW:
+        config->temp_layer_motion_window_ms = value;
+        break;
+    default:
+        return -EINVAL;
+    }
+    return 0;
+}
@@ -15,12 +15,14 @@
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 struct behavior_input_processor_axis_snap_config {
-    const char *processor_name;
+    const struct device *processor; // From the processor phandle, or NULL
+    const char *processor_name;     // Looked up when processor is not set
     uint16_t timeout_ms;
 };
 
 struct behavior_input_processor_axis_snap_data {
     const struct device *processor;
+    const char *processor_name;
     bool is_active;
 };
 
@@ -28,15 +30,23 @@ static int behavior_input_processor_axis_snap_init(const struct device *dev) {
     struct behavior_input_processor_axis_snap_data *data = dev->data;
     const struct behavior_input_processor_axis_snap_config *cfg = dev->config;
 
-    // Find the processor by name
-    data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    // Prefer the processor phandle, resolved at build time, over a lookup by name
+    data->processor = cfg->processor;
+    if (!data->processor) {
+        data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    }
     if (!data->processor) {
         LOG_ERR("Input processor '%s' not found", cfg->processor_name);
         return -ENODEV;
     }
+    data->processor_name = zmk_input_processor_runtime_get_name(data->processor);
+    if (!data->processor_name) {
+        LOG_ERR("%s is not a runtime input processor", data->processor->name);
+        return -EINVAL;
+    }
 
     data->is_active = false;
-    LOG_DBG("Axis snap behavior initialized for processor: %s", cfg->processor_name);
+    LOG_DBG("Axis snap behavior initialized for processor: %s", data->processor_name);
     return 0;
 }
 
@@ -67,7 +77,7 @@ static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
 
     data->is_active = true;
     LOG_INF("Applied temporary axis snap to %s: mode=%d, threshold=%d, timeout=%d",
-            cfg->processor_name, snap_mode, threshold, timeout_ms);
+            data->processor_name, snap_mode, threshold, timeout_ms);
 
     return ZMK_BEHAVIOR_OPAQUE;
 }
@@ -76,7 +86,6 @@ static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
                                       struct zmk_behavior_binding_event event) {
     const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
     struct behavior_input_processor_axis_snap_data *data = dev->data;
-    const struct behavior_input_processor_axis_snap_config *cfg = dev->config;
 
     if (!data->processor || !data->is_active) {
         return 0;
@@ -86,7 +95,7 @@ static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
     zmk_input_processor_runtime_restore_persistent(data->processor);
 
     data->is_active = false;
-    LOG_INF("Restored persistent config for %s", cfg->processor_name);
+    LOG_INF("Restored persistent config for %s", data->processor_name);
 
     return ZMK_BEHAVIOR_OPAQUE;
 }
@@ -97,11 +106,15 @@ static const struct behavior_driver_api behavior_input_processor_axis_snap_drive
 };
 
 #define AXIS_SNAP_INST(n)                                                                          \
+    BUILD_ASSERT(DT_INST_NODE_HAS_PROP(n, processor) || DT_INST_NODE_HAS_PROP(n, processor_name), \
+                 "processor or processor-name is required");                                       \
     static struct behavior_input_processor_axis_snap_data                                          \
         behavior_input_processor_axis_snap_data_##n;                                               \
     static const struct behavior_input_processor_axis_snap_config                                  \
         behavior_input_processor_axis_snap_config_##n = {                                          \
-            .processor_name = DT_INST_PROP(n, processor_name),                                     \
+            .processor = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, processor),                          \
+                                     (DEVICE_DT_GET(DT_INST_PHANDLE(n, processor))), (NULL)),      \
+            .processor_name = DT_INST_PROP_OR(n, processor_name, NULL),                            \
             .timeout_ms = DT_INST_PROP_OR(n, timeout_ms, 1000),                                    \
     };                                                                                             \
     BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_axis_snap_init, NULL,                      \
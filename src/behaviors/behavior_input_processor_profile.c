@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_input_processor_profile
+
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+#include <zephyr/logging/log.h>
+#include <zmk/pointing/input_processor_runtime.h>
+#include <zmk/behavior.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+struct behavior_input_processor_profile_config {
+    const struct device *processor; // From the processor phandle, or NULL
+    const char *processor_name;     // Looked up when processor is not set
+    bool momentary;
+};
+
+struct behavior_input_processor_profile_data {
+    const struct device *processor;
+    const char *processor_name;
+    bool is_active;
+};
+
+static int behavior_input_processor_profile_init(const struct device *dev) {
+    struct behavior_input_processor_profile_data *data = dev->data;
+    const struct behavior_input_processor_profile_config *cfg = dev->config;
+
+    // Prefer the processor phandle, resolved at build time, over a lookup by name
+    data->processor = cfg->processor;
+    if (!data->processor) {
+        data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    }
+    if (!data->processor) {
+        LOG_ERR("Input processor '%s' not found", cfg->processor_name);
+        return -ENODEV;
+    }
+    data->processor_name = zmk_input_processor_runtime_get_name(data->processor);
+    if (!data->processor_name) {
+        LOG_ERR("%s is not a runtime input processor", data->processor->name);
+        return -EINVAL;
+    }
+
+    data->is_active = false;
+    LOG_DBG("Profile behavior initialized for processor: %s", data->processor_name);
+    return 0;
+}
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
+                                     struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_profile_data *data = dev->data;
+    const struct behavior_input_processor_profile_config *cfg = dev->config;
+
+    if (!data->processor) {
+        return -ENODEV;
+    }
+
+    // Get profile index from binding (param1 = index). Momentary switches are
+    // temporary; latched switches are saved (debounced) like any other change.
+    uint8_t index = binding->param1;
+    int ret = zmk_input_processor_runtime_select_profile(data->processor, index, !cfg->momentary);
+    if (ret < 0) {
+        LOG_ERR("Failed to select profile %d: %d", index, ret);
+        return ret;
+    }
+
+    data->is_active = cfg->momentary;
+    LOG_INF("Selected profile %d for %s%s", index, data->processor_name,
+            cfg->momentary ? " (momentary)" : "");
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_profile_data *data = dev->data;
+
+    if (!data->processor || !data->is_active) {
+        return 0;
+    }
+
+    // Restore persistent configuration
+    zmk_input_processor_runtime_restore_persistent(data->processor);
+
+    data->is_active = false;
+    LOG_INF("Restored persistent config for %s", data->processor_name);
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_input_processor_profile_driver_api = {
+    .binding_pressed = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define PROFILE_INST(n)                                                                            \
+    BUILD_ASSERT(DT_INST_NODE_HAS_PROP(n, processor) || DT_INST_NODE_HAS_PROP(n, processor_name), \
+                 "processor or processor-name is required");                                       \
+    static struct behavior_input_processor_profile_data behavior_input_processor_profile_data_##n; \
+    static const struct behavior_input_processor_profile_config                                    \
+        behavior_input_processor_profile_config_##n = {                                            \
+            .processor = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, processor),                          \
+                                     (DEVICE_DT_GET(DT_INST_PHANDLE(n, processor))), (NULL)),      \
+            .processor_name = DT_INST_PROP_OR(n, processor_name, NULL),                            \
+            .momentary = DT_INST_PROP(n, momentary),                                               \
+    };                                                                                             \
+    BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_profile_init, NULL,                        \
+                            &behavior_input_processor_profile_data_##n,                            \
+                            &behavior_input_processor_profile_config_##n, POST_KERNEL,             \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                                   \
+                            &behavior_input_processor_profile_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(PROFILE_INST)
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_input_processor_relay
+
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+#include <zephyr/logging/log.h>
+#include <zmk/pointing/input_processor_runtime.h>
+#include <zmk/pointing/input_processor_runtime_relay.h>
+#include <zmk/behavior.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// Receives the configuration of a runtime processor that runs on this split
+// peripheral from the central (see input_processor_runtime_relay.h). Fields
+// are staged one invocation at a time and applied together.
+
+struct behavior_input_processor_relay_config {
+    const struct device *processor; // From the processor phandle, or NULL
+    const char *processor_name;     // Looked up when processor is not set
+};
+
+struct behavior_input_processor_relay_data {
+    const struct device *processor;
+    const char *processor_name;
+    struct zmk_input_processor_runtime_config staged;
+};
+
+static int behavior_input_processor_relay_init(const struct device *dev) {
+    struct behavior_input_processor_relay_data *data = dev->data;
+    const struct behavior_input_processor_relay_config *cfg = dev->config;
+
+    // Prefer the processor phandle, resolved at build time, over a lookup by name
+    data->processor = cfg->processor;
+    if (!data->processor) {
+        data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    }
+    if (!data->processor) {
+        LOG_ERR("Input processor '%s' not found", cfg->processor_name);
+        return -ENODEV;
+    }
+    data->processor_name = zmk_input_processor_runtime_get_name(data->processor);
+    if (!data->processor_name) {
+        LOG_ERR("%s is not a runtime input processor", data->processor->name);
+        return -EINVAL;
+    }
+
+    LOG_DBG("Relay behavior initialized for processor: %s", data->processor_name);
+    return 0;
+}
+
+static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
+                                     struct zmk_behavior_binding_event event) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct behavior_input_processor_relay_data *data = dev->data;
+
+    if (!data->processor) {
+        return -ENODEV;
+    }
+
+    uint8_t argument = ZMK_INPUT_PROCESSOR_RELAY_ARGUMENT(binding->param1);
+    int ret;
+
+    switch (ZMK_INPUT_PROCESSOR_RELAY_COMMAND(binding->param1)) {
+    case ZMK_INPUT_PROCESSOR_RELAY_FIELD:
+        ret = zmk_input_processor_relay_set_field(&data->staged, argument, binding->param2);
+        break;
+    case ZMK_INPUT_PROCESSOR_RELAY_LUT_PAIR:
+        if (argument >= ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS / 2) {
+            ret = -EINVAL;
+            break;
+        }
+        data->staged.accel_lut[argument * 2] = binding->param2 & 0xffff;
+        data->staged.accel_lut[argument * 2 + 1] = binding->param2 >> 16;
+        ret = 0;
+        break;
+    case ZMK_INPUT_PROCESSOR_RELAY_APPLY:
+        // Temporary: the central keeps the persistent configuration
+        ret = zmk_input_processor_runtime_set_config(data->processor, &data->staged,
+                                                     binding->param2, false);
+        if (ret == 0) {
+            LOG_INF("Applied relayed config fields 0x%08x to %s", binding->param2,
+                    data->processor_name);
+        }
+        break;
+    default:
+        ret = -EINVAL;
+        break;
+    }
+
+    if (ret < 0) {
+        LOG_ERR("Failed to apply relay command 0x%08x for %s: %d", binding->param1,
+                data->processor_name, ret);
+        return ret;
+    }
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event) {
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api behavior_input_processor_relay_driver_api = {
+    .binding_pressed = on_keymap_binding_pressed,
+    .binding_released = on_keymap_binding_released,
+};
+
+#define RELAY_INST(n)                                                                              \
+    BUILD_ASSERT(DT_INST_NODE_HAS_PROP(n, processor) || DT_INST_NODE_HAS_PROP(n, processor_name),  \
+                 "processor or processor-name is required");                                       \
+    static struct behavior_input_processor_relay_data behavior_input_processor_relay_data_##n;     \
+    static const struct behavior_input_processor_relay_config                                      \
+        behavior_input_processor_relay_config_##n = {                                              \
+            .processor = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, processor),                          \
+                                     (DEVICE_DT_GET(DT_INST_PHANDLE(n, processor))), (NULL)),      \
+            .processor_name = DT_INST_PROP_OR(n, processor_name, NULL),                            \
+    };                                                                                             \
+    BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_relay_init, NULL,                          \
+                            &behavior_input_processor_relay_data_##n,                              \
+                            &behavior_input_processor_relay_config_##n, POST_KERNEL,               \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,                                   \
+                            &behavior_input_processor_relay_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(RELAY_INST)
@@ -15,7 +15,8 @@
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 struct behavior_input_processor_temp_config_config {
-    const char *processor_name;
+    const struct device *processor; // From the processor phandle, or NULL
+    const char *processor_name;     // Looked up when processor is not set
     uint32_t scale_multiplier;
     uint32_t scale_divisor;
     int32_t rotation_degrees;
@@ -23,6 +24,7 @@ struct behavior_input_processor_temp_config_config {
 
 struct behavior_input_processor_temp_config_data {
     const struct device *processor;
+    const char *processor_name;
     bool is_active;
 };
 
@@ -30,15 +32,23 @@ static int behavior_input_processor_temp_config_init(const struct device *dev) {
     struct behavior_input_processor_temp_config_data *data = dev->data;
     const struct behavior_input_processor_temp_config_config *cfg = dev->config;
 
-    // Find the processor by name
-    data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    // Prefer the processor phandle, resolved at build time, over a lookup by name
+    data->processor = cfg->processor;
+    if (!data->processor) {
+        data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    }
     if (!data->processor) {
         LOG_ERR("Input processor '%s' not found", cfg->processor_name);
         return -ENODEV;
     }
+    data->processor_name = zmk_input_processor_runtime_get_name(data->processor);
+    if (!data->processor_name) {
+        LOG_ERR("%s is not a runtime input processor", data->processor->name);
+        return -EINVAL;
+    }
 
     data->is_active = false;
-    LOG_DBG("Temporary config behavior initialized for processor: %s", cfg->processor_name);
+    LOG_DBG("Temporary config behavior initialized for processor: %s", data->processor_name);
     return 0;
 }
 
@@ -75,7 +85,7 @@ static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
     }
 
     data->is_active = true;
-    LOG_INF("Applied temporary config to %s: scale=%d/%d, rotation=%d", cfg->processor_name,
+    LOG_INF("Applied temporary config to %s: scale=%d/%d, rotation=%d", data->processor_name,
             cfg->scale_multiplier, cfg->scale_divisor, cfg->rotation_degrees);
 
     return ZMK_BEHAVIOR_OPAQUE;
@@ -85,7 +95,6 @@ static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
                                       struct zmk_behavior_binding_event event) {
     const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
     struct behavior_input_processor_temp_config_data *data = dev->data;
-    const struct behavior_input_processor_temp_config_config *cfg = dev->config;
 
     if (!data->processor || !data->is_active) {
         return 0;
@@ -95,7 +104,7 @@ static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
     zmk_input_processor_runtime_restore_persistent(data->processor);
 
     data->is_active = false;
-    LOG_INF("Restored persistent config for %s", cfg->processor_name);
+    LOG_INF("Restored persistent config for %s", data->processor_name);
 
     return ZMK_BEHAVIOR_OPAQUE;
 }
@@ -106,11 +115,15 @@ static const struct behavior_driver_api behavior_input_processor_temp_config_dri
 };
 
 #define TEMP_CONFIG_INST(n)                                                                        \
+    BUILD_ASSERT(DT_INST_NODE_HAS_PROP(n, processor) || DT_INST_NODE_HAS_PROP(n, processor_name), \
+                 "processor or processor-name is required");                                       \
     static struct behavior_input_processor_temp_config_data                                        \
         behavior_input_processor_temp_config_data_##n;                                             \
     static const struct behavior_input_processor_temp_config_config                                \
         behavior_input_processor_temp_config_config_##n = {                                        \
-            .processor_name = DT_INST_PROP(n, processor_name),                                     \
+            .processor = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, processor),                          \
+                                     (DEVICE_DT_GET(DT_INST_PHANDLE(n, processor))), (NULL)),      \
+            .processor_name = DT_INST_PROP_OR(n, processor_name, NULL),                            \
             .scale_multiplier = DT_INST_PROP_OR(n, scale_multiplier, 0),                           \
             .scale_divisor = DT_INST_PROP_OR(n, scale_divisor, 0),                                 \
             .rotation_degrees = DT_INST_PROP_OR(n, rotation_degrees, 0),                           \
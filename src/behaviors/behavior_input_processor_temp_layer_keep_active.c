@@ -15,11 +15,13 @@
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 struct behavior_input_processor_temp_layer_keep_active_config {
-    const char *processor_name;
+    const struct device *processor; // From the processor phandle, or NULL
+    const char *processor_name;     // Looked up when processor is not set
 };
 
 struct behavior_input_processor_temp_layer_keep_active_data {
     const struct device *processor;
+    const char *processor_name;
     bool is_active;
 };
 
@@ -27,15 +29,23 @@ static int behavior_input_processor_temp_layer_keep_active_init(const struct dev
     struct behavior_input_processor_temp_layer_keep_active_data *data = dev->data;
     const struct behavior_input_processor_temp_layer_keep_active_config *cfg = dev->config;
 
-    // Find the processor by name
-    data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    // Prefer the processor phandle, resolved at build time, over a lookup by name
+    data->processor = cfg->processor;
+    if (!data->processor) {
+        data->processor = zmk_input_processor_runtime_find_by_name(cfg->processor_name);
+    }
     if (!data->processor) {
         LOG_ERR("Input processor '%s' not found", cfg->processor_name);
         return -ENODEV;
     }
+    data->processor_name = zmk_input_processor_runtime_get_name(data->processor);
+    if (!data->processor_name) {
+        LOG_ERR("%s is not a runtime input processor", data->processor->name);
+        return -EINVAL;
+    }
 
     data->is_active = false;
-    LOG_DBG("Temp-layer keep-active behavior initialized for processor: %s", cfg->processor_name);
+    LOG_DBG("Temp-layer keep-active behavior initialized for processor: %s", data->processor_name);
     return 0;
 }
 
@@ -43,7 +53,6 @@ static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
                                      struct zmk_behavior_binding_event event) {
     const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
     struct behavior_input_processor_temp_layer_keep_active_data *data = dev->data;
-    const struct behavior_input_processor_temp_layer_keep_active_config *cfg = dev->config;
 
     if (!data->processor) {
         return -ENODEV;
@@ -53,7 +62,7 @@ static int on_keymap_binding_pressed(struct zmk_behavior_binding *binding,
     zmk_input_processor_runtime_temp_layer_keep_active(data->processor, true);
     data->is_active = true;
 
-    LOG_INF("Temp-layer keep-active enabled for %s", cfg->processor_name);
+    LOG_INF("Temp-layer keep-active enabled for %s", data->processor_name);
 
     return ZMK_BEHAVIOR_OPAQUE;
 }
@@ -62,7 +71,6 @@ static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
                                       struct zmk_behavior_binding_event event) {
     const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
     struct behavior_input_processor_temp_layer_keep_active_data *data = dev->data;
-    const struct behavior_input_processor_temp_layer_keep_active_config *cfg = dev->config;
 
     if (!data->processor || !data->is_active) {
         return 0;
@@ -72,7 +80,7 @@ static int on_keymap_binding_released(struct zmk_behavior_binding *binding,
     zmk_input_processor_runtime_temp_layer_keep_active(data->processor, false);
     data->is_active = false;
 
-    LOG_INF("Temp-layer keep-active disabled for %s", cfg->processor_name);
+    LOG_INF("Temp-layer keep-active disabled for %s", data->processor_name);
 
     return ZMK_BEHAVIOR_OPAQUE;
 }
@@ -84,11 +92,15 @@ static const struct behavior_driver_api behavior_input_processor_temp_layer_keep
 };
 
 #define AUTO_MOUSE_KEEP_ACTIVE_INST(n)                                                             \
+    BUILD_ASSERT(DT_INST_NODE_HAS_PROP(n, processor) || DT_INST_NODE_HAS_PROP(n, processor_name), \
+                 "processor or processor-name is required");                                       \
     static struct behavior_input_processor_temp_layer_keep_active_data                             \
         behavior_input_processor_temp_layer_keep_active_data_##n;                                  \
     static const struct behavior_input_processor_temp_layer_keep_active_config                     \
         behavior_input_processor_temp_layer_keep_active_config_##n = {                             \
-            .processor_name = DT_INST_PROP(n, processor_name),                                     \
+            .processor = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, processor),                          \
+                                     (DEVICE_DT_GET(DT_INST_PHANDLE(n, processor))), (NULL)),      \
+            .processor_name = DT_INST_PROP_OR(n, processor_name, NULL),                            \
     };                                                                                             \
     BEHAVIOR_DT_INST_DEFINE(n, behavior_input_processor_temp_layer_keep_active_init, NULL,         \
                             &behavior_input_processor_temp_layer_keep_active_data_##n,             \
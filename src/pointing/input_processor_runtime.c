@@ -7,38 +7,88 @@
 #define DT_DRV_COMPAT zmk_input_processor_runtime
 
 #include <drivers/input_processor.h>
-#include <math.h>
+#include <stdlib.h>
 #include <zephyr/device.h>
 #include <zephyr/dt-bindings/input/input-event-codes.h>
+#include <zephyr/input/input.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/dlist.h>
+#include <zephyr/toolchain.h>
 
 #if IS_ENABLED(CONFIG_SETTINGS)
 #include <zephyr/settings/settings.h>
 #endif
 
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SPLIT_RELAY) &&                                  \
+    IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#include <zmk/events/split_peripheral_status_changed.h>
+#include <zmk/pointing/input_processor_runtime_relay.h>
+#include <zmk/split/central.h>
+#endif
+
 #include <zmk/behavior.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/input_processor_state_changed.h>
 #include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
 #include <zmk/events/position_state_changed.h>
 #include <zmk/hid.h>
 #include <zmk/keymap.h>
 #include <zmk/keys.h>
+#include <zmk/matrix.h>
 
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
+// Event codes are classified with a 64-bit mask, which covers all REL and ABS codes
+#define RUNTIME_CODE_MASK_BITS 64
+
+// Split peripherals have no keymap: layer state and temp-layer live on the central
+#define RUNTIME_HAS_KEYMAP                                                                         \
+    (!IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL))
+
+// With the split relay, processors that name a relay behavior run on a
+// peripheral. The central relays their configuration and keeps only the
+// temp-layer stage; the peripheral runs the full plan and drops the motion
+// that the transforms reduced to nothing instead of sending it over the link.
+// The central side is left out when no instance names a relay behavior.
+#define RUNTIME_DT_USES_RELAY(n) || DT_INST_NODE_HAS_PROP(n, split_relay)
+#define RUNTIME_RELAY_CENTRAL                                                                      \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SPLIT_RELAY) &&                                 \
+     IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) &&                                                  \
+     (0 DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_RELAY)))
+#define RUNTIME_RELAY_PERIPHERAL                                                                   \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SPLIT_RELAY) && !RUNTIME_HAS_KEYMAP)
+// Split run-behavior commands carry behavior names of up to 8 characters
+#define RUNTIME_RELAY_BEHAVIOR_NAME_MAX_LEN 8
+
+// Mounting correction of one input device fused by a processor (source-*
+// properties), applied ahead of the runtime rotation, inversion and scale
+struct runtime_source_config {
+    int32_t rotation_degrees;
+    uint32_t scale_multiplier;
+    uint32_t scale_divisor;
+};
+
 struct runtime_processor_config {
     const char *name;
+    uint8_t id; // Index in the processor table
     uint8_t type;
-    size_t x_codes_len;
-    size_t y_codes_len;
-    const uint16_t *x_codes;
-    const uint16_t *y_codes;
+    // Event codes handled by this processor, one bit per code (built from DT)
+    uint64_t code_mask;   // x-codes | y-codes
+    uint64_t x_code_mask; // x-codes only
     uint32_t initial_scale_multiplier;
     uint32_t initial_scale_divisor;
     int32_t initial_rotation_degrees;
+    // Pair X/Y for rotation per input frame (terminated by the sync flag)
+    bool rotation_frame_sync;
+    // Input devices fused by this processor (source-devices), or NULL for a
+    // single source, and their mounting corrections (NULL for none)
+    const struct device *const *source_devices;
+    const struct runtime_source_config *source_configs;
+    uint8_t sources_len;
+    // Minimum time between coalesced outputs, 0 to pass every event on
+    uint16_t coalesce_interval_ms;
     // Temp-layer behavior references for efficient comparison
     const struct device *temp_layer_transparent_behavior;
     const struct device *temp_layer_kp_behavior;
@@ -49,6 +99,9 @@ struct runtime_processor_config {
     uint8_t initial_temp_layer_layer;
     uint16_t initial_temp_layer_activation_delay_ms;
     uint16_t initial_temp_layer_deactivation_delay_ms;
+    uint16_t initial_temp_layer_activation_threshold;
+    uint16_t initial_temp_layer_release_threshold;
+    uint16_t initial_temp_layer_motion_window_ms;
     // Active layers bitmask from DT
     uint32_t initial_active_layers;
     // Axis snap default settings from DT
@@ -61,537 +114,2669 @@ struct runtime_processor_config {
     // Axis reverse default settings from DT
     bool initial_x_invert;
     bool initial_y_invert;
+    // Acceleration default settings from DT
+    uint8_t initial_accel_curve;
+    uint16_t initial_accel_speed_max;
+    uint16_t initial_accel_gain_max;
+    uint16_t initial_accel_exponent;
+    size_t initial_accel_lut_len;
+    const uint16_t *initial_accel_lut;
+    // Jitter filter default settings from DT
+    uint16_t initial_filter_dead_zone;
+    uint16_t initial_filter_idle_ms;
+    uint8_t initial_filter_iir_shift;
+    // Scroll sub-pipeline default settings from DT
+    uint16_t initial_scroll_scale_multiplier;
+    uint16_t initial_scroll_scale_divisor;
+    uint8_t initial_scroll_hires_multiplier;
+    bool initial_scroll_snap;
+#if RUNTIME_RELAY_CENTRAL
+    // Relay behavior on the peripheral that runs this processor, or NULL
+    const struct device *relay_behavior;
+    uint8_t relay_source;
+#endif
 };
 
-struct runtime_processor_data {
-    const struct device *dev;
-#if IS_ENABLED(CONFIG_SETTINGS)
-    struct k_work_delayable save_work;
+// Optional stages are compiled in when Kconfig asks for them (for stages only
+// configured at runtime) or when an instance or behavior in the devicetree
+// uses them. Without them the stage code, its plan fields and its per-event
+// state are left out, and setters reject configurations that enable it.
+#define RUNTIME_DT_USES_ROTATION(n)                                                                \
+    || DT_INST_PROP_OR(n, rotation_degrees, 0) != 0 ||                                             \
+        DT_INST_NODE_HAS_PROP(n, source_rotation_degrees)
+#define RUNTIME_DT_TEMP_CONFIG_USES_ROTATION(node_id)                                              \
+    || DT_PROP_OR(node_id, rotation_degrees, 0) != 0
+#define RUNTIME_DT_USES_AXIS_SNAP(n) || DT_INST_PROP_OR(n, axis_snap_mode, 0) != 0
+#define RUNTIME_DT_USES_ACCEL(n) || DT_INST_PROP_OR(n, accel_curve, 0) != 0
+#define RUNTIME_DT_USES_TEMP_LAYER(n) || DT_INST_PROP(n, temp_layer_enabled)
+#define RUNTIME_DT_USES_FILTER(n)                                                                  \
+    || DT_INST_PROP_OR(n, filter_dead_zone, 0) != 0 || DT_INST_PROP_OR(n, filter_iir_shift, 0) != 0
+#define RUNTIME_DT_USES_COALESCE(n) || DT_INST_PROP(n, coalesce_interval_ms) > 0
+#define RUNTIME_DT_USES_SCROLL(n) || DT_INST_PROP_OR(n, scroll_scale_divisor, 0) != 0
+#define RUNTIME_DT_USES_SOURCES(n) || DT_INST_PROP_LEN_OR(n, source_devices, 0) > 1
+
+#define RUNTIME_HAS_ROTATION                                                                       \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_ROTATION)                                       \
+         DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_ROTATION)                                     \
+             DT_FOREACH_STATUS_OKAY(zmk_behavior_input_processor_temp_config,                      \
+                                    RUNTIME_DT_TEMP_CONFIG_USES_ROTATION))
+#define RUNTIME_HAS_AXIS_SNAP                                                                      \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_AXIS_SNAP) ||                                   \
+     DT_HAS_COMPAT_STATUS_OKAY(zmk_behavior_input_processor_axis_snap)                             \
+         DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_AXIS_SNAP))
+#define RUNTIME_HAS_ACCEL                                                                          \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_ACCEL)                                          \
+         DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_ACCEL))
+#define RUNTIME_HAS_TEMP_LAYER                                                                     \
+    (RUNTIME_HAS_KEYMAP &&                                                                         \
+     (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TEMP_LAYER) ||                                 \
+      DT_HAS_COMPAT_STATUS_OKAY(zmk_behavior_input_processor_temp_layer_keep_active)               \
+          DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_TEMP_LAYER)))
+#define RUNTIME_HAS_FILTER                                                                         \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_FILTER)                                         \
+         DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_FILTER))
+#define RUNTIME_HAS_SCROLL                                                                         \
+    (IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SCROLL)                                         \
+         DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_SCROLL))
+// Coalescing and multi-source fusion are only configured in the devicetree
+#define RUNTIME_HAS_COALESCE (0 DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_COALESCE))
+#define RUNTIME_HAS_SOURCES (0 DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_USES_SOURCES))
+
+#define RUNTIME_DT_SOURCES(n) MAX(DT_INST_PROP_LEN_OR(n, source_devices, 0), 1)
+#if RUNTIME_HAS_SOURCES
+// Sources of the instance that fuses the most input devices
+#define RUNTIME_DT_SOURCES_MEMBER(n) uint8_t inst_##n[RUNTIME_DT_SOURCES(n)];
+union runtime_sources_max {
+    DT_INST_FOREACH_STATUS_OKAY(RUNTIME_DT_SOURCES_MEMBER)
+};
+#define RUNTIME_SOURCES_MAX sizeof(union runtime_sources_max)
+#else
+#define RUNTIME_SOURCES_MAX 1
+#endif
+
+// Transform stages enabled in a processor plan
+#define RUNTIME_STAGE_REMAP BIT(0)      // Rewrite the event code (XY swap / XY-to-scroll)
+#define RUNTIME_STAGE_TEMP_LAYER BIT(1) // Temp-layer activation tracking
+#define RUNTIME_STAGE_ROTATE BIT(2)     // Full 2x2 matrix, needs paired X/Y values
+#define RUNTIME_STAGE_LINEAR BIT(3)     // Diagonal matrix, applied per axis
+#define RUNTIME_STAGE_AXIS_SNAP BIT(4)  // Cross-axis suppression
+#define RUNTIME_STAGE_SCALE BIT(5)      // Scaling after axis snap (only when snap is enabled)
+#define RUNTIME_STAGE_ACCEL BIT(6)      // Speed dependent gain
+#define RUNTIME_STAGE_FILTER BIT(7)     // Dead zone and smoothing, ahead of everything else
+#define RUNTIME_STAGE_SCROLL BIT(8)     // Scroll scaling to whole wheel units, replaces scaling
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+// Stage counters are indexed by plan stage bit
+BUILD_ASSERT(RUNTIME_STAGE_REMAP == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_REMAP) &&
+                 RUNTIME_STAGE_TEMP_LAYER == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_TEMP_LAYER) &&
+                 RUNTIME_STAGE_ROTATE == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_ROTATE) &&
+                 RUNTIME_STAGE_LINEAR == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_LINEAR) &&
+                 RUNTIME_STAGE_AXIS_SNAP == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_AXIS_SNAP) &&
+                 RUNTIME_STAGE_SCALE == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_SCALE) &&
+                 RUNTIME_STAGE_ACCEL == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_ACCEL) &&
+                 RUNTIME_STAGE_FILTER == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_FILTER) &&
+                 RUNTIME_STAGE_SCROLL == BIT(ZMK_INPUT_PROCESSOR_STATS_STAGE_SCROLL),
+             "Plan stage bits must match zmk_input_processor_stats_stage");
+#define RUNTIME_STATS_INC(data, counter) ((data)->stats.counter++)
+#else
+#define RUNTIME_STATS_INC(data, counter) ((void)0)
 #endif
-    // Current active values (may be temporary from behavior)
-    uint32_t scale_multiplier;
-    uint32_t scale_divisor;
-    int32_t rotation_degrees;
 
-    // Persistent values (saved to settings, not affected by behavior)
-    uint32_t persistent_scale_multiplier;
-    uint32_t persistent_scale_divisor;
-    int32_t persistent_rotation_degrees;
+// Q16.16 fixed point
+#define RUNTIME_Q16_SHIFT 16
+#define RUNTIME_Q16_ONE (1 << RUNTIME_Q16_SHIFT)
+
+// Decaying accumulators (axis snap, temp-layer motion) are Q24.8 fixed point,
+// so that exponential decay does not truncate small accumulations to zero
+#define RUNTIME_ACCUM_SHIFT 8
+// Decays span at most 2^RUNTIME_DECAY_BITS - 1 steps; after
+// RUNTIME_DECAY_HALF_LIVES half-lives the accumulator is treated as empty
+#define RUNTIME_DECAY_BITS 10
+#define RUNTIME_DECAY_HALF_LIVES 24
+// Half-lives are quantised to at least this many decay steps
+#define RUNTIME_DECAY_MIN_STEPS 16
+
+#define RUNTIME_HAS_DECAY (RUNTIME_HAS_AXIS_SNAP || RUNTIME_HAS_TEMP_LAYER)
+
+#if RUNTIME_HAS_DECAY
+// Exponential decay of an accumulator with a fixed half-life. Time is counted
+// in steps of 2^shift ms and factor_q16 is the decay factor for one step.
+struct runtime_decay {
+    uint32_t factor_q16;
+    uint16_t max_steps; // 0 disables decay
+    uint16_t shift;
+};
+#endif
 
-    // Precomputed rotation values
-    int32_t cos_val; // cos * 1000
-    int32_t sin_val; // sin * 1000
+// All timing uses 32-bit millisecond ticks (k_uptime_get_32()), which wrap
+// after ~49 days. Intervals are computed with unsigned subtraction, which is
+// correct across the wrap as long as the interval itself fits in 32 bits.
+typedef uint32_t runtime_tick_t;
 
-    // Last seen X/Y values for rotation
-    int16_t last_x;
-    int16_t last_y;
-    bool has_x;
-    bool has_y;
+#if RUNTIME_HAS_TEMP_LAYER
+// Last key press time, shared by all processors
+static runtime_tick_t runtime_last_keypress;
+static bool runtime_keypress_seen;
+#endif
 
-    // Temp-layer layer settings
-    bool temp_layer_enabled;
-    uint8_t temp_layer_layer;
+// Settings flushes wait until pointer motion has been idle for a while
+#if IS_ENABLED(CONFIG_SETTINGS) && CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_SAVE_IDLE_MS > 0
+#define RUNTIME_SETTINGS_WAIT_FOR_IDLE 1
+// Last input event time, shared by all processors
+static runtime_tick_t runtime_last_motion;
+static bool runtime_motion_seen;
+#else
+#define RUNTIME_SETTINGS_WAIT_FOR_IDLE 0
+#endif
+
+// Per-processor transform plan, rebuilt whenever the active config changes so
+// that the event path only runs the stages that actually do something.
+// Axis index 0 is X and 1 is Y (classified on the incoming code).
+// The matrix of each source combines its mounting correction with rotation,
+// inversion and, unless axis snap has to see unscaled values, the scale factor.
+// A published plan is immutable and is the only config the event path reads,
+// apart from the acceleration gains, which are kept once per processor.
+// Fields are ordered by alignment so the plan carries no padding.
+struct runtime_processor_plan {
+    uint32_t generation; // Incremented on every publish
+    // Q16.16 per source, used by RUNTIME_STAGE_ROTATE / RUNTIME_STAGE_LINEAR
+    int32_t matrix[RUNTIME_SOURCES_MAX][2][2];
+    int32_t scale_q16; // Q16.16, used by RUNTIME_STAGE_SCALE
+#if RUNTIME_HAS_SCROLL
+    int32_t scroll_scale_q16; // Q16.16 wheel units per count, used by RUNTIME_STAGE_SCROLL
+#endif
+#if RUNTIME_HAS_AXIS_SNAP
+    // Used by RUNTIME_STAGE_AXIS_SNAP: the cross-axis accumulator halves every
+    // axis_snap_timeout_ms
+    int32_t axis_snap_threshold_q8;
+    struct runtime_decay axis_snap_decay;
+#endif
+#if RUNTIME_HAS_TEMP_LAYER
+    // Temp-layer motion gate (Q24.8, both 0 when the gate is off): the motion
+    // accumulator halves every temp_layer_motion_window_ms
+    int32_t temp_layer_activation_q8;
+    int32_t temp_layer_release_q8;
+    struct runtime_decay temp_layer_decay;
+#endif
+    uint16_t out_code[2]; // Used by RUNTIME_STAGE_REMAP
+#if RUNTIME_HAS_ACCEL
+    uint16_t accel_speed_max; // Used by RUNTIME_STAGE_ACCEL
+#endif
+#if RUNTIME_HAS_TEMP_LAYER
+    // Config values read by the event path
     uint16_t temp_layer_activation_delay_ms;
     uint16_t temp_layer_deactivation_delay_ms;
+#endif
+#if RUNTIME_HAS_FILTER
+    // Used by RUNTIME_STAGE_FILTER
+    uint16_t filter_dead_zone;
+    uint16_t filter_idle_ms;
+#endif
+    uint16_t stages;
+#if RUNTIME_HAS_ACCEL
+    uint8_t accel_points;
+#endif
+#if RUNTIME_HAS_AXIS_SNAP
+    uint8_t axis_snap_mode;
+#endif
+#if RUNTIME_HAS_FILTER
+    uint8_t filter_iir_shift; // Used by RUNTIME_STAGE_FILTER
+#endif
+#if RUNTIME_HAS_SCROLL
+    bool scroll_snap; // Used by RUNTIME_STAGE_SCROLL
+#endif
+};
 
-    // Persistent temp-layer settings
-    bool persistent_temp_layer_enabled;
-    uint8_t persistent_temp_layer_layer;
-    uint16_t persistent_temp_layer_activation_delay_ms;
-    uint16_t persistent_temp_layer_deactivation_delay_ms;
+// Plan buffers: two scratch buffers the setters publish through, followed by
+// one precompiled plan per profile so that selecting a profile only swaps the
+// active index (and loads the profile's acceleration gains)
+#define RUNTIME_PROFILE_COUNT CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILES
+#define RUNTIME_PLAN_SCRATCH_SLOTS 2
+#define RUNTIME_PLAN_SLOTS (RUNTIME_PLAN_SCRATCH_SLOTS + RUNTIME_PROFILE_COUNT)
+#define RUNTIME_PROFILE_PLAN_SLOT(index) (RUNTIME_PLAN_SCRATCH_SLOTS + (index))
+
+#if RUNTIME_PROFILE_COUNT > 0
+struct runtime_processor_profile {
+    bool valid;
+    char name[CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILE_NAME_MAX_LEN + 1];
+    struct zmk_input_processor_runtime_config config;
+};
+#endif
 
-    // Active layers bitmask (0 = all layers)
-    uint32_t active_layers;
-    uint32_t persistent_active_layers;
+// Event path state of one source. The stages up to and including the matrix
+// only ever see the motion of one input device; the stages after it see the
+// fused motion and keep their state in runtime_processor_state.
+struct runtime_source_state {
+#if RUNTIME_HAS_ROTATION
+    // Frame-synchronous rotation: cross-axis output owed to each axis' next event
+    int64_t frame_carry_q16[2];
+#endif
+    // Sub-pixel remainders of the matrix stage per axis (Q16.16), used when the
+    // caller tracks remainders
+    int32_t remainder_q16[2];
+#if RUNTIME_HAS_FILTER
+    // Jitter filter
+    int32_t filter_travel[2];            // Input per axis in the current idle window
+    int32_t filter_q16[2];               // Smoothed input per axis (Q16.16)
+    int32_t filter_remainder_q16[2];     // Rounding of the smoothed input
+    runtime_tick_t filter_window_start;  // Start of the current idle window
+    runtime_tick_t filter_last_smoothed; // Last input seen by the smoothing filter
+#endif
+#if RUNTIME_HAS_COALESCE
+    int32_t coalesce_value[2];          // Input held back per axis
+    runtime_tick_t coalesce_last_flush; // Start of the current coalescing interval
+    const struct device *coalesce_dev;  // Device the held back input came from
+    uint16_t coalesce_code[2];          // Input code of the held back input per axis
+#endif
+#if RUNTIME_HAS_ROTATION
+    // Per-axis input accumulated since the last sync (rotation-frame-sync)
+    int32_t frame_value[2];
+    // Last seen X/Y values for rotation
+    int32_t last_x;
+    int32_t last_y;
+#endif
 
-    // Axis snap settings
-    uint8_t axis_snap_mode;
-    uint16_t axis_snap_threshold;
-    uint16_t axis_snap_timeout_ms;
+#if RUNTIME_HAS_ROTATION
+    bool has_x : 1;
+    bool has_y : 1;
+#endif
+#if RUNTIME_HAS_COALESCE
+    bool coalesce_flushing : 1; // The current frame carries the held back input
+#endif
+#if RUNTIME_HAS_FILTER
+    bool filter_window_armed : 1; // Whether the idle window start is set
+    bool filter_awake : 1;        // Input travelled beyond the dead zone in this window
+    bool filter_frame_open : 1;   // An event of the current frame has been passed on
+    bool filter_smoothing : 1;    // Whether the smoothing filter holds a value
+#endif
+};
 
-    // Persistent axis snap settings
-    uint8_t persistent_axis_snap_mode;
-    uint16_t persistent_axis_snap_threshold;
-    uint16_t persistent_axis_snap_timeout_ms;
+// Event path state, read and written by runtime_processor_process_event() on
+// every event. Kept in one block, ordered by alignment so it has no internal
+// padding, ahead of the configuration the event path never touches.
+struct runtime_processor_state {
+    // Per-source state (one entry unless an instance fuses several devices)
+    struct runtime_source_state sources[RUNTIME_SOURCES_MAX];
+    // Index of the published plan and pins held on each plan buffer
+    atomic_t active_plan;
+    atomic_t plan_readers[RUNTIME_PLAN_SLOTS];
+    // Plan generation the rest of this state belongs to
+    uint32_t generation;
+
+    // Sub-pixel remainders of the scale/acceleration stage after axis snap per
+    // axis (Q16.16), used when the caller tracks remainders
+    int32_t gain_remainder_q16[2];
+#if RUNTIME_HAS_SCROLL
+    int32_t scroll_q16[2]; // Scroll per axis not yet passed on (Q16.16 wheel units)
+#endif
 
-    // Axis snap runtime state
-    int16_t axis_snap_cross_axis_accum;     // Accumulated movement on cross axis
-    int64_t axis_snap_last_decay_timestamp; // Last time accumulator was decayed
+#if RUNTIME_HAS_AXIS_SNAP
+    // Axis snap
+    int32_t axis_snap_accum_q8;               // Accumulated movement on cross axis (Q24.8)
+    uint32_t axis_snap_auto_lead[2];          // Absolute counts per axis until an axis is locked
+    runtime_tick_t axis_snap_decay_timestamp; // Time the accumulator has been decayed up to
+    runtime_tick_t axis_snap_last_motion;     // Last motion seen by the snap stage
+#endif
 
-    // Code mapping settings
-    bool xy_to_scroll_enabled;
-    bool xy_swap_enabled;
+#if RUNTIME_HAS_ACCEL
+    // Acceleration speed tracking
+    uint32_t accel_speed;              // Latest input speed estimate (counts/s)
+    uint32_t accel_window_counts;      // Input counts seen in the current speed window
+    runtime_tick_t accel_window_start; // Start of the current speed window
+    runtime_tick_t accel_last_input;   // Time of the last input seen by the speed tracker
+#endif
 
-    // Persistent code mapping settings
-    bool persistent_xy_to_scroll_enabled;
-    bool persistent_xy_swap_enabled;
+#if RUNTIME_HAS_TEMP_LAYER
+    runtime_tick_t temp_layer_last_motion; // Last input while the temp-layer layer was active
+    // Temp-layer motion gate
+    int32_t temp_layer_motion_q8;               // Accumulated |x| + |y| input (Q24.8)
+    runtime_tick_t temp_layer_motion_timestamp; // Time the accumulator has been decayed up to
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_OVERFLOW_COUNTER)
+    // Number of output values saturated to the int16 range
+    uint32_t overflow_count;
+#endif
 
-    // Axis reverse settings
-    bool x_invert;
-    bool y_invert;
+#if RUNTIME_HAS_AXIS_SNAP
+    int8_t axis_snap_auto_axis; // Axis locked for the current gesture (AUTO mode), or -1
+#endif
+    // Only written by the event path, so these can share a byte
+#if RUNTIME_HAS_AXIS_SNAP
+    bool axis_snap_decay_armed : 1; // Whether the decay timestamp is set
+#endif
+#if RUNTIME_HAS_TEMP_LAYER
+    bool temp_layer_motion_armed : 1; // Whether the motion decay timestamp is set
+#endif
+#if RUNTIME_HAS_ACCEL
+    bool accel_window_open : 1; // Whether a speed window has been started
+#endif
+#if RUNTIME_HAS_SCROLL
+    bool scroll_frame_open : 1; // A scroll event of the current frame has been passed on
+#endif
+    // Written by listeners and work items as well, so each gets its own byte
+    bool active_for_layers; // active_layers matches the keymap layer state
+#if RUNTIME_HAS_TEMP_LAYER
+    bool temp_layer_layer_active; // The temp-layer layer has been activated
+    bool temp_layer_keep_active;  // Set by behavior to prevent deactivation
+#endif
+};
+
+#if RUNTIME_HAS_TEMP_LAYER
+// Bits in runtime_processor_data.temp_layer_flags
+#define RUNTIME_TEMP_LAYER_ACTIVATION_PENDING 0 // Waiting for the shared activation work
+#define RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED 1 // Waiting for the shared deactivation work
+#define RUNTIME_TEMP_LAYER_DEACTIVATE_NOW 2     // Skip the remaining delay on the next run
+#endif
 
-    // Persistent axis reverse settings
-    bool persistent_x_invert;
-    bool persistent_y_invert;
-
-    // Temp-layer runtime state
-    struct k_work_delayable temp_layer_activation_work;
-    struct k_work_delayable temp_layer_deactivation_work;
-    bool temp_layer_layer_active;
-    bool temp_layer_keep_active; // Set by behavior to prevent deactivation
-    int64_t last_input_timestamp;
-    int64_t last_keypress_timestamp;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+// Closed windows the Studio work has not taken yet (a power of two, at least
+// two notifications' worth)
+#define RUNTIME_TELEMETRY_RING_LEN 16
+BUILD_ASSERT((RUNTIME_TELEMETRY_RING_LEN & (RUNTIME_TELEMETRY_RING_LEN - 1)) == 0 &&
+                 RUNTIME_TELEMETRY_RING_LEN >=
+                     2 * CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_BATCH,
+             "Telemetry ring length must be a power of two holding two batches");
+
+// Single-producer, single-consumer telemetry ring. head and tail count
+// windows since boot: the event path writes the slot at head and then
+// advances it, the reader copies the slot at tail and then advances that, so
+// neither ever waits for the other.
+struct runtime_processor_telemetry {
+    atomic_t enabled;
+    atomic_t enabled_since; // Windows that started earlier are left over and skipped
+    atomic_t head;
+    atomic_t tail;
+    // Window being aggregated, only touched by the event path
+    struct zmk_input_processor_telemetry_sample window;
+#if RUNTIME_HAS_AXIS_SNAP
+    // Axis snap state after the last event of the window, resolved when it is closed
+    int32_t snap_accum_q8;
+    int8_t snap_auto_axis;
+#endif
+    uint16_t lost;    // Windows dropped since the last one published
+    bool window_open; // Whether window holds input
+    struct zmk_input_processor_telemetry_sample ring[RUNTIME_TELEMETRY_RING_LEN];
 };
+#endif
 
-static void update_rotation_values(struct runtime_processor_data *data) {
-    if (data->rotation_degrees == 0) {
-        data->cos_val = 1000;
-        data->sin_val = 0;
-        return;
-    }
+struct runtime_processor_data {
+    struct runtime_processor_state state;
+
+    // Double-buffered transform plan for the current values. Setters build the
+    // inactive scratch buffer and publish it by swapping state.active_plan; the
+    // event path pins the buffer it reads in state.plan_readers so it is not
+    // rebuilt under it. Profile selection points state.active_plan at the
+    // profile's plan instead.
+    struct runtime_processor_plan plans[RUNTIME_PLAN_SLOTS];
+#if RUNTIME_HAS_ACCEL
+    // Gains (Q16.16) at evenly spaced speeds of the active plan, shared by all
+    // plans and only rewritten while no plan with RUNTIME_STAGE_ACCEL is read
+    // (see update_accel_gains)
+    int32_t accel_gain_q16[ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS];
+#endif
+
+#if RUNTIME_HAS_TEMP_LAYER
+    // Temp-layer work handshake (RUNTIME_TEMP_LAYER_*). The event path only
+    // records motion time; the shared deactivation work re-arms itself for the
+    // earliest remaining delay, so the kernel timeout queue sees one operation
+    // per deactivation window instead of one per event.
+    atomic_t temp_layer_flags;
+    // Per-position verdict for the current layer state: bit set if a press at
+    // that position keeps the temp-layer layer active
+    uint32_t temp_layer_keep_map[DIV_ROUND_UP(ZMK_KEYMAP_LEN, 32)];
+#endif
 
-    // Convert degrees to radians and compute sin/cos
-    double angle_rad = (double)data->rotation_degrees * 3.14159265359 / 180.0;
-    data->cos_val = (int32_t)(cos(angle_rad) * 1000.0);
-    data->sin_val = (int32_t)(sin(angle_rad) * 1000.0);
+    // Current values (may be temporary from behavior), which the plan is built from
+    struct zmk_input_processor_runtime_config current;
+    // Persistent values (saved to settings, not affected by behavior). Handed
+    // out read-only through the processor table so readers need not copy them.
+    struct zmk_input_processor_runtime_config persistent;
 
-    LOG_DBG("Rotation %d degrees: cos=%d, sin=%d", data->rotation_degrees, data->cos_val,
-            data->sin_val);
-}
+#if RUNTIME_PROFILE_COUNT > 0
+    struct runtime_processor_profile profiles[RUNTIME_PROFILE_COUNT];
+    int8_t active_profile; // Profile the current values came from, or -1
+#endif
+#if IS_ENABLED(CONFIG_SETTINGS)
+    uint32_t saved_settings_hash; // Hash of the last record written or loaded
+    bool saved_settings_valid;    // Whether saved_settings_hash is set
+#if RUNTIME_PROFILE_COUNT > 0
+    atomic_t profiles_dirty; // Profiles (by index) not yet written
+#endif
+#endif
+#if RUNTIME_HAS_COALESCE
+    // Axes (bit 2 * source + axis) holding back input for the shared flush work
+    ATOMIC_DEFINE(coalesce_pending, 2 * RUNTIME_SOURCES_MAX);
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+    struct zmk_input_processor_runtime_stats stats;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    struct runtime_processor_telemetry telemetry;
+#endif
+#if RUNTIME_RELAY_CENTRAL
+    // Configuration the peripheral has, valid while relay_synced
+    struct zmk_input_processor_runtime_config relay_sent;
+    bool relay_synced;
+#endif
+};
 
-// Temp-layer layer work handlers
-static void temp_layer_activation_work_handler(struct k_work *work) {
-    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-    struct runtime_processor_data *data =
-        CONTAINER_OF(dwork, struct runtime_processor_data, temp_layer_activation_work);
+#if RUNTIME_HAS_ROTATION
+// sin(0..90 degrees) in Q16.16
+static const int32_t sin_q16_table[91] = {
+    0,     1144,  2287,  3430,  4572,  5712,  6850,  7987,  9121,  10252, 11380, 12505, 13626,
+    14742, 15855, 16962, 18064, 19161, 20252, 21336, 22415, 23486, 24550, 25607, 26656, 27697,
+    28729, 29753, 30767, 31772, 32768, 33754, 34729, 35693, 36647, 37590, 38521, 39441, 40348,
+    41243, 42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930, 48703, 49461, 50203, 50931,
+    51643, 52339, 53020, 53684, 54332, 54963, 55578, 56175, 56756, 57319, 57865, 58393, 58903,
+    59396, 59870, 60326, 60764, 61183, 61584, 61966, 62328, 62672, 62997, 63303, 63589, 63856,
+    64104, 64332, 64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446, 65496, 65526, 65536,
+};
 
-    if (!data->temp_layer_enabled || data->temp_layer_layer_active) {
-        return;
+static int32_t sin_q16(int32_t degrees) {
+    int32_t d = degrees % 360;
+    if (d < 0) {
+        d += 360;
     }
 
-    // Activate the temp-layer layer
-    int ret = zmk_keymap_layer_activate(data->temp_layer_layer);
-    if (ret == 0) {
-        data->temp_layer_layer_active = true;
-        LOG_INF("Temp-layer layer %d activated", data->temp_layer_layer);
-    } else {
-        LOG_ERR("Failed to activate temp-layer layer %d: %d", data->temp_layer_layer, ret);
+    if (d <= 90) {
+        return sin_q16_table[d];
+    } else if (d <= 180) {
+        return sin_q16_table[180 - d];
+    } else if (d <= 270) {
+        return -sin_q16_table[d - 180];
     }
+    return -sin_q16_table[360 - d];
 }
+#endif
 
-static void temp_layer_deactivation_work_handler(struct k_work *work) {
-    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-    struct runtime_processor_data *data =
-        CONTAINER_OF(dwork, struct runtime_processor_data, temp_layer_deactivation_work);
+// Compute q16 * mul / div, saturated to the int32 range
+static int32_t q16_mul_ratio(int32_t q16, uint32_t mul, uint32_t div) {
+    int64_t v = (int64_t)q16 * mul / div;
+    return (int32_t)CLAMP(v, INT32_MIN, INT32_MAX);
+}
 
-    if (!data->temp_layer_layer_active || data->temp_layer_keep_active) {
-        return;
+// Convert a Q16.16 accumulator to an integer, rounding to nearest. When a
+// remainder is given, the rounding error is carried into the next call.
+static int32_t q16_to_int(int64_t acc, int32_t *remainder) {
+    if (remainder) {
+        acc += *remainder;
     }
 
-    // Deactivate the temp-layer layer
-    int ret = zmk_keymap_layer_deactivate(data->temp_layer_layer);
-    if (ret == 0) {
-        data->temp_layer_layer_active = false;
-        LOG_INF("Temp-layer layer %d deactivated", data->temp_layer_layer);
-    } else {
-        LOG_ERR("Failed to deactivate temp-layer layer %d: %d", data->temp_layer_layer, ret);
+    int64_t out = (acc + (RUNTIME_Q16_ONE / 2)) >> RUNTIME_Q16_SHIFT;
+
+    if (remainder) {
+        *remainder = (int32_t)(acc - out * RUNTIME_Q16_ONE);
     }
+    return (int32_t)CLAMP(out, INT32_MIN, INT32_MAX);
 }
 
-static int code_idx(uint16_t code, const uint16_t *list, size_t len) {
-    for (int i = 0; i < len; i++) {
-        if (list[i] == code) {
-            return i;
-        }
+// Saturate a transformed value to the int16 range used by HID reports
+static int16_t saturate_to_int16(struct runtime_processor_data *data, int32_t v) {
+    if (v > INT16_MAX || v < INT16_MIN) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_OVERFLOW_COUNTER)
+        data->state.overflow_count++;
+#endif
+        RUNTIME_STATS_INC(data, overflows);
+        LOG_DBG("Saturated %d to int16 range", v);
+        return v > 0 ? INT16_MAX : INT16_MIN;
     }
-    return -ENODEV;
+    return (int16_t)v;
 }
 
-static bool is_processor_active_for_current_layers(uint32_t active_layers_mask) {
-    // If mask is 0, processor is active for all layers
-    if (active_layers_mask == 0) {
-        return true;
+#if RUNTIME_HAS_ACCEL || RUNTIME_HAS_DECAY
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
     }
+    return (uint32_t)res;
+}
 
-    // Check only the layers that are set in the bitmask
-    // This is more efficient than checking all layers
-    uint32_t remaining_mask = active_layers_mask;
-    int layer_idx = 0;
+// x^(exponent / 100) for x in [0, 1] (Q16.16). The fractional part of the
+// exponent is resolved to 1/256 with repeated square roots.
+static uint32_t q16_pow_unit(uint32_t x, uint16_t exponent) {
+    uint32_t result = RUNTIME_Q16_ONE;
 
-    while (remaining_mask != 0 && layer_idx < ZMK_KEYMAP_LAYERS_LEN) {
-        // Check if this bit is set
-        if (remaining_mask & 1) {
-            zmk_keymap_layer_id_t layer_id = zmk_keymap_layer_index_to_id(layer_idx);
+    for (uint16_t i = 0; i < exponent / 100; i++) {
+        result = ((uint64_t)result * x) >> RUNTIME_Q16_SHIFT;
+    }
 
-            if (layer_id != ZMK_KEYMAP_LAYER_ID_INVAL && zmk_keymap_layer_active(layer_id)) {
-                return true;
-            }
+    uint32_t frac = (exponent % 100) * 256 / 100;
+    uint32_t root = x;
+    for (uint32_t bit = 0x80; bit != 0 && frac != 0; bit >>= 1) {
+        root = isqrt64((uint64_t)root << RUNTIME_Q16_SHIFT);
+        if (frac & bit) {
+            result = ((uint64_t)result * root) >> RUNTIME_Q16_SHIFT;
         }
-
-        remaining_mask >>= 1;
-        layer_idx++;
     }
+    return result;
+}
+#endif
 
-    return false;
+#if RUNTIME_HAS_ACCEL
+// Speed is measured over windows of at least this length
+#define RUNTIME_ACCEL_WINDOW_MS 4
+// A gap longer than this restarts the speed estimate from rest
+#define RUNTIME_ACCEL_IDLE_MS 100
+
+// Number of gain points of the acceleration curve, 0 for no acceleration
+static uint8_t accel_curve_points(const struct zmk_input_processor_runtime_config *config) {
+    if (config->accel_curve == ZMK_INPUT_PROCESSOR_ACCEL_CURVE_NONE ||
+        config->accel_speed_max == 0) {
+        return 0;
+    }
+    if (config->accel_curve == ZMK_INPUT_PROCESSOR_ACCEL_CURVE_LUT) {
+        return config->accel_lut_len >= 2 ? config->accel_lut_len : 0;
+    }
+    return ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS;
 }
 
-static int scale_val(struct input_event *event, uint32_t mul, uint32_t div,
-                     struct zmk_input_processor_state *state) {
-    if (mul == 0 || div == 0) {
-        return ZMK_INPUT_PROC_CONTINUE;
+static void build_accel_plan(const struct zmk_input_processor_runtime_config *config,
+                             struct runtime_processor_plan *plan) {
+    plan->accel_points = accel_curve_points(config);
+    if (plan->accel_points == 0) {
+        return;
     }
 
-    int16_t value_mul = event->value * (int16_t)mul;
+    plan->accel_speed_max = config->accel_speed_max;
+    plan->stages |= RUNTIME_STAGE_ACCEL;
+}
+
+// Compute the gains (Q16.16) of the acceleration curve; unused points are 0
+static void build_accel_gains(const struct zmk_input_processor_runtime_config *config,
+                              int32_t gains[ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS]) {
+    uint8_t points = accel_curve_points(config);
+
+    memset(gains, 0, sizeof(int32_t) * ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS);
+    if (points == 0) {
+        return;
+    }
 
-    if (state && state->remainder) {
-        value_mul += *state->remainder;
+    if (config->accel_curve == ZMK_INPUT_PROCESSOR_ACCEL_CURVE_LUT) {
+        for (uint8_t i = 0; i < points; i++) {
+            gains[i] = q16_mul_ratio(RUNTIME_Q16_ONE, config->accel_lut[i], 100);
+        }
+    } else {
+        // Sample the curve: gain = 1 + (gain_max - 1) * f(speed / speed_max)
+        int32_t span = (int32_t)config->accel_gain_max - 100;
+        uint8_t segments = points - 1;
+
+        for (uint8_t i = 0; i <= segments; i++) {
+            uint32_t x = RUNTIME_Q16_ONE * i / segments;
+            uint32_t f = config->accel_curve == ZMK_INPUT_PROCESSOR_ACCEL_CURVE_POWER
+                             ? q16_pow_unit(x, config->accel_exponent)
+                             : x;
+            gains[i] = RUNTIME_Q16_ONE + (int32_t)((int64_t)span * f / 100);
+        }
     }
+}
 
-    int16_t scaled = value_mul / (int16_t)div;
+// Track input speed (L1 magnitude of the raw input). Speed is updated at frame
+// boundaries (events with the sync flag) once a window of at least
+// RUNTIME_ACCEL_WINDOW_MS has passed. The first frame after a pause only marks
+// the window start, as its duration is unknown.
+static void update_accel_speed(struct runtime_processor_data *data, int32_t value, bool sync,
+                               runtime_tick_t now) {
+    if ((runtime_tick_t)(now - data->state.accel_last_input) > RUNTIME_ACCEL_IDLE_MS) {
+        data->state.accel_speed = 0;
+        data->state.accel_window_counts = 0;
+        data->state.accel_window_start = now;
+        data->state.accel_window_open = false;
+    }
+    data->state.accel_last_input = now;
 
-    if (state && state->remainder) {
-        *state->remainder = value_mul - (scaled * (int16_t)div);
+    if (data->state.accel_window_open) {
+        data->state.accel_window_counts += value < 0 ? -value : value;
     }
 
-    LOG_DBG("scaled %d with %d/%d to %d", event->value, mul, div, scaled);
+    if (!sync) {
+        return;
+    }
 
-    event->value = scaled;
-    return 0;
+    runtime_tick_t elapsed = now - data->state.accel_window_start;
+    if (!data->state.accel_window_open) {
+        data->state.accel_window_open = true;
+        data->state.accel_window_start = now;
+    } else if (elapsed >= RUNTIME_ACCEL_WINDOW_MS) {
+        data->state.accel_speed =
+            (uint32_t)((uint64_t)data->state.accel_window_counts * 1000 / elapsed);
+        data->state.accel_window_counts = 0;
+        data->state.accel_window_start = now;
+    }
 }
 
-static int runtime_processor_handle_event(const struct device *dev, struct input_event *event,
-                                          uint32_t param1, uint32_t param2,
-                                          struct zmk_input_processor_state *state) {
-    const struct runtime_processor_config *cfg = dev->config;
-    struct runtime_processor_data *data = dev->data;
+// Interpolate the acceleration gain (Q16.16) for the given speed
+static int32_t accel_gain_q16(const struct runtime_processor_data *data,
+                              const struct runtime_processor_plan *plan, uint32_t speed) {
+    uint32_t segments = plan->accel_points - 1;
+    uint64_t pos = ((uint64_t)speed * segments << 8) / plan->accel_speed_max; // Q24.8
+    uint32_t idx = pos >> 8;
 
-    if (event->type != cfg->type) {
-        return ZMK_INPUT_PROC_CONTINUE;
+    if (idx >= segments) {
+        return data->accel_gain_q16[segments];
     }
 
-    int x_idx = code_idx(event->code, cfg->x_codes, cfg->x_codes_len);
-    int y_idx = code_idx(event->code, cfg->y_codes, cfg->y_codes_len);
+    int32_t g0 = data->accel_gain_q16[idx];
+    int32_t g1 = data->accel_gain_q16[idx + 1];
+    return g0 + (int32_t)(((int64_t)(g1 - g0) * (int32_t)(pos & 0xff)) >> 8);
+}
+#endif
+
+#if RUNTIME_HAS_DECAY
+// Precompute a decay that halves the accumulator every half_life_ms (0 = no
+// decay). The half-life is split into 16..31 steps of a power-of-two length,
+// so the event path finds the elapsed step count with a shift and applies the
+// decay by squaring the factor, with one multiply per set bit of the count.
+static void build_decay(uint16_t half_life_ms, struct runtime_decay *decay) {
+    decay->shift = 0;
+    decay->max_steps = 0;
 
-    if (x_idx < 0 && y_idx < 0) {
-        return ZMK_INPUT_PROC_CONTINUE;
+    if (half_life_ms == 0) {
+        return;
     }
 
-    // Check if processor should be active for current layers
-    if (!is_processor_active_for_current_layers(data->active_layers)) {
-        return ZMK_INPUT_PROC_CONTINUE;
+    uint16_t shift = 0;
+    while ((half_life_ms >> shift) >= RUNTIME_DECAY_MIN_STEPS * 2) {
+        shift++;
     }
-
-    bool is_x = (x_idx >= 0);
-    int16_t value = event->value;
-
-    // Apply code mapping (XY swap and XY-to-scroll)
-    // These mappings are mutually exclusive - XY-to-scroll takes precedence
-    if (data->xy_to_scroll_enabled) {
-        // Map X/Y to horizontal/vertical scroll
-        // X (0x00) -> HWHEEL (0x06), Y (0x01) -> WHEEL (0x08)
-        if (is_x) {
-            event->code = INPUT_REL_HWHEEL;
-            LOG_DBG("XY-to-scroll: mapped X to HWHEEL");
-        } else {
-            event->code = INPUT_REL_WHEEL;
-            LOG_DBG("XY-to-scroll: mapped Y to WHEEL");
-        }
-    } else if (data->xy_swap_enabled) {
-        // Swap X and Y axes
-        // X (0x00) -> Y (0x01), Y (0x01) -> X (0x00)
-        if (is_x) {
-            event->code = INPUT_REL_Y;
-            LOG_DBG("XY-swap: swapped X to Y");
+    uint32_t half_life_steps = half_life_ms >> shift;
+
+    // Find the per-step factor f with f^half_life_steps = 1/2 by bisection
+    uint32_t lo = 0;
+    uint32_t hi = RUNTIME_Q16_ONE;
+    while (hi - lo > 1) {
+        uint32_t mid = (lo + hi) / 2;
+        if (q16_pow_unit(mid, half_life_steps * 100) > RUNTIME_Q16_ONE / 2) {
+            hi = mid;
         } else {
-            event->code = INPUT_REL_X;
-            LOG_DBG("XY-swap: swapped Y to X");
+            lo = mid;
         }
     }
 
-    // Handle temp-layer layer activation
-    if (data->temp_layer_enabled && event->value != 0) {
-        int64_t now = k_uptime_get();
-        data->last_input_timestamp = now;
+    decay->factor_q16 = hi;
+    decay->shift = shift;
+    decay->max_steps =
+        MIN(half_life_steps * RUNTIME_DECAY_HALF_LIVES, BIT(RUNTIME_DECAY_BITS) - 1);
+}
 
-        // Check if we should activate the layer
-        if (!data->temp_layer_layer_active) {
-            // Only activate if no key press within activation delay window
-            if (data->last_keypress_timestamp == 0 ||
-                (now - data->last_keypress_timestamp) >= data->temp_layer_activation_delay_ms) {
-                // Schedule activation
-                k_work_reschedule(&data->temp_layer_activation_work, K_NO_WAIT);
-            }
-        }
+// Decay an accumulator by the given number of steps
+static int32_t decay_accum(const struct runtime_decay *decay, int32_t accum_q8, uint32_t steps) {
+    if (steps > decay->max_steps) {
+        return 0;
     }
 
-    // Apply rotation
-    if (data->rotation_degrees != 0) {
-        if (is_x) {
-            data->last_x = value;
-            data->has_x = true;
-
-            // If we have both X and Y, apply rotation
-            if (data->has_y) {
-                // X' = X * cos - Y * sin
-                // Using 1000 as scaling factor for fixed-point arithmetic
-                // (precision: 0.001)
-                int32_t rotated_x =
-                    (data->last_x * data->cos_val - data->last_y * data->sin_val) / 1000;
-                event->value = (int16_t)rotated_x;
-                data->has_y = false;
-            } else {
-                event->value = 0;
-            }
-        } else {
-            data->last_y = value;
-            data->has_y = true;
-
-            // If we have both X and Y, apply rotation
-            if (data->has_x) {
-                // Y' = X * sin + Y * cos
-                int32_t rotated_y =
-                    (data->last_x * data->sin_val + data->last_y * data->cos_val) / 1000;
-                event->value = (int16_t)rotated_y;
-                data->has_x = false;
-            } else {
-                event->value = 0;
-            }
+    // Decay the magnitude so that negative values also round towards zero
+    uint32_t magnitude = accum_q8 < 0 ? -accum_q8 : accum_q8;
+    for (uint32_t factor = decay->factor_q16; steps != 0; steps >>= 1) {
+        if (steps & 1) {
+            magnitude = ((uint64_t)magnitude * factor) >> RUNTIME_Q16_SHIFT;
         }
+        factor = ((uint64_t)factor * factor) >> RUNTIME_Q16_SHIFT;
     }
+    return accum_q8 < 0 ? -(int32_t)magnitude : (int32_t)magnitude;
+}
 
-    // Apply axis inversion after rotation
-    if ((is_x && data->x_invert) || (!is_x && data->y_invert)) {
-        event->value = -event->value;
+// Decay an accumulator from *timestamp up to now. The partial step is kept in
+// *timestamp so that decay is not quantised away. Returns the steps applied.
+static uint32_t decay_accum_until(const struct runtime_decay *decay, int32_t *accum_q8,
+                                  runtime_tick_t *timestamp, runtime_tick_t now) {
+    uint32_t steps = (runtime_tick_t)(now - *timestamp) >> decay->shift;
+    if (steps > 0) {
+        *accum_q8 = decay_accum(decay, *accum_q8, steps);
+        *timestamp += steps << decay->shift;
     }
-    value = event->value;
+    return steps;
+}
+#endif
 
-    // Apply axis snapping if configured
-    if (data->axis_snap_mode != ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE && event->value != 0) {
-        int64_t now = k_uptime_get();
-        bool is_snapped_axis =
-            (data->axis_snap_mode == ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_X && is_x) ||
-            (data->axis_snap_mode == ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_Y && !is_x);
-        bool is_cross_axis = !is_snapped_axis;
-
-        // Decay accumulator over time
-        if (data->axis_snap_timeout_ms > 0 && data->axis_snap_last_decay_timestamp > 0) {
-            int64_t elapsed = now - data->axis_snap_last_decay_timestamp;
-            if (elapsed > 0) {
-                // Decay rate: threshold per timeout period
-                // Decay every 50ms
-                int64_t decay_periods = elapsed / 50;
-                if (decay_periods > 0) {
-                    int16_t decay_per_50ms =
-                        data->axis_snap_threshold / (data->axis_snap_timeout_ms / 50);
-                    if (decay_per_50ms < 1) {
-                        decay_per_50ms = 1; // Minimum decay of 1
-                    }
-
-                    int16_t total_decay = decay_per_50ms * decay_periods;
-
-                    // Decay towards zero
-                    if (data->axis_snap_cross_axis_accum > 0) {
-                        data->axis_snap_cross_axis_accum -= total_decay;
-                        if (data->axis_snap_cross_axis_accum < 0) {
-                            data->axis_snap_cross_axis_accum = 0;
-                        }
-                    } else if (data->axis_snap_cross_axis_accum < 0) {
-                        data->axis_snap_cross_axis_accum += total_decay;
-                        if (data->axis_snap_cross_axis_accum > 0) {
-                            data->axis_snap_cross_axis_accum = 0;
-                        }
-                    }
-
-                    data->axis_snap_last_decay_timestamp = now;
-                    LOG_DBG("Axis snap: decayed accum to %d (decay=%d)",
-                            data->axis_snap_cross_axis_accum, total_decay);
-                }
-            }
+#if RUNTIME_HAS_AXIS_SNAP
+// Axis snap stage: suppress cross-axis motion while it stays under the
+// threshold. Returns the value to pass on.
+static int32_t apply_axis_snap(struct runtime_processor_data *data,
+                               const struct runtime_processor_plan *plan, uint8_t axis,
+                               int32_t value, runtime_tick_t now) {
+    int8_t snap_axis = plan->axis_snap_mode == ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_X   ? 0
+                       : plan->axis_snap_mode == ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_Y ? 1
+                                                                                      : -1;
+    uint32_t abs_value = value < 0 ? -value : value;
+
+    if (plan->axis_snap_mode == ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_AUTO) {
+        // A pause ends the gesture; the next one picks its axis again
+        if ((runtime_tick_t)(now - data->state.axis_snap_last_motion) >=
+            CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_AXIS_SNAP_AUTO_GAP_MS) {
+            data->state.axis_snap_auto_axis = -1;
+            data->state.axis_snap_auto_lead[0] = 0;
+            data->state.axis_snap_auto_lead[1] = 0;
+            data->state.axis_snap_accum_q8 = 0;
+            data->state.axis_snap_decay_armed = false;
         }
-
-        bool should_unlock = false;
-
-        if (is_cross_axis) {
-            int16_t current_abs_accum = data->axis_snap_cross_axis_accum < 0
-                                            ? -data->axis_snap_cross_axis_accum
-                                            : data->axis_snap_cross_axis_accum;
-            bool is_unsnapped = current_abs_accum >= data->axis_snap_threshold;
-
-            if (is_unsnapped) {
-                // Just increase accumulator when already unsnapped
-                data->axis_snap_cross_axis_accum = current_abs_accum + (value > 0 ? value : -value);
-            } else {
-                // Accumulate normally when snapped (no abs)
-                data->axis_snap_cross_axis_accum += value;
-            }
-            // Reset decay timer on movement
-            data->axis_snap_last_decay_timestamp = now;
-
-            // Check if threshold exceeded (check absolute value)
-            int16_t abs_accum = data->axis_snap_cross_axis_accum < 0
-                                    ? -data->axis_snap_cross_axis_accum
-                                    : data->axis_snap_cross_axis_accum;
-
-            if (abs_accum >= data->axis_snap_threshold) {
-                LOG_DBG("Axis snap: unlocked (threshold=%d exceeded with accum=%d)",
-                        data->axis_snap_threshold, data->axis_snap_cross_axis_accum);
-                // cap the accumulator to twice the threshold so that it decays
-                // under threshold within timeout
-                if (abs_accum > data->axis_snap_threshold * 2) {
-                    data->axis_snap_cross_axis_accum =
-                        (data->axis_snap_cross_axis_accum > 0 ? data->axis_snap_threshold
-                                                              : -data->axis_snap_threshold) *
-                        2;
-                }
-            } else {
-                // Suppress cross-axis movement while locked
-                event->value = 0;
-                LOG_DBG("Axis snap: suppressing cross-axis movement (accum=%d, "
-                        "threshold=%d)",
-                        data->axis_snap_cross_axis_accum, data->axis_snap_threshold);
+        data->state.axis_snap_last_motion = now;
+
+        if (data->state.axis_snap_auto_axis < 0) {
+            data->state.axis_snap_auto_lead[axis] += abs_value;
+            if (data->state.axis_snap_auto_lead[0] + data->state.axis_snap_auto_lead[1] >=
+                CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_AXIS_SNAP_AUTO_COUNTS) {
+                const uint32_t *lead = data->state.axis_snap_auto_lead;
+                data->state.axis_snap_auto_axis = lead[0] >= lead[1] ? 0 : 1;
+                LOG_DBG("Axis snap: auto locked to %s",
+                        data->state.axis_snap_auto_axis == 0 ? "X" : "Y");
             }
         }
-
-        // Update value after snap processing
-        value = event->value;
+        snap_axis = data->state.axis_snap_auto_axis;
     }
 
-    // Apply scaling
-    if (data->scale_multiplier > 0 && data->scale_divisor > 0) {
-        scale_val(event, data->scale_multiplier, data->scale_divisor, state);
-        value = event->value;
+    // Decay accumulator over time
+    if (plan->axis_snap_decay.max_steps > 0 && data->state.axis_snap_decay_armed) {
+        uint32_t steps =
+            decay_accum_until(&plan->axis_snap_decay, &data->state.axis_snap_accum_q8,
+                              &data->state.axis_snap_decay_timestamp, now);
+        if (steps > 0) {
+            LOG_DBG("Axis snap: decayed accum to %d (Q8, %u steps)",
+                    data->state.axis_snap_accum_q8, steps);
+        }
     }
 
-    // Schedule deactivation after input stops
-    if (data->temp_layer_enabled && data->temp_layer_layer_active &&
-        !data->temp_layer_keep_active) {
-        k_work_reschedule(&data->temp_layer_deactivation_work,
-                          K_MSEC(data->temp_layer_deactivation_delay_ms));
+    // Until AUTO mode has picked an axis, motion passes through unchanged
+    if (snap_axis >= 0 && axis != snap_axis) {
+        int32_t threshold_q8 = plan->axis_snap_threshold_q8;
+        int32_t value_q8 = CLAMP(value, INT16_MIN, INT16_MAX) * (1 << RUNTIME_ACCUM_SHIFT);
+        int32_t *accum_q8 = &data->state.axis_snap_accum_q8;
+        int32_t abs_accum_q8 = *accum_q8 < 0 ? -*accum_q8 : *accum_q8;
+
+        if (abs_accum_q8 >= threshold_q8) {
+            // Just increase accumulator when already unsnapped
+            *accum_q8 = abs_accum_q8 + (value_q8 < 0 ? -value_q8 : value_q8);
+        } else {
+            // Accumulate normally when snapped (no abs)
+            *accum_q8 += value_q8;
+        }
+        // Restart decay on movement
+        data->state.axis_snap_decay_timestamp = now;
+        data->state.axis_snap_decay_armed = true;
+
+        abs_accum_q8 = *accum_q8 < 0 ? -*accum_q8 : *accum_q8;
+        if (abs_accum_q8 >= threshold_q8) {
+            LOG_DBG("Axis snap: unlocked (threshold=%d exceeded with accum=%d)",
+                    threshold_q8 >> RUNTIME_ACCUM_SHIFT,
+                    *accum_q8 >> RUNTIME_ACCUM_SHIFT);
+            // Cap the accumulator to twice the threshold so that it decays
+            // under the threshold within one timeout
+            if (abs_accum_q8 > threshold_q8 * 2) {
+                *accum_q8 = *accum_q8 > 0 ? threshold_q8 * 2 : -threshold_q8 * 2;
+            }
+        } else {
+            // Suppress cross-axis movement while locked
+            RUNTIME_STATS_INC(data, snap_suppressed);
+            LOG_DBG("Axis snap: suppressing cross-axis movement (accum=%d, threshold=%d)",
+                    *accum_q8 >> RUNTIME_ACCUM_SHIFT,
+                    threshold_q8 >> RUNTIME_ACCUM_SHIFT);
+            return 0;
+        }
     }
 
-    return ZMK_INPUT_PROC_CONTINUE;
+    return value;
 }
+#endif
 
-static struct zmk_input_processor_driver_api runtime_processor_driver_api = {
-    .handle_event = runtime_processor_handle_event,
-};
-
-#if IS_ENABLED(CONFIG_SETTINGS)
-struct processor_settings {
-    uint32_t scale_multiplier;
-    uint32_t scale_divisor;
-    int32_t rotation_degrees;
-    bool temp_layer_enabled;
-    uint8_t temp_layer_layer;
-    uint16_t temp_layer_activation_delay_ms;
-    uint16_t temp_layer_deactivation_delay_ms;
-    uint32_t active_layers;
-    uint8_t axis_snap_mode;
-    uint16_t axis_snap_threshold;
-    uint16_t axis_snap_timeout_ms;
-    bool xy_to_scroll_enabled;
-    bool xy_swap_enabled;
-    bool x_invert;
-    bool y_invert;
-};
-
-static void save_processor_settings_work_handler(struct k_work *work) {
-    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-    struct runtime_processor_data *data =
-        CONTAINER_OF(dwork, struct runtime_processor_data, save_work);
-    const struct device *dev = data->dev;
-    const struct runtime_processor_config *cfg = dev->config;
+#if RUNTIME_HAS_TEMP_LAYER
+// Temp-layer motion gate: accumulate the input magnitude with the window
+// decay. Returns the accumulated motion (Q24.8).
+static int32_t temp_layer_track_motion(struct runtime_processor_data *data,
+                                       const struct runtime_processor_plan *plan, int32_t value,
+                                       bool typing, runtime_tick_t now) {
+    int32_t *motion_q8 = &data->state.temp_layer_motion_q8;
+
+    if (plan->temp_layer_decay.max_steps == 0) {
+        // Without a window the threshold applies to each event on its own
+        *motion_q8 = 0;
+    } else if (data->state.temp_layer_motion_armed) {
+        decay_accum_until(&plan->temp_layer_decay, motion_q8,
+                          &data->state.temp_layer_motion_timestamp, now);
+    } else {
+        data->state.temp_layer_motion_timestamp = now;
+        data->state.temp_layer_motion_armed = true;
+    }
 
-    struct processor_settings settings = {
-        .scale_multiplier = data->persistent_scale_multiplier,
-        .scale_divisor = data->persistent_scale_divisor,
-        .rotation_degrees = data->persistent_rotation_degrees,
-        .temp_layer_enabled = data->persistent_temp_layer_enabled,
-        .temp_layer_layer = data->persistent_temp_layer_layer,
-        .temp_layer_activation_delay_ms = data->persistent_temp_layer_activation_delay_ms,
-        .temp_layer_deactivation_delay_ms = data->persistent_temp_layer_deactivation_delay_ms,
-        .active_layers = data->persistent_active_layers,
-        .axis_snap_mode = data->persistent_axis_snap_mode,
-        .axis_snap_threshold = data->persistent_axis_snap_threshold,
-        .axis_snap_timeout_ms = data->persistent_axis_snap_timeout_ms,
-        .xy_to_scroll_enabled = data->persistent_xy_to_scroll_enabled,
-        .xy_swap_enabled = data->persistent_xy_swap_enabled,
-        .x_invert = data->persistent_x_invert,
-        .y_invert = data->persistent_y_invert,
-    };
+    // Motion while typing is not a pointer gesture, so it starts over once the
+    // typing stops instead of adding up towards activation
+    if (typing && !data->state.temp_layer_layer_active) {
+        *motion_q8 = 0;
+        return 0;
+    }
 
-    char path[64];
-    snprintf(path, sizeof(path), "input_proc/%s", cfg->name);
+    int32_t abs_value = value < 0 ? -value : value;
+    *motion_q8 += MIN(abs_value, INT16_MAX) * (1 << RUNTIME_ACCUM_SHIFT);
 
-    int ret = settings_save_one(path, &settings, sizeof(settings));
-    if (ret < 0) {
-        LOG_ERR("Failed to save settings for %s: %d", cfg->name, ret);
-    } else {
-        LOG_INF("Saved settings for %s", cfg->name);
+    // Cap the accumulator to twice the larger threshold so that it decays
+    // under the release threshold within a few windows once motion stops
+    int32_t cap_q8 = MAX(plan->temp_layer_activation_q8, plan->temp_layer_release_q8) * 2;
+    if (*motion_q8 > cap_q8) {
+        *motion_q8 = cap_q8;
     }
+    return *motion_q8;
 }
+#endif
 
-static int schedule_save_processor_settings(const struct device *dev) {
-    struct runtime_processor_data *data = dev->data;
-    return k_work_reschedule(&data->save_work, K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE));
-}
+// Serializes writes of the current and persistent values and plan publishing
+// across all processors
+static K_MUTEX_DEFINE(runtime_plan_mutex);
+
+static void build_processor_plan(const struct runtime_processor_config *cfg,
+                                 const struct zmk_input_processor_runtime_config *config,
+                                 struct runtime_processor_plan *plan) {
+    *plan = (struct runtime_processor_plan){0};
+
+    // Code mapping: XY-to-scroll takes precedence over XY swap
+    if (config->xy_to_scroll_enabled) {
+        plan->stages |= RUNTIME_STAGE_REMAP;
+        plan->out_code[0] = INPUT_REL_HWHEEL;
+        plan->out_code[1] = INPUT_REL_WHEEL;
+    } else if (config->xy_swap_enabled) {
+        plan->stages |= RUNTIME_STAGE_REMAP;
+        plan->out_code[0] = INPUT_REL_Y;
+        plan->out_code[1] = INPUT_REL_X;
+    }
 
-static int load_processor_settings_cb(const char *name, size_t len, settings_read_cb read_cb,
-                                      void *cb_arg, void *param) {
-    const struct device *dev = (const struct device *)param;
-    struct runtime_processor_data *data = dev->data;
-    const struct runtime_processor_config *cfg = dev->config;
+#if RUNTIME_HAS_TEMP_LAYER
+    if (config->temp_layer_enabled) {
+        plan->stages |= RUNTIME_STAGE_TEMP_LAYER;
+    }
+    plan->temp_layer_activation_delay_ms = config->temp_layer_activation_delay_ms;
+    plan->temp_layer_deactivation_delay_ms = config->temp_layer_deactivation_delay_ms;
+    plan->temp_layer_activation_q8 = (int32_t)config->temp_layer_activation_threshold
+                                     << RUNTIME_ACCUM_SHIFT;
+    plan->temp_layer_release_q8 = (int32_t)config->temp_layer_release_threshold
+                                  << RUNTIME_ACCUM_SHIFT;
+    build_decay(config->temp_layer_motion_window_ms, &plan->temp_layer_decay);
+#endif
 
-    if (len == sizeof(struct processor_settings)) {
-        struct processor_settings settings;
-        int rc = read_cb(cb_arg, &settings, sizeof(settings));
-        if (rc >= 0) {
-            data->persistent_scale_multiplier = settings.scale_multiplier;
-            data->persistent_scale_divisor = settings.scale_divisor;
-            data->persistent_rotation_degrees = settings.rotation_degrees;
-            data->persistent_temp_layer_enabled = settings.temp_layer_enabled;
-            data->persistent_temp_layer_layer = settings.temp_layer_layer;
-            data->persistent_temp_layer_activation_delay_ms =
-                settings.temp_layer_activation_delay_ms;
-            data->persistent_temp_layer_deactivation_delay_ms =
-                settings.temp_layer_deactivation_delay_ms;
-            data->persistent_active_layers = settings.active_layers;
-            data->persistent_axis_snap_mode = settings.axis_snap_mode;
-            data->persistent_axis_snap_threshold = settings.axis_snap_threshold;
-            data->persistent_axis_snap_timeout_ms = settings.axis_snap_timeout_ms;
-            data->persistent_xy_to_scroll_enabled = settings.xy_to_scroll_enabled;
-            data->persistent_xy_swap_enabled = settings.xy_swap_enabled;
-            data->persistent_x_invert = settings.x_invert;
-            data->persistent_y_invert = settings.y_invert;
-
-            // Apply to current values
-            data->scale_multiplier = settings.scale_multiplier;
-            data->scale_divisor = settings.scale_divisor;
-            data->rotation_degrees = settings.rotation_degrees;
-            data->temp_layer_enabled = settings.temp_layer_enabled;
-            data->temp_layer_layer = settings.temp_layer_layer;
-            data->temp_layer_activation_delay_ms = settings.temp_layer_activation_delay_ms;
-            data->temp_layer_deactivation_delay_ms = settings.temp_layer_deactivation_delay_ms;
-            data->active_layers = settings.active_layers;
-            data->axis_snap_mode = settings.axis_snap_mode;
-            data->axis_snap_threshold = settings.axis_snap_threshold;
-            data->axis_snap_timeout_ms = settings.axis_snap_timeout_ms;
-            data->xy_to_scroll_enabled = settings.xy_to_scroll_enabled;
-            data->xy_swap_enabled = settings.xy_swap_enabled;
-            data->x_invert = settings.x_invert;
-            data->y_invert = settings.y_invert;
-            update_rotation_values(data);
-
-            LOG_INF("Loaded settings for %s: scale=%d/%d, rotation=%d, "
-                    "temp_layer=%d, active_layers=0x%08x, axis_snap=%d",
-                    cfg->name, settings.scale_multiplier, settings.scale_divisor,
-                    settings.rotation_degrees, settings.temp_layer_enabled, settings.active_layers,
-                    settings.axis_snap_mode);
-            return 0;
+    // Stages that are not compiled in are left out of the plan, whatever the
+    // (e.g. previously saved) config asks for
+    bool snap = RUNTIME_HAS_AXIS_SNAP &&
+                config->axis_snap_mode != ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE;
+    // The scroll sub-pipeline scales XY-to-scroll output on its own
+    bool scroll = RUNTIME_HAS_SCROLL && config->xy_to_scroll_enabled &&
+                  config->scroll_scale_multiplier > 0 && config->scroll_scale_divisor > 0;
+    bool scale = config->scale_multiplier > 0 && config->scale_divisor > 0 &&
+                 config->scale_multiplier != config->scale_divisor && !scroll;
+    // Axis snap thresholds apply to unscaled values, so only fold the scale
+    // into the matrix when snap is off
+    uint32_t mul = (scale && !snap) ? config->scale_multiplier : 1;
+    uint32_t div = (scale && !snap) ? config->scale_divisor : 1;
+    int32_t x_sign = config->x_invert ? -1 : 1;
+    int32_t y_sign = config->y_invert ? -1 : 1;
+    bool rotate = false;
+    bool linear = false;
+
+    // A source's mounting rotation adds to the runtime one and its scale,
+    // which normalizes the sensor resolution, is always folded in
+    for (uint8_t i = 0; i < cfg->sources_len; i++) {
+        const struct runtime_source_config *source =
+            cfg->source_configs ? &cfg->source_configs[i] : NULL;
+        int32_t (*matrix)[2] = plan->matrix[i];
+
+#if RUNTIME_HAS_ROTATION
+        int32_t degrees = config->rotation_degrees + (source ? source->rotation_degrees : 0);
+        int32_t sin_v = sin_q16(degrees);
+        int32_t cos_v = sin_q16(degrees % 360 + 90);
+        LOG_DBG("Rotation %d degrees: cos=%d, sin=%d (Q16)", degrees, cos_v, sin_v);
+#else
+        int32_t sin_v = 0;
+        int32_t cos_v = RUNTIME_Q16_ONE;
+#endif
+        uint32_t source_mul = source ? source->scale_multiplier : 1;
+        uint32_t source_div = source ? source->scale_divisor : 1;
+        int32_t cos_scaled = q16_mul_ratio(q16_mul_ratio(cos_v, mul, div), source_mul, source_div);
+        int32_t sin_scaled = q16_mul_ratio(q16_mul_ratio(sin_v, mul, div), source_mul, source_div);
+
+        // X' = X * cos - Y * sin, Y' = X * sin + Y * cos, then inversion and scale
+        matrix[0][0] = x_sign * cos_scaled;
+        matrix[0][1] = x_sign * -sin_scaled;
+        matrix[1][0] = y_sign * sin_scaled;
+        matrix[1][1] = y_sign * cos_scaled;
+
+        if (matrix[0][1] != 0 || matrix[1][0] != 0) {
+            rotate = true;
+        } else if (matrix[0][0] != RUNTIME_Q16_ONE || matrix[1][1] != RUNTIME_Q16_ONE) {
+            linear = true;
         }
     }
-    return -EINVAL;
-}
+
+    // Sources share one matrix stage, so a single rotated source rotates them all
+    if (rotate) {
+        plan->stages |= RUNTIME_STAGE_ROTATE;
+    } else if (linear) {
+        plan->stages |= RUNTIME_STAGE_LINEAR;
+    }
+
+#if RUNTIME_HAS_AXIS_SNAP
+    if (snap) {
+        plan->stages |= RUNTIME_STAGE_AXIS_SNAP;
+        plan->axis_snap_threshold_q8 = (int32_t)config->axis_snap_threshold
+                                       << RUNTIME_ACCUM_SHIFT;
+        build_decay(config->axis_snap_timeout_ms, &plan->axis_snap_decay);
+        if (scale) {
+            plan->stages |= RUNTIME_STAGE_SCALE;
+            plan->scale_q16 =
+                q16_mul_ratio(RUNTIME_Q16_ONE, config->scale_multiplier, config->scale_divisor);
+        }
+    }
+    plan->axis_snap_mode = config->axis_snap_mode;
+#endif
+
+#if RUNTIME_HAS_ACCEL
+    build_accel_plan(config, plan);
+#endif
+
+#if RUNTIME_HAS_FILTER
+    if (config->filter_dead_zone > 0 || config->filter_iir_shift > 0) {
+        plan->stages |= RUNTIME_STAGE_FILTER;
+        plan->filter_dead_zone = config->filter_dead_zone;
+        plan->filter_idle_ms = config->filter_idle_ms;
+        plan->filter_iir_shift = config->filter_iir_shift;
+    }
+#endif
+
+#if RUNTIME_HAS_SCROLL
+    if (scroll) {
+        plan->stages |= RUNTIME_STAGE_SCROLL;
+        plan->scroll_scale_q16 =
+            q16_mul_ratio(RUNTIME_Q16_ONE, (uint32_t)config->scroll_scale_multiplier *
+                                               MAX(config->scroll_hires_multiplier, 1),
+                          config->scroll_scale_divisor);
+        plan->scroll_snap = config->scroll_snap;
+    }
+#endif
+
+#if RUNTIME_RELAY_CENTRAL
+    // The peripheral already applied the transforms to relayed motion
+    if (cfg->relay_behavior) {
+        plan->stages &= RUNTIME_STAGE_TEMP_LAYER;
+    }
+#endif
+}
+
+// Wait for event handlers still pinning a buffer that is not active (picked
+// up before the previous swap) before it is overwritten
+static void wait_plan_readers(struct runtime_processor_data *data, int slot) {
+    while (atomic_get(&data->state.plan_readers[slot]) != 0) {
+        k_msleep(1);
+    }
+}
+
+// Make slot the active plan with a new generation. Caller holds
+// runtime_plan_mutex, and slot must not be active.
+static void activate_plan_slot(struct runtime_processor_data *data, int slot) {
+    int current = atomic_get(&data->state.active_plan);
+
+    wait_plan_readers(data, slot);
+    data->plans[slot].generation = data->plans[current].generation + 1;
+    atomic_set(&data->state.active_plan, slot);
+}
+
+// Publish plan through the scratch buffer that is not active. Caller holds
+// runtime_plan_mutex.
+static void publish_plan(struct runtime_processor_data *data,
+                         const struct runtime_processor_plan *plan) {
+    int current = atomic_get(&data->state.active_plan);
+    int next = current == 0 ? 1 : 0;
+
+    wait_plan_readers(data, next);
+    data->plans[next] = *plan;
+    activate_plan_slot(data, next);
+}
+
+#if RUNTIME_HAS_ACCEL
+// Load the acceleration gains of config ahead of activating its plan. Plans
+// only differ in their gains while a plan with RUNTIME_STAGE_ACCEL is not
+// active, so the event path is first moved onto a copy of the active plan
+// without acceleration, and the gains are rewritten once no handler can read
+// them any more. Caller holds runtime_plan_mutex.
+static void update_accel_gains(struct runtime_processor_data *data,
+                               const struct zmk_input_processor_runtime_config *config,
+                               const struct runtime_processor_plan *plan) {
+    int32_t gains[ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS];
+
+    // Plans without acceleration do not read the gains
+    if (!(plan->stages & RUNTIME_STAGE_ACCEL)) {
+        return;
+    }
+    build_accel_gains(config, gains);
+    if (memcmp(gains, data->accel_gain_q16, sizeof(gains)) == 0) {
+        return;
+    }
+
+    int active = atomic_get(&data->state.active_plan);
+    if (data->plans[active].stages & RUNTIME_STAGE_ACCEL) {
+        struct runtime_processor_plan interim = data->plans[active];
+
+        interim.stages &= ~RUNTIME_STAGE_ACCEL;
+        publish_plan(data, &interim);
+        active = atomic_get(&data->state.active_plan);
+    }
+    for (int i = 0; i < RUNTIME_PLAN_SLOTS; i++) {
+        if (i != active) {
+            wait_plan_readers(data, i);
+        }
+    }
+    memcpy(data->accel_gain_q16, gains, sizeof(gains));
+}
+#else
+static inline void update_accel_gains(struct runtime_processor_data *data,
+                                      const struct zmk_input_processor_runtime_config *config,
+                                      const struct runtime_processor_plan *plan) {}
+#endif
+
+#if RUNTIME_RELAY_CENTRAL
+static void queue_relay_config(const struct device *dev);
+#else
+static inline void queue_relay_config(const struct device *dev) {}
+#endif
+
+// Build and publish the plan of the current values. Caller holds
+// runtime_plan_mutex from the first write of the values on, so that no plan
+// is built from a partly updated set of them.
+static void update_processor_plan(const struct device *dev) {
+    struct runtime_processor_data *data = dev->data;
+    struct runtime_processor_plan plan;
+
+    // Built from the current (possibly temporary) values
+    build_processor_plan(dev->config, &data->current, &plan);
+    update_accel_gains(data, &data->current, &plan);
+    publish_plan(data, &plan);
+#if RUNTIME_PROFILE_COUNT > 0
+    data->active_profile = -1;
+#endif
+
+    LOG_DBG("Processor plan stages: 0x%03x", plan.stages);
+    queue_relay_config(dev);
+}
+
+// Pin the active plan for the duration of one event. Retries if a setter
+// swapped buffers between reading the index and pinning it.
+static const struct runtime_processor_plan *acquire_plan(struct runtime_processor_data *data,
+                                                         int *idx) {
+    while (true) {
+        int i = atomic_get(&data->state.active_plan);
+        atomic_inc(&data->state.plan_readers[i]);
+        if (atomic_get(&data->state.active_plan) == i) {
+            *idx = i;
+            return &data->plans[i];
+        }
+        atomic_dec(&data->state.plan_readers[i]);
+    }
+}
+
+static void release_plan(struct runtime_processor_data *data, int idx) {
+    atomic_dec(&data->state.plan_readers[idx]);
+}
+
+// Reset event path runtime state after a config change
+static void reset_runtime_state(struct runtime_processor_data *data,
+                                const struct runtime_processor_plan *plan) {
+    for (size_t i = 0; i < RUNTIME_SOURCES_MAX; i++) {
+        struct runtime_source_state *src = &data->state.sources[i];
+
+        src->remainder_q16[0] = 0;
+        src->remainder_q16[1] = 0;
+#if RUNTIME_HAS_ROTATION
+        src->frame_value[0] = 0;
+        src->frame_value[1] = 0;
+        src->frame_carry_q16[0] = 0;
+        src->frame_carry_q16[1] = 0;
+#endif
+#if RUNTIME_HAS_FILTER
+        src->filter_window_armed = false;
+        src->filter_awake = false;
+        src->filter_frame_open = false;
+        src->filter_smoothing = false;
+#endif
+    }
+    data->state.gain_remainder_q16[0] = 0;
+    data->state.gain_remainder_q16[1] = 0;
+#if RUNTIME_HAS_AXIS_SNAP
+    data->state.axis_snap_accum_q8 = 0;
+    data->state.axis_snap_decay_armed = false;
+    data->state.axis_snap_auto_axis = -1;
+    data->state.axis_snap_auto_lead[0] = 0;
+    data->state.axis_snap_auto_lead[1] = 0;
+#endif
+#if RUNTIME_HAS_TEMP_LAYER
+    data->state.temp_layer_motion_q8 = 0;
+    data->state.temp_layer_motion_armed = false;
+#endif
+#if RUNTIME_HAS_SCROLL
+    data->state.scroll_q16[0] = 0;
+    data->state.scroll_q16[1] = 0;
+    data->state.scroll_frame_open = false;
+#endif
+    data->state.generation = plan->generation;
+}
+
+#if RUNTIME_HAS_TEMP_LAYER
+// Temp-layer layer work handlers. One activation and one deactivation work
+// item are shared by all processors; each processor flags what it is waiting
+// for in temp_layer_flags and the handlers visit every flagged processor.
+static void update_temp_layer_keep_map(const struct device *dev);
+
+static void temp_layer_activation_work_handler(struct k_work *work);
+static void temp_layer_deactivation_work_handler(struct k_work *work);
+
+static K_WORK_DEFINE(temp_layer_activation_work, temp_layer_activation_work_handler);
+static K_WORK_DELAYABLE_DEFINE(temp_layer_deactivation_work, temp_layer_deactivation_work_handler);
+// Serializes the compare-and-reschedule in arm_temp_layer_deactivation()
+static struct k_spinlock temp_layer_deactivation_lock;
+
+// Make sure the shared deactivation work runs within delay_ms
+static void arm_temp_layer_deactivation(uint32_t delay_ms) {
+    k_spinlock_key_t key = k_spin_lock(&temp_layer_deactivation_lock);
+    if (!k_work_delayable_is_pending(&temp_layer_deactivation_work) ||
+        k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&temp_layer_deactivation_work)) >
+            delay_ms) {
+        k_work_reschedule(&temp_layer_deactivation_work, K_MSEC(delay_ms));
+    }
+    k_spin_unlock(&temp_layer_deactivation_lock, key);
+}
+
+static int activate_temp_layer(const struct device *dev, void *user_data) {
+    struct runtime_processor_data *data = dev->data;
+
+    if (!atomic_test_and_clear_bit(&data->temp_layer_flags,
+                                   RUNTIME_TEMP_LAYER_ACTIVATION_PENDING)) {
+        return 0;
+    }
+
+    if (!data->current.temp_layer_enabled || data->state.temp_layer_layer_active) {
+        return 0;
+    }
+
+    // Activate the temp-layer layer
+    int ret = zmk_keymap_layer_activate(data->current.temp_layer_layer);
+    if (ret == 0) {
+        data->state.temp_layer_layer_active = true;
+        RUNTIME_STATS_INC(data, temp_layer_activations);
+        LOG_INF("Temp-layer layer %d activated", data->current.temp_layer_layer);
+
+        // Start the deactivation window from the input that activated the layer
+        data->state.temp_layer_last_motion = k_uptime_get_32();
+        if (!data->state.temp_layer_keep_active &&
+            !atomic_test_and_set_bit(&data->temp_layer_flags,
+                                     RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED)) {
+            arm_temp_layer_deactivation(data->current.temp_layer_deactivation_delay_ms);
+        }
+    } else {
+        LOG_ERR("Failed to activate temp-layer layer %d: %d", data->current.temp_layer_layer, ret);
+    }
+    return 0;
+}
+
+static void temp_layer_activation_work_handler(struct k_work *work) {
+    zmk_input_processor_runtime_foreach(activate_temp_layer, NULL);
+}
+
+// Deactivate the layer if the processor has been idle for the delay, otherwise
+// lower *next_ms to the time it still has left
+static int deactivate_idle_temp_layer(const struct device *dev, void *user_data) {
+    struct runtime_processor_data *data = dev->data;
+    uint32_t *next_ms = user_data;
+
+    if (!atomic_test_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED)) {
+        return 0;
+    }
+
+    if (!data->state.temp_layer_layer_active || data->state.temp_layer_keep_active) {
+        atomic_clear_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATE_NOW);
+        atomic_clear_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED);
+        return 0;
+    }
+
+    // Input seen since the work was scheduled: wait for the remaining time
+    runtime_tick_t idle = k_uptime_get_32() - data->state.temp_layer_last_motion;
+    if (!atomic_test_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATE_NOW) &&
+        idle < data->current.temp_layer_deactivation_delay_ms) {
+        *next_ms = MIN(*next_ms, data->current.temp_layer_deactivation_delay_ms - idle);
+        return 0;
+    }
+    atomic_clear_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATE_NOW);
+    atomic_clear_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED);
+
+    // Deactivate the temp-layer layer
+    int ret = zmk_keymap_layer_deactivate(data->current.temp_layer_layer);
+    if (ret == 0) {
+        data->state.temp_layer_layer_active = false;
+        LOG_INF("Temp-layer layer %d deactivated", data->current.temp_layer_layer);
+    } else {
+        LOG_ERR("Failed to deactivate temp-layer layer %d: %d", data->current.temp_layer_layer,
+                ret);
+    }
+    return 0;
+}
+
+static void temp_layer_deactivation_work_handler(struct k_work *work) {
+    uint32_t next_ms = UINT32_MAX;
+
+    zmk_input_processor_runtime_foreach(deactivate_idle_temp_layer, &next_ms);
+    if (next_ms != UINT32_MAX) {
+        arm_temp_layer_deactivation(next_ms);
+    }
+}
+#else
+static inline void update_temp_layer_keep_map(const struct device *dev) {}
+#endif
+
+static bool is_processor_active_for_current_layers(uint32_t active_layers_mask) {
+    // If mask is 0, processor is active for all layers
+    if (active_layers_mask == 0) {
+        return true;
+    }
+
+#if !RUNTIME_HAS_KEYMAP
+    // The central relays 0 while the processor is active for its layers
+    return false;
+#else
+
+    // Check only the layers that are set in the bitmask
+    // This is more efficient than checking all layers
+    uint32_t remaining_mask = active_layers_mask;
+    int layer_idx = 0;
+
+    while (remaining_mask != 0 && layer_idx < ZMK_KEYMAP_LAYERS_LEN) {
+        // Check if this bit is set
+        if (remaining_mask & 1) {
+            zmk_keymap_layer_id_t layer_id = zmk_keymap_layer_index_to_id(layer_idx);
+
+            if (layer_id != ZMK_KEYMAP_LAYER_ID_INVAL && zmk_keymap_layer_active(layer_id)) {
+                return true;
+            }
+        }
+
+        remaining_mask >>= 1;
+        layer_idx++;
+    }
+
+    return false;
+#endif
+}
+
+static void update_active_for_layers(struct runtime_processor_data *data) {
+    data->state.active_for_layers =
+        is_processor_active_for_current_layers(data->current.active_layers);
+}
+
+#if RUNTIME_HAS_ROTATION
+// Frame-synchronous rotation. Each event is still passed through (one event
+// in, one event out), so the output is split as follows: every event carries
+// its own-axis term right away, and the cross-axis terms are resolved on the
+// event with the sync flag. The sync event gets the other axis' contribution
+// from this frame; the sync axis' contribution to the other axis is carried
+// into that axis' next event.
+static int32_t rotate_frame_event(struct runtime_source_state *src, const int32_t (*matrix)[2],
+                                  uint8_t axis, int32_t value, bool sync, int32_t *remainder) {
+    uint8_t other = axis ^ 1;
+
+    int64_t acc = (int64_t)value * matrix[axis][axis] + src->frame_carry_q16[axis];
+    src->frame_carry_q16[axis] = 0;
+    src->frame_value[axis] += value;
+
+    if (sync) {
+        acc += (int64_t)src->frame_value[other] * matrix[axis][other];
+        src->frame_carry_q16[other] += (int64_t)src->frame_value[axis] * matrix[other][axis];
+        src->frame_value[0] = 0;
+        src->frame_value[1] = 0;
+    }
+
+    return q16_to_int(acc, remainder);
+}
+#endif
+
+#if RUNTIME_HAS_FILTER
+// A pause longer than this restarts the smoothing filter from rest
+#define RUNTIME_FILTER_REST_MS 100
+
+// Jitter filter dead zone. Input is idle until it travels more than the dead
+// zone on one axis within filter_idle_ms; travel is summed, so jitter that
+// goes back and forth never leaves idle, while slow motion does. Idle input is
+// dropped, except that the sync event of a frame that already passed an event
+// on goes on with a zero value so the frame is still closed.
+// Returns false if the event is dropped.
+static bool filter_dead_zone(struct runtime_processor_data *data, struct runtime_source_state *src,
+                             const struct runtime_processor_plan *plan, uint8_t axis,
+                             int32_t *value, bool sync, runtime_tick_t now) {
+    if (!src->filter_window_armed ||
+        (runtime_tick_t)(now - src->filter_window_start) >= plan->filter_idle_ms) {
+        // A whole window without travel beyond the dead zone
+        src->filter_travel[0] = 0;
+        src->filter_travel[1] = 0;
+        src->filter_window_start = now;
+        src->filter_window_armed = true;
+        src->filter_awake = false;
+    }
+
+    int64_t travel = (int64_t)src->filter_travel[axis] + *value;
+    if (travel > plan->filter_dead_zone || travel < -(int64_t)plan->filter_dead_zone) {
+        src->filter_travel[0] = 0;
+        src->filter_travel[1] = 0;
+        src->filter_window_start = now;
+        src->filter_awake = true;
+    } else {
+        src->filter_travel[axis] = (int32_t)travel;
+    }
+
+    if (src->filter_awake) {
+        src->filter_frame_open = !sync;
+        return true;
+    }
+    if (sync && src->filter_frame_open) {
+        src->filter_frame_open = false;
+        *value = 0;
+        return true;
+    }
+    RUNTIME_STATS_INC(data, filter_dropped);
+    return false;
+}
+
+// One-pole low-pass on the input: the output moves 1/2^filter_iir_shift of
+// the way towards each new value, with the rounding carried per axis. Motion
+// still owed when the input stops is dropped with the filter state.
+static int32_t filter_smooth(struct runtime_source_state *src,
+                             const struct runtime_processor_plan *plan, uint8_t axis,
+                             int32_t value, runtime_tick_t now) {
+    if (!src->filter_smoothing ||
+        (runtime_tick_t)(now - src->filter_last_smoothed) > RUNTIME_FILTER_REST_MS) {
+        src->filter_q16[0] = 0;
+        src->filter_q16[1] = 0;
+        src->filter_remainder_q16[0] = 0;
+        src->filter_remainder_q16[1] = 0;
+        src->filter_smoothing = true;
+    }
+    src->filter_last_smoothed = now;
+
+    int64_t target = (int64_t)CLAMP(value, INT16_MIN, INT16_MAX) * RUNTIME_Q16_ONE;
+    src->filter_q16[axis] += (int32_t)((target - src->filter_q16[axis]) >> plan->filter_iir_shift);
+    return q16_to_int(src->filter_q16[axis], &src->filter_remainder_q16[axis]);
+}
+#endif
+
+#if RUNTIME_HAS_COALESCE
+// Motion coalescing. Input is summed per axis and its events are stopped until
+// coalesce-interval-ms has passed since the last flush. The frame in which it
+// has passed flushes: each of its events carries everything held back for its
+// axis, and its sync event starts the next interval. The stages then run on
+// the sums, so a divisor rounds once per flush instead of once per sensor
+// event, and the remainders carry across flushes as they would across events.
+// Input that is still held back when the interval ends, because the motion
+// stopped, is flushed by the shared flush work.
+static void coalesce_flush_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(coalesce_flush_work, coalesce_flush_work_handler);
+// Serializes the compare-and-reschedule in arm_coalesce_flush()
+static struct k_spinlock coalesce_flush_lock;
+
+// Make sure the shared flush work runs within delay_ms
+static void arm_coalesce_flush(uint32_t delay_ms) {
+    k_spinlock_key_t key = k_spin_lock(&coalesce_flush_lock);
+    if (!k_work_delayable_is_pending(&coalesce_flush_work) ||
+        k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&coalesce_flush_work)) > delay_ms) {
+        k_work_reschedule(&coalesce_flush_work, K_MSEC(delay_ms));
+    }
+    k_spin_unlock(&coalesce_flush_lock, key);
+}
+
+// Flush the held back input of every source whose interval has ended by
+// reporting a zero-valued event per held back axis from its device. The
+// events go through the input listener like sensor input and each picks up
+// its axis' sum in coalesce_event(); the last one closes the frame. Sources
+// still inside their interval lower *next_ms to the time they have left.
+static int flush_coalesced_input(const struct device *dev, void *user_data) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+    uint32_t *next_ms = user_data;
+    runtime_tick_t now = k_uptime_get_32();
+
+    for (uint8_t i = 0; i < cfg->sources_len; i++) {
+        struct runtime_source_state *src = &data->state.sources[i];
+        if (!atomic_test_bit(data->coalesce_pending, 2 * i) &&
+            !atomic_test_bit(data->coalesce_pending, 2 * i + 1)) {
+            continue;
+        }
+
+        runtime_tick_t elapsed = now - src->coalesce_last_flush;
+        if (elapsed < cfg->coalesce_interval_ms) {
+            *next_ms = MIN(*next_ms, cfg->coalesce_interval_ms - elapsed);
+            continue;
+        }
+        // Cleared here as well, as an inactive processor does not see the events
+        bool pending[2] = {atomic_test_and_clear_bit(data->coalesce_pending, 2 * i),
+                           atomic_test_and_clear_bit(data->coalesce_pending, 2 * i + 1)};
+        for (uint8_t axis = 0; axis < 2; axis++) {
+            if (pending[axis]) {
+                input_report(src->coalesce_dev, cfg->type, src->coalesce_code[axis], 0,
+                             axis == 1 || !pending[1], K_NO_WAIT);
+            }
+        }
+    }
+    return 0;
+}
+
+static void coalesce_flush_work_handler(struct k_work *work) {
+    uint32_t next_ms = UINT32_MAX;
+
+    zmk_input_processor_runtime_foreach(flush_coalesced_input, &next_ms);
+    if (next_ms != UINT32_MAX) {
+        arm_coalesce_flush(next_ms);
+    }
+}
+
+// Returns false if the event is held back.
+static bool coalesce_event(const struct runtime_processor_config *cfg,
+                           struct runtime_processor_data *data, uint8_t source,
+                           struct runtime_source_state *src, uint8_t axis,
+                           struct input_event *event, runtime_tick_t now) {
+    int64_t sum = (int64_t)src->coalesce_value[axis] + event->value;
+    src->coalesce_value[axis] = (int32_t)CLAMP(sum, INT32_MIN, INT32_MAX);
+
+    if (!src->coalesce_flushing) {
+        runtime_tick_t elapsed = now - src->coalesce_last_flush;
+        if (elapsed < cfg->coalesce_interval_ms) {
+            RUNTIME_STATS_INC(data, coalesced);
+            src->coalesce_dev = event->dev;
+            src->coalesce_code[axis] = event->code;
+            if (!atomic_test_and_set_bit(data->coalesce_pending, 2 * source + axis)) {
+                arm_coalesce_flush(cfg->coalesce_interval_ms - elapsed);
+            }
+            return false;
+        }
+        src->coalesce_flushing = true;
+        src->coalesce_last_flush = now;
+    }
+
+    atomic_clear_bit(data->coalesce_pending, 2 * source + axis);
+    event->value = src->coalesce_value[axis];
+    src->coalesce_value[axis] = 0;
+    if (event->sync) {
+        src->coalesce_flushing = false;
+    }
+    return true;
+}
+#endif
+
+#if RUNTIME_HAS_SCROLL
+// Scroll sub-pipeline for XY-to-scroll. Motion is scaled into a per-axis
+// accumulator of wheel units (detents, or 1/scroll_hires_multiplier of a
+// detent), and only whole units are passed on. Reversing direction drops the
+// rest, so the first unit either way takes a full unit of motion. With scroll
+// snap only the axis that accumulated more scrolls, and each unit it passes on
+// clears the other axis. Events without a whole unit are held back, except
+// the sync event of a frame that already passed one on, which goes on with a
+// zero value so the frame is still closed.
+// Returns false if the event is held back.
+static bool scroll_accumulate(struct runtime_processor_data *data,
+                              const struct runtime_processor_plan *plan, uint8_t axis,
+                              struct input_event *event) {
+    int64_t acc = data->state.scroll_q16[axis];
+    int64_t delta = (int64_t)event->value * plan->scroll_scale_q16;
+    if ((delta < 0 && acc > 0) || (delta > 0 && acc < 0)) {
+        acc = 0;
+    }
+    acc = CLAMP(acc + delta, INT32_MIN, INT32_MAX);
+
+    // Truncate towards zero: a unit is passed on once it has been crossed
+    int32_t units = (int32_t)(acc / RUNTIME_Q16_ONE);
+    if (units != 0 && plan->scroll_snap) {
+        int64_t other = data->state.scroll_q16[!axis];
+        if ((acc < 0 ? -acc : acc) < (other < 0 ? -other : other)) {
+            units = 0;
+        } else {
+            data->state.scroll_q16[!axis] = 0;
+        }
+    }
+    data->state.scroll_q16[axis] = (int32_t)(acc - (int64_t)units * RUNTIME_Q16_ONE);
+
+    if (units != 0) {
+        event->value = saturate_to_int16(data, units);
+        data->state.scroll_frame_open = !event->sync;
+        return true;
+    }
+    if (event->sync && data->state.scroll_frame_open) {
+        data->state.scroll_frame_open = false;
+        event->value = 0;
+        return true;
+    }
+    RUNTIME_STATS_INC(data, scroll_held);
+    return false;
+}
+#endif
+
+// Time of the event being processed, read from the kernel at most once per
+// event by whichever step needs it first
+struct runtime_event_time {
+    runtime_tick_t now;
+    bool valid;
+};
+
+static inline runtime_tick_t event_time(struct runtime_event_time *time) {
+    if (!time->valid) {
+        time->now = k_uptime_get_32();
+        time->valid = true;
+    }
+    return time->now;
+}
+
+// Index of the source that produced event. Events from devices that are not
+// listed in source-devices are handled as the first source's.
+static uint8_t event_source(const struct runtime_processor_config *cfg,
+                            const struct input_event *event) {
+#if RUNTIME_HAS_SOURCES
+    for (uint8_t i = 1; i < cfg->sources_len; i++) {
+        if (cfg->source_devices[i] == event->dev) {
+            return i;
+        }
+    }
+#endif
+    return 0;
+}
+
+// time is the event time, shared with the telemetry recorded after the event
+static int runtime_processor_process_event(const struct device *dev, struct input_event *event,
+                                           struct zmk_input_processor_state *state,
+                                           struct runtime_event_time *time) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+
+    if (event->type != cfg->type || event->code >= RUNTIME_CODE_MASK_BITS ||
+        !(cfg->code_mask & BIT64(event->code))) {
+        return ZMK_INPUT_PROC_CONTINUE;
+    }
+    RUNTIME_STATS_INC(data, events);
+
+    // Check if processor should be active for current layers
+    if (!data->state.active_for_layers) {
+        return ZMK_INPUT_PROC_CONTINUE;
+    }
+
+    bool is_x = (cfg->x_code_mask & BIT64(event->code)) != 0;
+    uint8_t axis = is_x ? 0 : 1;
+    uint8_t source = event_source(cfg, event);
+    struct runtime_source_state *src = &data->state.sources[source];
+
+#if RUNTIME_HAS_COALESCE
+    // Held back events skip the stages, the later processors and the listener
+    if (cfg->coalesce_interval_ms > 0 &&
+        !coalesce_event(cfg, data, source, src, axis, event, event_time(time))) {
+        return ZMK_INPUT_PROC_STOP;
+    }
+#endif
+
+    int plan_idx;
+    const struct runtime_processor_plan *plan = acquire_plan(data, &plan_idx);
+    if (plan->stages == 0) {
+        release_plan(data, plan_idx);
+        return ZMK_INPUT_PROC_CONTINUE;
+    }
+
+    if (plan->generation != data->state.generation) {
+        reset_runtime_state(data, plan);
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+    data->stats.processed++;
+    for (uint8_t i = 0; i < ZMK_INPUT_PROCESSOR_STATS_STAGE_COUNT; i++) {
+        if (plan->stages & BIT(i)) {
+            data->stats.stage_events[i]++;
+        }
+    }
+#endif
+
+    int32_t value = event->value;
+
+    // Apply code mapping (XY swap and XY-to-scroll)
+    if (plan->stages & RUNTIME_STAGE_REMAP) {
+        event->code = plan->out_code[axis];
+        LOG_DBG("Code mapping: mapped %s to 0x%02x", is_x ? "X" : "Y", event->code);
+    }
+
+    // Capture the event time once for all timing dependent stages
+    runtime_tick_t now = 0;
+    uint16_t timed_stages = RUNTIME_STAGE_TEMP_LAYER | RUNTIME_STAGE_ACCEL |
+                           RUNTIME_STAGE_AXIS_SNAP | RUNTIME_STAGE_FILTER;
+    if (RUNTIME_SETTINGS_WAIT_FOR_IDLE || (plan->stages & timed_stages)) {
+        now = event_time(time);
+    }
+
+#if RUNTIME_HAS_FILTER
+    // Drop idle input before anything else sees it as motion
+    if (plan->stages & RUNTIME_STAGE_FILTER) {
+        if (plan->filter_dead_zone > 0 &&
+            !filter_dead_zone(data, src, plan, axis, &value, event->sync, now)) {
+            release_plan(data, plan_idx);
+            return ZMK_INPUT_PROC_STOP;
+        }
+        if (plan->filter_iir_shift > 0) {
+            value = filter_smooth(src, plan, axis, value, now);
+        }
+        event->value = value;
+    }
+#endif
+
+#if RUNTIME_SETTINGS_WAIT_FOR_IDLE
+    if (event->value != 0) {
+        runtime_last_motion = now;
+        runtime_motion_seen = true;
+    }
+#endif
+
+#if RUNTIME_HAS_TEMP_LAYER
+    // Whether this input keeps the temp-layer layer active. With a release
+    // threshold, only motion that keeps the accumulator above it does.
+    bool temp_layer_hold = plan->temp_layer_release_q8 == 0;
+
+    // Handle temp-layer layer activation
+    if ((plan->stages & RUNTIME_STAGE_TEMP_LAYER) && event->value != 0) {
+        // Only activate if no key press within activation delay window
+        bool typing = runtime_keypress_seen && (runtime_tick_t)(now - runtime_last_keypress) <
+                                                   plan->temp_layer_activation_delay_ms;
+        int32_t motion_q8 = 0;
+        if (plan->temp_layer_activation_q8 > 0 || plan->temp_layer_release_q8 > 0) {
+            motion_q8 = temp_layer_track_motion(data, plan, value, typing, now);
+            temp_layer_hold = motion_q8 >= plan->temp_layer_release_q8;
+        }
+
+        // Check if we should activate the layer
+        if (!data->state.temp_layer_layer_active && !typing &&
+            motion_q8 >= plan->temp_layer_activation_q8) {
+            // Schedule activation once; the work handler clears the flag
+            if (!atomic_test_and_set_bit(&data->temp_layer_flags,
+                                         RUNTIME_TEMP_LAYER_ACTIVATION_PENDING)) {
+                k_work_submit(&temp_layer_activation_work);
+            }
+        }
+    }
+#endif
+
+#if RUNTIME_HAS_ACCEL
+    if (plan->stages & RUNTIME_STAGE_ACCEL) {
+        update_accel_speed(data, value, event->sync, now);
+    }
+#endif
+
+    int32_t *remainder = (state && state->remainder) ? &src->remainder_q16[axis] : NULL;
+    const int32_t (*matrix)[2] = plan->matrix[source];
+
+    // Apply the mounting correction, rotation, inversion and (when axis snap is
+    // off) scaling
+#if RUNTIME_HAS_ROTATION
+    if ((plan->stages & RUNTIME_STAGE_ROTATE) && cfg->rotation_frame_sync) {
+        int32_t rotated = rotate_frame_event(src, matrix, axis, value, event->sync, remainder);
+        event->value = saturate_to_int16(data, rotated);
+    } else if (plan->stages & RUNTIME_STAGE_ROTATE) {
+        if (is_x) {
+            src->last_x = value;
+            src->has_x = true;
+        } else {
+            src->last_y = value;
+            src->has_y = true;
+        }
+
+        // Only emit once both X and Y have been seen
+        if (src->has_x && src->has_y) {
+            int64_t acc =
+                (int64_t)src->last_x * matrix[axis][0] + (int64_t)src->last_y * matrix[axis][1];
+            event->value = saturate_to_int16(data, q16_to_int(acc, remainder));
+            if (is_x) {
+                src->has_y = false;
+            } else {
+                src->has_x = false;
+            }
+        } else {
+            event->value = 0;
+            RUNTIME_STATS_INC(data, rotation_dropped);
+        }
+    }
+#endif
+    // Exclusive with RUNTIME_STAGE_ROTATE
+    if (plan->stages & RUNTIME_STAGE_LINEAR) {
+        int64_t acc = (int64_t)value * matrix[axis][axis];
+        event->value = saturate_to_int16(data, q16_to_int(acc, remainder));
+    }
+    value = event->value;
+
+#if RUNTIME_HAS_AXIS_SNAP
+    // Apply axis snapping if configured
+    if ((plan->stages & RUNTIME_STAGE_AXIS_SNAP) && event->value != 0) {
+        event->value = apply_axis_snap(data, plan, axis, value, now);
+        value = event->value;
+    }
+#endif
+
+    // Apply scaling after axis snap and acceleration
+    if (plan->stages & (RUNTIME_STAGE_SCALE | RUNTIME_STAGE_ACCEL)) {
+        int64_t gain = (plan->stages & RUNTIME_STAGE_SCALE) ? plan->scale_q16 : RUNTIME_Q16_ONE;
+#if RUNTIME_HAS_ACCEL
+        if (plan->stages & RUNTIME_STAGE_ACCEL) {
+            gain = (gain * accel_gain_q16(data, plan, data->state.accel_speed)) >>
+                   RUNTIME_Q16_SHIFT;
+        }
+#endif
+
+        int32_t *gain_remainder = remainder ? &data->state.gain_remainder_q16[axis] : NULL;
+        int64_t acc = (int64_t)event->value * CLAMP(gain, INT32_MIN, INT32_MAX);
+        event->value = saturate_to_int16(data, q16_to_int(acc, gain_remainder));
+        value = event->value;
+    }
+
+#if RUNTIME_HAS_SCROLL
+    bool scroll_held =
+        (plan->stages & RUNTIME_STAGE_SCROLL) && !scroll_accumulate(data, plan, axis, event);
+#endif
+
+#if RUNTIME_HAS_TEMP_LAYER
+    // Push the deactivation deadline out; only arming touches the kernel
+    if ((plan->stages & RUNTIME_STAGE_TEMP_LAYER) && data->state.temp_layer_layer_active &&
+        !data->state.temp_layer_keep_active && temp_layer_hold) {
+        data->state.temp_layer_last_motion = now;
+        if (!atomic_test_and_set_bit(&data->temp_layer_flags,
+                                     RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED)) {
+            arm_temp_layer_deactivation(plan->temp_layer_deactivation_delay_ms);
+        }
+    }
+#endif
+
+    release_plan(data, plan_idx);
+
+#if RUNTIME_HAS_SCROLL
+    // Scroll below a whole unit skips the later processors and the listener
+    if (scroll_held) {
+        return ZMK_INPUT_PROC_STOP;
+    }
+#endif
+
+#if RUNTIME_RELAY_PERIPHERAL
+    // Motion reduced to nothing (axis snap, rotation pairing, scaling) is not
+    // worth a split report. Sync events still go, to close the frame.
+    if (event->value == 0 && !event->sync) {
+        return ZMK_INPUT_PROC_STOP;
+    }
+#endif
+
+    return ZMK_INPUT_PROC_CONTINUE;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+// Close the current telemetry window into the ring, or count it as lost if
+// the reader has not made room
+static void publish_telemetry_window(struct runtime_processor_data *data) {
+    struct runtime_processor_telemetry *t = &data->telemetry;
+    atomic_val_t head = atomic_get(&t->head);
+
+    t->window_open = false;
+    if ((uint32_t)(head - atomic_get(&t->tail)) >= RUNTIME_TELEMETRY_RING_LEN) {
+        t->lost = MIN(t->lost + 1, UINT16_MAX);
+        return;
+    }
+
+    struct zmk_input_processor_telemetry_sample *sample =
+        &t->ring[head & (RUNTIME_TELEMETRY_RING_LEN - 1)];
+    *sample = t->window;
+    sample->lost = t->lost;
+    sample->snap_axis = -1;
+#if RUNTIME_HAS_AXIS_SNAP
+    int plan_idx;
+    const struct runtime_processor_plan *plan = acquire_plan(data, &plan_idx);
+    if (plan->stages & RUNTIME_STAGE_AXIS_SNAP) {
+        switch (plan->axis_snap_mode) {
+        case ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_X:
+            sample->snap_axis = 0;
+            break;
+        case ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_Y:
+            sample->snap_axis = 1;
+            break;
+        case ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_AUTO:
+            sample->snap_axis = t->snap_auto_axis;
+            break;
+        }
+        int32_t accum_q8 = t->snap_accum_q8;
+        int32_t abs_accum_q8 = accum_q8 < 0 ? -accum_q8 : accum_q8;
+        sample->snap_unlocked =
+            sample->snap_axis >= 0 && abs_accum_q8 >= plan->axis_snap_threshold_q8;
+    }
+    release_plan(data, plan_idx);
+#endif
+    t->lost = 0;
+
+    // Hand the slot over only once it is complete
+    atomic_set(&t->head, head + 1);
+}
+
+// Add one handled event to the telemetry window. value is the input value,
+// event holds the output unless the processor stopped it.
+static void record_telemetry(const struct device *dev, const struct input_event *event,
+                             uint16_t code, int32_t value, int ret,
+                             struct runtime_event_time *time) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+    struct runtime_processor_telemetry *t = &data->telemetry;
+
+    if (!atomic_get(&t->enabled)) {
+        t->window_open = false;
+        return;
+    }
+    if (event->type != cfg->type || code >= RUNTIME_CODE_MASK_BITS ||
+        !(cfg->code_mask & BIT64(code))) {
+        return;
+    }
+
+    runtime_tick_t now = event_time(time);
+    if (t->window_open && (runtime_tick_t)(now - t->window.time_ms) >=
+                              CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_INTERVAL_MS) {
+        publish_telemetry_window(data);
+    }
+    if (!t->window_open) {
+        t->window = (struct zmk_input_processor_telemetry_sample){.time_ms = now};
+        t->window_open = true;
+    }
+
+    uint8_t axis = (cfg->x_code_mask & BIT64(code)) ? 0 : 1;
+    t->window.in[axis] += value;
+    t->window.out[axis] += ret == ZMK_INPUT_PROC_STOP ? 0 : event->value;
+    t->window.events = MIN(t->window.events + 1, UINT16_MAX);
+#if RUNTIME_HAS_AXIS_SNAP
+    t->snap_accum_q8 = data->state.axis_snap_accum_q8;
+    t->snap_auto_axis = data->state.axis_snap_auto_axis;
+#endif
+#if RUNTIME_HAS_TEMP_LAYER
+    t->window.temp_layer_active = data->state.temp_layer_layer_active;
+#endif
+}
+#endif
+
+static int runtime_processor_handle_event(const struct device *dev, struct input_event *event,
+                                          uint32_t param1, uint32_t param2,
+                                          struct zmk_input_processor_state *state) {
+    // Read from the kernel at most once per event, by whichever step needs it first
+    struct runtime_event_time time = {0};
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    // The transform remaps the code and rewrites the value in place
+    uint16_t code = event->code;
+    int32_t value = event->value;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+    struct runtime_processor_data *data = dev->data;
+    uint32_t start = k_cycle_get_32();
+
+    int ret = runtime_processor_process_event(dev, event, state, &time);
+
+    uint32_t cycles = k_cycle_get_32() - start;
+    uint8_t bucket = MIN(find_msb_set(cycles), ZMK_INPUT_PROCESSOR_STATS_HISTOGRAM_BUCKETS - 1);
+    data->stats.cycle_histogram[bucket]++;
+    data->stats.cycles_max = MAX(data->stats.cycles_max, cycles);
+#else
+    int ret = runtime_processor_process_event(dev, event, state, &time);
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    record_telemetry(dev, event, code, value, ret, &time);
+#endif
+    return ret;
+}
+
+static struct zmk_input_processor_driver_api runtime_processor_driver_api = {
+    .handle_event = runtime_processor_handle_event,
+};
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+// Settings record format: a version byte followed by TLV entries (tag byte,
+// length byte, little-endian value). Unknown tags are skipped and missing
+// tags keep their DT defaults, so fields can be added without discarding
+// saved configs.
+#define RUNTIME_SETTINGS_VERSION 1
+#define RUNTIME_SETTINGS_MAX_LEN 144
+
+enum runtime_settings_tag {
+    RUNTIME_SETTINGS_TAG_SCALE_MULTIPLIER = 1,   // u32
+    RUNTIME_SETTINGS_TAG_SCALE_DIVISOR = 2,      // u32
+    RUNTIME_SETTINGS_TAG_ROTATION_DEGREES = 3,   // i32
+    RUNTIME_SETTINGS_TAG_FLAGS = 4,              // u8, RUNTIME_SETTINGS_FLAG_*
+    RUNTIME_SETTINGS_TAG_TEMP_LAYER_LAYER = 5,   // u8
+    RUNTIME_SETTINGS_TAG_TEMP_LAYER_DELAYS = 6,  // u16 activation, u16 deactivation
+    RUNTIME_SETTINGS_TAG_ACTIVE_LAYERS = 7,      // u32
+    RUNTIME_SETTINGS_TAG_AXIS_SNAP = 8,          // u8 mode, u16 threshold, u16 timeout
+    RUNTIME_SETTINGS_TAG_ACCEL = 9,              // u8 curve, u16 speed max, gain max, exponent
+    RUNTIME_SETTINGS_TAG_ACCEL_LUT = 10,         // u16[n]
+    RUNTIME_SETTINGS_TAG_PROFILE_NAME = 11,      // char[n], profile records only
+    RUNTIME_SETTINGS_TAG_FILTER = 12,            // u16 dead zone, u8 IIR shift, u16 idle
+    RUNTIME_SETTINGS_TAG_SCROLL = 13,            // u16 multiplier, divisor, u8 hi-res, u8 snap
+    RUNTIME_SETTINGS_TAG_TEMP_LAYER_MOTION = 14, // u16 activation, u16 release, u16 window
+};
+
+#define RUNTIME_SETTINGS_FLAG_TEMP_LAYER_ENABLED BIT(0)
+#define RUNTIME_SETTINGS_FLAG_XY_TO_SCROLL BIT(1)
+#define RUNTIME_SETTINGS_FLAG_XY_SWAP BIT(2)
+#define RUNTIME_SETTINGS_FLAG_X_INVERT BIT(3)
+#define RUNTIME_SETTINGS_FLAG_Y_INVERT BIT(4)
+
+// Unversioned raw struct written by earlier releases, loaded for migration.
+// Its first byte is the low byte of scale_multiplier, which is as often as not
+// RUNTIME_SETTINGS_VERSION, so records are told apart by their length.
+struct processor_settings_legacy {
+    uint32_t scale_multiplier;
+    uint32_t scale_divisor;
+    int32_t rotation_degrees;
+    bool temp_layer_enabled;
+    uint8_t temp_layer_layer;
+    uint16_t temp_layer_activation_delay_ms;
+    uint16_t temp_layer_deactivation_delay_ms;
+    uint32_t active_layers;
+    uint8_t axis_snap_mode;
+    uint16_t axis_snap_threshold;
+    uint16_t axis_snap_timeout_ms;
+    bool xy_to_scroll_enabled;
+    bool xy_swap_enabled;
+    bool x_invert;
+    bool y_invert;
+};
+
+struct settings_writer {
+    uint8_t buf[RUNTIME_SETTINGS_MAX_LEN];
+    size_t len;
+};
+
+static void settings_put_uint(struct settings_writer *w, uint32_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        w->buf[w->len++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void settings_put_tag(struct settings_writer *w, uint8_t tag, uint8_t len) {
+    w->buf[w->len++] = tag;
+    w->buf[w->len++] = len;
+}
+
+static uint32_t settings_get_uint(const uint8_t *p, uint8_t size) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < size; i++) {
+        value |= (uint32_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+// FNV-1a, used to skip writes of an unchanged record
+static uint32_t settings_hash(const uint8_t *buf, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ buf[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void encode_config_settings(const struct zmk_input_processor_runtime_config *config,
+                                   struct settings_writer *w) {
+    w->len = 0;
+    w->buf[w->len++] = RUNTIME_SETTINGS_VERSION;
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_SCALE_MULTIPLIER, 4);
+    settings_put_uint(w, config->scale_multiplier, 4);
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_SCALE_DIVISOR, 4);
+    settings_put_uint(w, config->scale_divisor, 4);
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_ROTATION_DEGREES, 4);
+    settings_put_uint(w, (uint32_t)config->rotation_degrees, 4);
+
+    uint8_t flags = 0;
+    flags |= config->temp_layer_enabled ? RUNTIME_SETTINGS_FLAG_TEMP_LAYER_ENABLED : 0;
+    flags |= config->xy_to_scroll_enabled ? RUNTIME_SETTINGS_FLAG_XY_TO_SCROLL : 0;
+    flags |= config->xy_swap_enabled ? RUNTIME_SETTINGS_FLAG_XY_SWAP : 0;
+    flags |= config->x_invert ? RUNTIME_SETTINGS_FLAG_X_INVERT : 0;
+    flags |= config->y_invert ? RUNTIME_SETTINGS_FLAG_Y_INVERT : 0;
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_FLAGS, 1);
+    settings_put_uint(w, flags, 1);
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_TEMP_LAYER_LAYER, 1);
+    settings_put_uint(w, config->temp_layer_layer, 1);
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_TEMP_LAYER_DELAYS, 4);
+    settings_put_uint(w, config->temp_layer_activation_delay_ms, 2);
+    settings_put_uint(w, config->temp_layer_deactivation_delay_ms, 2);
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_ACTIVE_LAYERS, 4);
+    settings_put_uint(w, config->active_layers, 4);
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_AXIS_SNAP, 5);
+    settings_put_uint(w, config->axis_snap_mode, 1);
+    settings_put_uint(w, config->axis_snap_threshold, 2);
+    settings_put_uint(w, config->axis_snap_timeout_ms, 2);
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_ACCEL, 7);
+    settings_put_uint(w, config->accel_curve, 1);
+    settings_put_uint(w, config->accel_speed_max, 2);
+    settings_put_uint(w, config->accel_gain_max, 2);
+    settings_put_uint(w, config->accel_exponent, 2);
+
+    if (config->accel_lut_len > 0) {
+        settings_put_tag(w, RUNTIME_SETTINGS_TAG_ACCEL_LUT, config->accel_lut_len * 2);
+        for (uint8_t i = 0; i < config->accel_lut_len; i++) {
+            settings_put_uint(w, config->accel_lut[i], 2);
+        }
+    }
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_FILTER, 5);
+    settings_put_uint(w, config->filter_dead_zone, 2);
+    settings_put_uint(w, config->filter_iir_shift, 1);
+    settings_put_uint(w, config->filter_idle_ms, 2);
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_SCROLL, 6);
+    settings_put_uint(w, config->scroll_scale_multiplier, 2);
+    settings_put_uint(w, config->scroll_scale_divisor, 2);
+    settings_put_uint(w, config->scroll_hires_multiplier, 1);
+    settings_put_uint(w, config->scroll_snap, 1);
+
+    settings_put_tag(w, RUNTIME_SETTINGS_TAG_TEMP_LAYER_MOTION, 6);
+    settings_put_uint(w, config->temp_layer_activation_threshold, 2);
+    settings_put_uint(w, config->temp_layer_release_threshold, 2);
+    settings_put_uint(w, config->temp_layer_motion_window_ms, 2);
+}
+
+// Encode the persistent values of a processor
+static void encode_processor_settings(const struct device *dev, struct settings_writer *w) {
+    const struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    encode_config_settings(&data->persistent, w);
+    k_mutex_unlock(&runtime_plan_mutex);
+}
+
+// Every record carries all tags but the accel LUT
+#define RUNTIME_SETTINGS_RECORD_MIN_LEN (1 + 6 * 3 + 3 + 3 + 6 + 6 + 7 + 9 + 7 + 8 + 8)
+#define RUNTIME_SETTINGS_RECORD_MAX_LEN                                                            \
+    (RUNTIME_SETTINGS_RECORD_MIN_LEN + 2 + 2 * ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS)
+
+BUILD_ASSERT(RUNTIME_SETTINGS_RECORD_MIN_LEN > sizeof(struct processor_settings_legacy),
+             "Settings records must be longer than legacy records");
+BUILD_ASSERT(RUNTIME_SETTINGS_RECORD_MAX_LEN <= RUNTIME_SETTINGS_MAX_LEN,
+             "RUNTIME_SETTINGS_MAX_LEN too small for the settings record");
+BUILD_ASSERT(RUNTIME_SETTINGS_RECORD_MAX_LEN + 2 +
+                     CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILE_NAME_MAX_LEN <=
+                 RUNTIME_SETTINGS_MAX_LEN,
+             "RUNTIME_SETTINGS_MAX_LEN too small for a profile record");
+
+// Decode a versioned record on top of config. Returns -EINVAL if the buffer
+// is not a well formed record; legacy records never are.
+static int decode_processor_settings(const uint8_t *buf, size_t len,
+                                     struct zmk_input_processor_runtime_config *config) {
+    if (len < 1 || len == sizeof(struct processor_settings_legacy) ||
+        buf[0] != RUNTIME_SETTINGS_VERSION) {
+        return -EINVAL;
+    }
+
+    // Validate the TLV framing before touching config
+    size_t pos = 1;
+    while (pos < len) {
+        if (pos + 2 > len || pos + 2 + buf[pos + 1] > len) {
+            return -EINVAL;
+        }
+        pos += 2 + buf[pos + 1];
+    }
+
+    pos = 1;
+    while (pos < len) {
+        uint8_t tag = buf[pos];
+        uint8_t tag_len = buf[pos + 1];
+        const uint8_t *v = &buf[pos + 2];
+        pos += 2 + tag_len;
+
+        switch (tag) {
+        case RUNTIME_SETTINGS_TAG_SCALE_MULTIPLIER:
+            if (tag_len >= 4) {
+                config->scale_multiplier = settings_get_uint(v, 4);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_SCALE_DIVISOR:
+            if (tag_len >= 4) {
+                config->scale_divisor = settings_get_uint(v, 4);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_ROTATION_DEGREES:
+            if (tag_len >= 4) {
+                config->rotation_degrees = (int32_t)settings_get_uint(v, 4);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_FLAGS:
+            if (tag_len >= 1) {
+                config->temp_layer_enabled = v[0] & RUNTIME_SETTINGS_FLAG_TEMP_LAYER_ENABLED;
+                config->xy_to_scroll_enabled = v[0] & RUNTIME_SETTINGS_FLAG_XY_TO_SCROLL;
+                config->xy_swap_enabled = v[0] & RUNTIME_SETTINGS_FLAG_XY_SWAP;
+                config->x_invert = v[0] & RUNTIME_SETTINGS_FLAG_X_INVERT;
+                config->y_invert = v[0] & RUNTIME_SETTINGS_FLAG_Y_INVERT;
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_TEMP_LAYER_LAYER:
+            if (tag_len >= 1) {
+                config->temp_layer_layer = v[0];
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_TEMP_LAYER_DELAYS:
+            if (tag_len >= 4) {
+                config->temp_layer_activation_delay_ms = settings_get_uint(v, 2);
+                config->temp_layer_deactivation_delay_ms = settings_get_uint(v + 2, 2);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_ACTIVE_LAYERS:
+            if (tag_len >= 4) {
+                config->active_layers = settings_get_uint(v, 4);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_AXIS_SNAP:
+            if (tag_len >= 5) {
+                config->axis_snap_mode = v[0];
+                config->axis_snap_threshold = settings_get_uint(v + 1, 2);
+                config->axis_snap_timeout_ms = settings_get_uint(v + 3, 2);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_ACCEL:
+            if (tag_len >= 7) {
+                config->accel_curve = v[0];
+                config->accel_speed_max = settings_get_uint(v + 1, 2);
+                config->accel_gain_max = settings_get_uint(v + 3, 2);
+                config->accel_exponent = settings_get_uint(v + 5, 2);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_ACCEL_LUT:
+            config->accel_lut_len = MIN(tag_len / 2, ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS);
+            memset(config->accel_lut, 0, sizeof(config->accel_lut));
+            for (uint8_t i = 0; i < config->accel_lut_len; i++) {
+                config->accel_lut[i] = settings_get_uint(v + 2 * i, 2);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_FILTER:
+            if (tag_len >= 5) {
+                config->filter_dead_zone = settings_get_uint(v, 2);
+                config->filter_iir_shift = v[2];
+                config->filter_idle_ms = settings_get_uint(v + 3, 2);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_SCROLL:
+            if (tag_len >= 6) {
+                config->scroll_scale_multiplier = settings_get_uint(v, 2);
+                config->scroll_scale_divisor = settings_get_uint(v + 2, 2);
+                config->scroll_hires_multiplier = v[4];
+                config->scroll_snap = v[5] != 0;
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_TEMP_LAYER_MOTION:
+            if (tag_len >= 6) {
+                config->temp_layer_activation_threshold = settings_get_uint(v, 2);
+                config->temp_layer_release_threshold = settings_get_uint(v + 2, 2);
+                config->temp_layer_motion_window_ms = settings_get_uint(v + 4, 2);
+            }
+            break;
+        case RUNTIME_SETTINGS_TAG_PROFILE_NAME:
+            // Read by load_profile_settings_cb()
+            break;
+        default:
+            // Written by a newer firmware, keep going
+            LOG_DBG("Skipping unknown settings tag %d", tag);
+            break;
+        }
+    }
+
+    return 0;
+}
+
+// Decode an unversioned record written by earlier releases on top of config
+static int decode_legacy_processor_settings(const uint8_t *buf, size_t len,
+                                            struct zmk_input_processor_runtime_config *config) {
+    struct processor_settings_legacy settings;
+    if (len != sizeof(settings)) {
+        return -EINVAL;
+    }
+    memcpy(&settings, buf, len);
+
+    config->scale_multiplier = settings.scale_multiplier;
+    config->scale_divisor = settings.scale_divisor;
+    config->rotation_degrees = settings.rotation_degrees;
+    config->temp_layer_enabled = settings.temp_layer_enabled;
+    config->temp_layer_layer = settings.temp_layer_layer;
+    config->temp_layer_activation_delay_ms = settings.temp_layer_activation_delay_ms;
+    config->temp_layer_deactivation_delay_ms = settings.temp_layer_deactivation_delay_ms;
+    config->active_layers = settings.active_layers;
+    config->axis_snap_mode = settings.axis_snap_mode;
+    config->axis_snap_threshold = settings.axis_snap_threshold;
+    config->axis_snap_timeout_ms = settings.axis_snap_timeout_ms;
+    config->xy_to_scroll_enabled = settings.xy_to_scroll_enabled;
+    config->xy_swap_enabled = settings.xy_swap_enabled;
+    config->x_invert = settings.x_invert;
+    config->y_invert = settings.y_invert;
+
+    return 0;
+}
+
+// Processors (by ID) with persistent changes not yet written, flushed by one
+// module-wide debounced work item
+static atomic_t settings_dirty;
+// Processors (by ID) whose settings were loaded from the storage layout not in
+// use, so the old entry is deleted after the next successful flush
+static atomic_t settings_stale;
+
+#define RUNTIME_SETTINGS_KEY_LEN                                                                   \
+    (sizeof("input_proc/") + CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN)
+
+// Key of the aggregated entry, which holds a version byte followed by
+// (name length, name, record length, record) per processor
+#define RUNTIME_SETTINGS_AGGREGATE_NAME "_all"
+#define RUNTIME_SETTINGS_AGGREGATE_VERSION 1
+#define RUNTIME_SETTINGS_AGGREGATE_MAX_LEN                                                         \
+    (1 + DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *                                                  \
+             (2 + CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN + RUNTIME_SETTINGS_MAX_LEN))
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) <= 32,
+             "Settings dirty tracking supports at most 32 runtime input processors");
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+// Shared by the aggregated load and flush
+static uint8_t settings_aggregate_buf[RUNTIME_SETTINGS_AGGREGATE_MAX_LEN];
+static K_MUTEX_DEFINE(settings_aggregate_mutex);
+
+static void flush_aggregated_settings(void) {
+    bool changed = false;
+    size_t len = 0;
+    uint32_t hashes[DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)];
+
+    k_mutex_lock(&settings_aggregate_mutex, K_FOREVER);
+
+    settings_aggregate_buf[len++] = RUNTIME_SETTINGS_AGGREGATE_VERSION;
+    for (uint8_t id = 0; id < ARRAY_SIZE(hashes); id++) {
+        const struct device *dev = zmk_input_processor_runtime_find_by_id(id);
+        const struct runtime_processor_config *cfg = dev->config;
+        struct runtime_processor_data *data = dev->data;
+
+        struct settings_writer w;
+        encode_processor_settings(dev, &w);
+        hashes[id] = settings_hash(w.buf, w.len);
+        changed |= !data->saved_settings_valid || data->saved_settings_hash != hashes[id];
+
+        size_t name_len = strlen(cfg->name);
+        settings_aggregate_buf[len++] = name_len;
+        memcpy(&settings_aggregate_buf[len], cfg->name, name_len);
+        len += name_len;
+        settings_aggregate_buf[len++] = w.len;
+        memcpy(&settings_aggregate_buf[len], w.buf, w.len);
+        len += w.len;
+    }
+
+    int ret = 0;
+    if (changed) {
+        ret = settings_save_one("input_proc/" RUNTIME_SETTINGS_AGGREGATE_NAME,
+                                settings_aggregate_buf, len);
+    }
+
+    k_mutex_unlock(&settings_aggregate_mutex);
+
+    if (!changed) {
+        LOG_DBG("Aggregated settings unchanged, not saving");
+        return;
+    }
+    if (ret < 0) {
+        LOG_ERR("Failed to save aggregated settings: %d", ret);
+        return;
+    }
+
+    for (uint8_t id = 0; id < ARRAY_SIZE(hashes); id++) {
+        struct runtime_processor_data *data = zmk_input_processor_runtime_find_by_id(id)->data;
+        data->saved_settings_hash = hashes[id];
+        data->saved_settings_valid = true;
+    }
+    LOG_INF("Saved aggregated settings (%d bytes)", len);
+
+    // Drop per-processor entries that have been folded into the aggregate
+    uint32_t stale = (uint32_t)atomic_clear(&settings_stale);
+    while (stale) {
+        uint8_t id = __builtin_ctz(stale);
+        stale &= stale - 1;
+
+        const struct runtime_processor_config *cfg =
+            zmk_input_processor_runtime_find_by_id(id)->config;
+        char path[RUNTIME_SETTINGS_KEY_LEN];
+        snprintf(path, sizeof(path), "input_proc/%s", cfg->name);
+        settings_delete(path);
+    }
+}
+
+#else
+
+static void flush_processor_settings(const struct device *dev) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+
+    struct settings_writer w;
+    encode_processor_settings(dev, &w);
+
+    // Skip the flash write if the record is unchanged
+    uint32_t hash = settings_hash(w.buf, w.len);
+    if (data->saved_settings_valid && data->saved_settings_hash == hash) {
+        LOG_DBG("Settings for %s unchanged, not saving", cfg->name);
+        return;
+    }
+
+    char path[RUNTIME_SETTINGS_KEY_LEN];
+    snprintf(path, sizeof(path), "input_proc/%s", cfg->name);
+
+    int ret = settings_save_one(path, w.buf, w.len);
+    if (ret < 0) {
+        LOG_ERR("Failed to save settings for %s: %d", cfg->name, ret);
+    } else {
+        data->saved_settings_hash = hash;
+        data->saved_settings_valid = true;
+        LOG_INF("Saved settings for %s (%d bytes)", cfg->name, w.len);
+    }
+}
+
+#endif
+
+#if RUNTIME_PROFILE_COUNT > 0
+// Profiles are stored as "input_proc/<processor>/p<index>" entries holding a
+// settings record plus the profile name. They are always written on their own,
+// as they only change when a profile is explicitly saved or deleted.
+#define RUNTIME_SETTINGS_PROFILE_KEY_LEN (RUNTIME_SETTINGS_KEY_LEN + sizeof("/p255") - 1)
+
+static void flush_profile_settings(const struct device *dev) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+
+    uint32_t dirty = (uint32_t)atomic_clear(&data->profiles_dirty);
+    while (dirty) {
+        uint8_t index = __builtin_ctz(dirty);
+        dirty &= dirty - 1;
+
+        char path[RUNTIME_SETTINGS_PROFILE_KEY_LEN];
+        snprintf(path, sizeof(path), "input_proc/%s/p%d", cfg->name, index);
+
+        const struct runtime_processor_profile *profile = &data->profiles[index];
+        if (!profile->valid) {
+            settings_delete(path);
+            continue;
+        }
+
+        struct settings_writer w;
+        encode_config_settings(&profile->config, &w);
+        size_t name_len = strlen(profile->name);
+        settings_put_tag(&w, RUNTIME_SETTINGS_TAG_PROFILE_NAME, name_len);
+        memcpy(&w.buf[w.len], profile->name, name_len);
+        w.len += name_len;
+
+        int ret = settings_save_one(path, w.buf, w.len);
+        if (ret < 0) {
+            LOG_ERR("Failed to save profile %d for %s: %d", index, cfg->name, ret);
+        } else {
+            LOG_INF("Saved profile %d for %s (%d bytes)", index, cfg->name, w.len);
+        }
+    }
+}
+#endif
+
+static void settings_flush_work_handler(struct k_work *work) {
+#if RUNTIME_SETTINGS_WAIT_FOR_IDLE
+    // Never write flash in the middle of a gesture
+    runtime_tick_t idle = k_uptime_get_32() - runtime_last_motion;
+    if (runtime_motion_seen && idle < CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_SAVE_IDLE_MS) {
+        k_work_reschedule(k_work_delayable_from_work(work),
+                          K_MSEC(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_SAVE_IDLE_MS - idle));
+        return;
+    }
+#endif
+
+    uint32_t dirty = (uint32_t)atomic_clear(&settings_dirty);
+    if (!dirty) {
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+    flush_aggregated_settings();
+#endif
+
+    for (uint32_t pending = dirty; pending; pending &= pending - 1) {
+        const struct device *dev = zmk_input_processor_runtime_find_by_id(__builtin_ctz(pending));
+        if (!dev) {
+            continue;
+        }
+#if !IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+        flush_processor_settings(dev);
+#endif
+#if RUNTIME_PROFILE_COUNT > 0
+        flush_profile_settings(dev);
+#endif
+    }
+
+#if !IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+    // Drop the aggregated entry once its contents live in per-processor entries
+    if (atomic_clear(&settings_stale)) {
+        settings_delete("input_proc/" RUNTIME_SETTINGS_AGGREGATE_NAME);
+    }
+#endif
+}
+
+static K_WORK_DELAYABLE_DEFINE(settings_flush_work, settings_flush_work_handler);
+
+static int schedule_save_processor_settings(const struct device *dev) {
+    int id = zmk_input_processor_runtime_get_id(dev);
+    if (id < 0) {
+        return -ENODEV;
+    }
+
+    atomic_or(&settings_dirty, BIT(id));
+    int ret = k_work_reschedule(&settings_flush_work, K_MSEC(CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE));
+    return ret < 0 ? ret : 0;
+}
+
+#if RUNTIME_PROFILE_COUNT > 0
+static int validate_config(const struct zmk_input_processor_runtime_config *config,
+                           uint32_t field_mask);
+static void store_profile(const struct device *dev, uint8_t index, const char *name,
+                          const struct zmk_input_processor_runtime_config *config);
+
+static int schedule_save_profile(const struct device *dev, uint8_t index) {
+    struct runtime_processor_data *data = dev->data;
+
+    atomic_or(&data->profiles_dirty, BIT(index));
+    return schedule_save_processor_settings(dev);
+}
+
+static int load_profile_settings_cb(const struct device *dev, uint8_t index, size_t len,
+                                    settings_read_cb read_cb, void *cb_arg) {
+    const struct runtime_processor_config *cfg = dev->config;
+
+    uint8_t buf[RUNTIME_SETTINGS_MAX_LEN];
+    if (len > sizeof(buf)) {
+        LOG_WRN("Profile %d for %s too large (%d bytes)", index, cfg->name, len);
+        return -EINVAL;
+    }
+
+    int rc = read_cb(cb_arg, buf, len);
+    if (rc < 0) {
+        return rc;
+    }
+
+    struct zmk_input_processor_runtime_config config;
+    zmk_input_processor_runtime_get_config(dev, NULL, &config);
+    if (decode_processor_settings(buf, len, &config) < 0 ||
+        validate_config(&config, ZMK_INPUT_PROCESSOR_CONFIG_ALL) < 0) {
+        LOG_WRN("Unrecognized profile %d for %s", index, cfg->name);
+        return -EINVAL;
+    }
+
+    // The framing was validated by decode_processor_settings()
+    char name[CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILE_NAME_MAX_LEN + 1] = {0};
+    for (size_t pos = 1; pos < len; pos += 2 + buf[pos + 1]) {
+        if (buf[pos] == RUNTIME_SETTINGS_TAG_PROFILE_NAME) {
+            memcpy(name, &buf[pos + 2], MIN(buf[pos + 1], sizeof(name) - 1));
+        }
+    }
+
+    store_profile(dev, index, name, &config);
+    LOG_INF("Loaded profile %d for %s: %s", index, cfg->name, name);
+    return 0;
+}
+#endif
+
+// Decode one stored record and apply it as the persistent and current values
+static int load_processor_record(const struct device *dev, const uint8_t *buf, size_t len,
+                                 bool *migrated) {
+    struct runtime_processor_data *data = dev->data;
+    const struct runtime_processor_config *cfg = dev->config;
+
+    // Start from the current (DT default) values so missing fields keep them
+    struct zmk_input_processor_runtime_config config;
+    zmk_input_processor_runtime_get_config(dev, NULL, &config);
+
+    // Legacy records may start with the version byte, so check their size first
+    *migrated = len == sizeof(struct processor_settings_legacy);
+    int ret = *migrated ? decode_legacy_processor_settings(buf, len, &config)
+                        : decode_processor_settings(buf, len, &config);
+    if (ret < 0) {
+        LOG_WRN("Unrecognized settings record for %s (%d bytes)", cfg->name, len);
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->persistent = config;
+
+    // Apply to current values
+    data->current = config;
+    update_active_for_layers(data);
+    update_processor_plan(dev);
+    update_temp_layer_keep_map(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Loaded settings for %s: scale=%d/%d, rotation=%d, "
+            "temp_layer=%d, active_layers=0x%08x, axis_snap=%d",
+            cfg->name, config.scale_multiplier, config.scale_divisor, config.rotation_degrees,
+            config.temp_layer_enabled, config.active_layers, config.axis_snap_mode);
+    return 0;
+}
+
+// Record what is stored for a processor after loading it. Records that need
+// rewriting (legacy format, or the storage layout not in use) are marked
+// dirty; others are hashed so an unchanged config is never rewritten.
+static void track_loaded_record(const struct device *dev, bool rewrite, bool stale_layout) {
+    struct runtime_processor_data *data = dev->data;
+    int id = zmk_input_processor_runtime_get_id(dev);
+
+    if (rewrite || stale_layout) {
+        data->saved_settings_valid = false;
+        if (stale_layout && id >= 0) {
+            atomic_or(&settings_stale, BIT(id));
+        }
+        schedule_save_processor_settings(dev);
+        return;
+    }
+
+    // Re-encode rather than hashing the stored bytes so records with tags
+    // unknown to this firmware are kept until something actually changes
+    struct settings_writer w;
+    encode_processor_settings(dev, &w);
+    data->saved_settings_hash = settings_hash(w.buf, w.len);
+    data->saved_settings_valid = true;
+}
+
+static int load_processor_settings_cb(const char *name, size_t len, settings_read_cb read_cb,
+                                      void *cb_arg, void *param) {
+    const struct device *dev = (const struct device *)param;
+    const struct runtime_processor_config *cfg = dev->config;
+
+    uint8_t buf[MAX(RUNTIME_SETTINGS_MAX_LEN, sizeof(struct processor_settings_legacy))];
+    if (len > sizeof(buf)) {
+        LOG_WRN("Settings record for %s too large (%d bytes)", cfg->name, len);
+        return -EINVAL;
+    }
+
+    int rc = read_cb(cb_arg, buf, len);
+    if (rc < 0) {
+        return rc;
+    }
+
+    bool migrated;
+    rc = load_processor_record(dev, buf, len, &migrated);
+    if (rc < 0) {
+        return rc;
+    }
+
+    if (migrated) {
+        LOG_INF("Migrating legacy settings for %s", cfg->name);
+    }
+    track_loaded_record(dev, migrated,
+                        IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE));
+    return 0;
+}
+
+static int load_aggregated_settings_cb(size_t len, settings_read_cb read_cb, void *cb_arg) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+    uint8_t *buf = settings_aggregate_buf;
+#else
+    // Only read to migrate to per-processor entries, so it is not kept around
+    static uint8_t buf[RUNTIME_SETTINGS_AGGREGATE_MAX_LEN];
+#endif
+    if (len > RUNTIME_SETTINGS_AGGREGATE_MAX_LEN) {
+        LOG_WRN("Aggregated settings too large (%d bytes)", len);
+        return -EINVAL;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+    k_mutex_lock(&settings_aggregate_mutex, K_FOREVER);
+#endif
+
+    int rc = read_cb(cb_arg, buf, len);
+    if (rc >= 0 && (len < 1 || buf[0] != RUNTIME_SETTINGS_AGGREGATE_VERSION)) {
+        LOG_WRN("Unrecognized aggregated settings version");
+        rc = -EINVAL;
+    }
+
+    size_t pos = 1;
+    while (rc >= 0 && pos < len) {
+        if (pos + 1 > len || pos + 1 + buf[pos] + 1 > len) {
+            rc = -EINVAL;
+            break;
+        }
+        const char *name = (const char *)&buf[pos + 1];
+        size_t name_len = buf[pos];
+        pos += 1 + name_len;
+        size_t record_len = buf[pos];
+        const uint8_t *record = &buf[pos + 1];
+        pos += 1 + record_len;
+        if (pos > len) {
+            rc = -EINVAL;
+            break;
+        }
+
+        // Processors no longer in the devicetree are dropped on the next flush
+        char dev_name[CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN + 1];
+        if (name_len >= sizeof(dev_name)) {
+            continue;
+        }
+        memcpy(dev_name, name, name_len);
+        dev_name[name_len] = '\0';
+        const struct device *dev = zmk_input_processor_runtime_find_by_name(dev_name);
+        if (!dev) {
+            continue;
+        }
+
+        bool migrated;
+        if (load_processor_record(dev, record, record_len, &migrated) == 0) {
+            track_loaded_record(dev, migrated,
+                                !IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE));
+        }
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_AGGREGATE)
+    k_mutex_unlock(&settings_aggregate_mutex);
+#endif
+
+    return rc < 0 ? rc : 0;
+}
 
 static int runtime_processor_settings_load_cb(const char *name, size_t len,
                                               settings_read_cb read_cb, void *cb_arg);
@@ -600,162 +2785,623 @@ SETTINGS_STATIC_HANDLER_DEFINE(input_proc, "input_proc", NULL, runtime_processor
                                NULL, NULL);
 #endif
 
+// Set current and persistent acceleration settings to the DT defaults
+static void init_accel_settings(const struct runtime_processor_config *cfg,
+                                struct runtime_processor_data *data) {
+    data->current.accel_curve = cfg->initial_accel_curve;
+    data->current.accel_speed_max = cfg->initial_accel_speed_max;
+    data->current.accel_gain_max = cfg->initial_accel_gain_max;
+    data->current.accel_exponent = cfg->initial_accel_exponent;
+    data->current.accel_lut_len = cfg->initial_accel_lut_len;
+    memset(data->current.accel_lut, 0, sizeof(data->current.accel_lut));
+    if (cfg->initial_accel_lut_len > 0) {
+        memcpy(data->current.accel_lut, cfg->initial_accel_lut,
+               cfg->initial_accel_lut_len * sizeof(data->current.accel_lut[0]));
+    }
+
+    data->persistent.accel_curve = data->current.accel_curve;
+    data->persistent.accel_speed_max = data->current.accel_speed_max;
+    data->persistent.accel_gain_max = data->current.accel_gain_max;
+    data->persistent.accel_exponent = data->current.accel_exponent;
+    data->persistent.accel_lut_len = data->current.accel_lut_len;
+    memcpy(data->persistent.accel_lut, data->current.accel_lut, sizeof(data->persistent.accel_lut));
+}
+
+static void init_filter_settings(const struct runtime_processor_config *cfg,
+                                 struct runtime_processor_data *data) {
+    data->current.filter_dead_zone = cfg->initial_filter_dead_zone;
+    data->current.filter_iir_shift = cfg->initial_filter_iir_shift;
+    data->current.filter_idle_ms = cfg->initial_filter_idle_ms;
+    data->persistent.filter_dead_zone = cfg->initial_filter_dead_zone;
+    data->persistent.filter_iir_shift = cfg->initial_filter_iir_shift;
+    data->persistent.filter_idle_ms = cfg->initial_filter_idle_ms;
+}
+
+static void init_scroll_settings(const struct runtime_processor_config *cfg,
+                                 struct runtime_processor_data *data) {
+    data->current.scroll_scale_multiplier = cfg->initial_scroll_scale_multiplier;
+    data->current.scroll_scale_divisor = cfg->initial_scroll_scale_divisor;
+    data->current.scroll_hires_multiplier = cfg->initial_scroll_hires_multiplier;
+    data->current.scroll_snap = cfg->initial_scroll_snap;
+    data->persistent.scroll_scale_multiplier = cfg->initial_scroll_scale_multiplier;
+    data->persistent.scroll_scale_divisor = cfg->initial_scroll_scale_divisor;
+    data->persistent.scroll_hires_multiplier = cfg->initial_scroll_hires_multiplier;
+    data->persistent.scroll_snap = cfg->initial_scroll_snap;
+}
+
 static int runtime_processor_init(const struct device *dev) {
     const struct runtime_processor_config *cfg = dev->config;
     struct runtime_processor_data *data = dev->data;
 
     // Initialize with default values
-    data->scale_multiplier = cfg->initial_scale_multiplier;
-    data->scale_divisor = cfg->initial_scale_divisor;
-    data->rotation_degrees = cfg->initial_rotation_degrees;
+    data->current.scale_multiplier = cfg->initial_scale_multiplier;
+    data->current.scale_divisor = cfg->initial_scale_divisor;
+    data->current.rotation_degrees = cfg->initial_rotation_degrees;
 
     // Initialize persistent values same as current
-    data->persistent_scale_multiplier = cfg->initial_scale_multiplier;
-    data->persistent_scale_divisor = cfg->initial_scale_divisor;
-    data->persistent_rotation_degrees = cfg->initial_rotation_degrees;
+    data->persistent.scale_multiplier = cfg->initial_scale_multiplier;
+    data->persistent.scale_divisor = cfg->initial_scale_divisor;
+    data->persistent.rotation_degrees = cfg->initial_rotation_degrees;
 
+#if RUNTIME_HAS_ROTATION
     // Initialize rotation state
-    data->has_x = false;
-    data->has_y = false;
-    data->last_x = 0;
-    data->last_y = 0;
+    for (size_t i = 0; i < RUNTIME_SOURCES_MAX; i++) {
+        data->state.sources[i].has_x = false;
+        data->state.sources[i].has_y = false;
+        data->state.sources[i].last_x = 0;
+        data->state.sources[i].last_y = 0;
+    }
+#endif
 
     // Initialize temp-layer settings from DT defaults
-    data->temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->temp_layer_deactivation_delay_ms = cfg->initial_temp_layer_deactivation_delay_ms;
-    data->persistent_temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->persistent_temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->persistent_temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->persistent_temp_layer_deactivation_delay_ms =
+    data->current.temp_layer_enabled = cfg->initial_temp_layer_enabled;
+    data->current.temp_layer_layer = cfg->initial_temp_layer_layer;
+    data->current.temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
+    data->current.temp_layer_deactivation_delay_ms = cfg->initial_temp_layer_deactivation_delay_ms;
+    data->persistent.temp_layer_enabled = cfg->initial_temp_layer_enabled;
+    data->persistent.temp_layer_layer = cfg->initial_temp_layer_layer;
+    data->persistent.temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
+    data->persistent.temp_layer_deactivation_delay_ms =
         cfg->initial_temp_layer_deactivation_delay_ms;
-
+    data->current.temp_layer_activation_threshold = cfg->initial_temp_layer_activation_threshold;
+    data->current.temp_layer_release_threshold = cfg->initial_temp_layer_release_threshold;
+    data->current.temp_layer_motion_window_ms = cfg->initial_temp_layer_motion_window_ms;
+    data->persistent.temp_layer_activation_threshold = cfg->initial_temp_layer_activation_threshold;
+    data->persistent.temp_layer_release_threshold = cfg->initial_temp_layer_release_threshold;
+    data->persistent.temp_layer_motion_window_ms = cfg->initial_temp_layer_motion_window_ms;
+
+#if RUNTIME_HAS_TEMP_LAYER
     // Initialize temp-layer runtime state
-    data->temp_layer_layer_active = false;
-    data->temp_layer_keep_active = false;
-    data->last_input_timestamp = 0;
-    data->last_keypress_timestamp = 0;
+    data->state.temp_layer_layer_active = false;
+    data->state.temp_layer_keep_active = false;
+    data->state.temp_layer_motion_q8 = 0;
+    data->state.temp_layer_motion_armed = false;
+    atomic_clear(&data->temp_layer_flags);
+#endif
 
     // Initialize active layers from DT defaults
-    data->active_layers = cfg->initial_active_layers;
-    data->persistent_active_layers = cfg->initial_active_layers;
+    data->current.active_layers = cfg->initial_active_layers;
+    data->persistent.active_layers = cfg->initial_active_layers;
+    update_active_for_layers(data);
 
     // Initialize axis snap settings from DT defaults
-    data->axis_snap_mode = cfg->initial_axis_snap_mode;
-    data->axis_snap_threshold = cfg->initial_axis_snap_threshold;
-    data->axis_snap_timeout_ms = cfg->initial_axis_snap_timeout_ms;
-    data->persistent_axis_snap_mode = cfg->initial_axis_snap_mode;
-    data->persistent_axis_snap_threshold = cfg->initial_axis_snap_threshold;
-    data->persistent_axis_snap_timeout_ms = cfg->initial_axis_snap_timeout_ms;
-
+    data->current.axis_snap_mode = cfg->initial_axis_snap_mode;
+    data->current.axis_snap_threshold = cfg->initial_axis_snap_threshold;
+    data->current.axis_snap_timeout_ms = cfg->initial_axis_snap_timeout_ms;
+    data->persistent.axis_snap_mode = cfg->initial_axis_snap_mode;
+    data->persistent.axis_snap_threshold = cfg->initial_axis_snap_threshold;
+    data->persistent.axis_snap_timeout_ms = cfg->initial_axis_snap_timeout_ms;
+
+#if RUNTIME_HAS_AXIS_SNAP
     // Initialize axis snap runtime state
-    data->axis_snap_cross_axis_accum = 0;
-    data->axis_snap_last_decay_timestamp = 0;
+    data->state.axis_snap_accum_q8 = 0;
+    data->state.axis_snap_decay_armed = false;
+    data->state.axis_snap_auto_axis = -1;
+#endif
+
+    // Initialize code mapping settings from DT defaults
+    data->current.xy_to_scroll_enabled = cfg->initial_xy_to_scroll_enabled;
+    data->current.xy_swap_enabled = cfg->initial_xy_swap_enabled;
+    data->persistent.xy_to_scroll_enabled = cfg->initial_xy_to_scroll_enabled;
+    data->persistent.xy_swap_enabled = cfg->initial_xy_swap_enabled;
+    // Initialize axis invert settings from DT defaults
+    data->current.x_invert = cfg->initial_x_invert;
+    data->current.y_invert = cfg->initial_y_invert;
+    data->persistent.x_invert = cfg->initial_x_invert;
+    data->persistent.y_invert = cfg->initial_y_invert;
+
+    // Initialize acceleration settings from DT defaults
+    init_accel_settings(cfg, data);
+    // Initialize jitter filter and scroll settings from DT defaults
+    init_filter_settings(cfg, data);
+    init_scroll_settings(cfg, data);
+
+#if RUNTIME_RELAY_CENTRAL
+    if (cfg->relay_behavior &&
+        strlen(cfg->relay_behavior->name) > RUNTIME_RELAY_BEHAVIOR_NAME_MAX_LEN) {
+        LOG_ERR("Relay behavior name '%s' of '%s' is longer than %d characters",
+                cfg->relay_behavior->name, cfg->name, RUNTIME_RELAY_BEHAVIOR_NAME_MAX_LEN);
+    }
+#endif
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Runtime processor '%s' initialized", cfg->name);
+
+    return 0;
+}
+
+// Helper to raise state changed event
+static void raise_state_changed_event(const struct device *dev) {
+    const char *name;
+    struct zmk_input_processor_runtime_config config;
+
+    int ret = zmk_input_processor_runtime_get_config(dev, &name, &config);
+    if (ret < 0) {
+        return;
+    }
+
+    int id = zmk_input_processor_runtime_get_id(dev);
+    if (id < 0) {
+        return;
+    }
+
+    raise_zmk_input_processor_state_changed((struct zmk_input_processor_state_changed){
+        .id = (uint8_t)id, .name = name, .config = config});
+}
+
+// Public API for runtime configuration
+int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t multiplier,
+                                            uint32_t divisor, bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    if (multiplier > 0) {
+        data->current.scale_multiplier = multiplier;
+        if (persistent) {
+            data->persistent.scale_multiplier = multiplier;
+        }
+    }
+    if (divisor > 0) {
+        data->current.scale_divisor = divisor;
+        if (persistent) {
+            data->persistent.scale_divisor = divisor;
+        }
+    }
+
+    update_processor_plan(dev);
+
+    LOG_INF("Set scaling to %d/%d%s", data->current.scale_multiplier, data->current.scale_divisor,
+            persistent ? " (persistent)" : " (temporary)");
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        // Raise event for persistent changes
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
+int zmk_input_processor_runtime_set_rotation(const struct device *dev, int32_t degrees,
+                                             bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    if (!RUNTIME_HAS_ROTATION && degrees % 360 != 0) {
+        return -ENOTSUP;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.rotation_degrees = degrees;
+    if (persistent) {
+        data->persistent.rotation_degrees = degrees;
+    }
+
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Set rotation to %d degrees%s", degrees, persistent ? " (persistent)" : " (temporary)");
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        // Raise event for persistent changes
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
+static int validate_config(const struct zmk_input_processor_runtime_config *config,
+                           uint32_t field_mask) {
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_SCALE_MULTIPLIER) &&
+        config->scale_multiplier == 0) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_SCALE_DIVISOR) && config->scale_divisor == 0) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE) &&
+        config->axis_snap_mode > ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_AUTO) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE) &&
+        config->accel_curve > ZMK_INPUT_PROCESSOR_ACCEL_CURVE_LUT) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_SPEED_MAX) && config->accel_speed_max == 0) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT) &&
+        config->accel_lut_len > ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT) &&
+        config->filter_iir_shift > ZMK_INPUT_PROCESSOR_FILTER_IIR_SHIFT_MAX) {
+        return -EINVAL;
+    }
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_HIRES) &&
+        config->scroll_hires_multiplier > ZMK_INPUT_PROCESSOR_SCROLL_HIRES_MAX) {
+        return -EINVAL;
+    }
+    // Hysteresis needs the release threshold at or under the activation one
+    if ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD) &&
+        (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD) &&
+        config->temp_layer_release_threshold > config->temp_layer_activation_threshold) {
+        return -EINVAL;
+    }
+
+    // Stages that are not compiled in cannot be enabled
+    if (!RUNTIME_HAS_ROTATION && (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ROTATION_DEGREES) &&
+        config->rotation_degrees % 360 != 0) {
+        return -ENOTSUP;
+    }
+    if (!RUNTIME_HAS_TEMP_LAYER && (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED) &&
+        config->temp_layer_enabled) {
+        return -ENOTSUP;
+    }
+    if (!RUNTIME_HAS_AXIS_SNAP && (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE) &&
+        config->axis_snap_mode != ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE) {
+        return -ENOTSUP;
+    }
+    if (!RUNTIME_HAS_ACCEL && (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE) &&
+        config->accel_curve != ZMK_INPUT_PROCESSOR_ACCEL_CURVE_NONE) {
+        return -ENOTSUP;
+    }
+    if (!RUNTIME_HAS_FILTER &&
+        (((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_FILTER_DEAD_ZONE) &&
+          config->filter_dead_zone != 0) ||
+         ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT) &&
+          config->filter_iir_shift != 0))) {
+        return -ENOTSUP;
+    }
+    if (!RUNTIME_HAS_SCROLL && (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_DIVISOR) &&
+        config->scroll_scale_divisor != 0) {
+        return -ENOTSUP;
+    }
+    return 0;
+}
+
+// Copy one selected field of config into dst
+#define OVERLAY_CONFIG_FIELD(bit, field)                                                           \
+    if (field_mask & (bit)) {                                                                      \
+        dst->field = config->field;                                                                \
+    }
+
+// Copy the selected fields of config into dst
+static void overlay_config_fields(struct zmk_input_processor_runtime_config *dst,
+                                  const struct zmk_input_processor_runtime_config *config,
+                                  uint32_t field_mask) {
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_SCALE_MULTIPLIER, scale_multiplier);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_SCALE_DIVISOR, scale_divisor);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_ROTATION_DEGREES, rotation_degrees);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED, temp_layer_enabled);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER, temp_layer_layer);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_DELAY,
+                         temp_layer_activation_delay_ms);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_DEACTIVATION_DELAY,
+                         temp_layer_deactivation_delay_ms);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD,
+                         temp_layer_activation_threshold);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD,
+                         temp_layer_release_threshold);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_MOTION_WINDOW,
+                         temp_layer_motion_window_ms);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_ACTIVE_LAYERS, active_layers);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE, axis_snap_mode);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_THRESHOLD, axis_snap_threshold);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_TIMEOUT, axis_snap_timeout_ms);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_XY_TO_SCROLL_ENABLED, xy_to_scroll_enabled);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_XY_SWAP_ENABLED, xy_swap_enabled);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_X_INVERT, x_invert);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_Y_INVERT, y_invert);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE, accel_curve);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_SPEED_MAX, accel_speed_max);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_GAIN_MAX, accel_gain_max);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_EXPONENT, accel_exponent);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_FILTER_DEAD_ZONE, filter_dead_zone);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT, filter_iir_shift);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IDLE, filter_idle_ms);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_MULTIPLIER,
+                         scroll_scale_multiplier);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_DIVISOR, scroll_scale_divisor);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_HIRES, scroll_hires_multiplier);
+    OVERLAY_CONFIG_FIELD(ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SNAP, scroll_snap);
+
+    if (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT) {
+        dst->accel_lut_len = config->accel_lut_len;
+        memset(dst->accel_lut, 0, sizeof(dst->accel_lut));
+        memcpy(dst->accel_lut, config->accel_lut,
+               config->accel_lut_len * sizeof(dst->accel_lut[0]));
+    }
+}
+
+#undef OVERLAY_CONFIG_FIELD
+
+// Copy the selected fields into the current (and persistent) values and
+// refresh the state derived from them. Does not publish a plan. Caller holds
+// runtime_plan_mutex.
+static void apply_config_fields(const struct device *dev,
+                                const struct zmk_input_processor_runtime_config *config,
+                                uint32_t field_mask, bool persistent) {
+    struct runtime_processor_data *data = dev->data;
+
+    bool keep_map_stale = ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED) &&
+                           data->current.temp_layer_enabled != config->temp_layer_enabled) ||
+                          ((field_mask & ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER) &&
+                           data->current.temp_layer_layer != config->temp_layer_layer);
+
+    overlay_config_fields(&data->current, config, field_mask);
+    if (persistent) {
+        overlay_config_fields(&data->persistent, config, field_mask);
+    }
+
+    if (field_mask & ZMK_INPUT_PROCESSOR_CONFIG_ACTIVE_LAYERS) {
+        update_active_for_layers(data);
+    }
+    // The keep map walks the whole keymap, so only rebuild it when needed
+    if (keep_map_stale) {
+        update_temp_layer_keep_map(dev);
+    }
+}
+
+int zmk_input_processor_runtime_set_config(const struct device *dev,
+                                           const struct zmk_input_processor_runtime_config *config,
+                                           uint32_t field_mask, bool persistent) {
+    if (!dev || !config) {
+        return -EINVAL;
+    }
+
+    int ret = validate_config(config, field_mask);
+    if (ret < 0) {
+        return ret;
+    }
+
+    // Fields that must agree with each other are checked on the values they
+    // end up with, against the ones not being set as well. The values are not
+    // written by anyone else between the check and the new plan.
+    struct runtime_processor_data *data = dev->data;
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    struct zmk_input_processor_runtime_config merged = data->current;
+    overlay_config_fields(&merged, config, field_mask);
+    ret = validate_config(&merged, ZMK_INPUT_PROCESSOR_CONFIG_ALL);
+    if (ret == 0 && persistent) {
+        merged = data->persistent;
+        overlay_config_fields(&merged, config, field_mask);
+        ret = validate_config(&merged, ZMK_INPUT_PROCESSOR_CONFIG_ALL);
+    }
+    if (ret < 0) {
+        k_mutex_unlock(&runtime_plan_mutex);
+        return ret;
+    }
+
+    apply_config_fields(dev, config, field_mask, persistent);
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Set config fields 0x%08x%s", field_mask,
+            persistent ? " (persistent)" : " (temporary)");
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
+#if RUNTIME_PROFILE_COUNT > 0
+// Store a profile and precompile its plan
+static void store_profile(const struct device *dev, uint8_t index, const char *name,
+                          const struct zmk_input_processor_runtime_config *config) {
+    struct runtime_processor_data *data = dev->data;
+    struct runtime_processor_profile *profile = &data->profiles[index];
+    int slot = RUNTIME_PROFILE_PLAN_SLOT(index);
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+
+    // Move the event path off the profile's plan before rebuilding it
+    if (atomic_get(&data->state.active_plan) == slot) {
+        publish_plan(data, &data->plans[slot]);
+    }
+    wait_plan_readers(data, slot);
+    build_processor_plan(dev->config, config, &data->plans[slot]);
+
+    profile->valid = true;
+    strncpy(profile->name, name, sizeof(profile->name) - 1);
+    profile->name[sizeof(profile->name) - 1] = '\0';
+    profile->config = *config;
+    if (data->active_profile == index) {
+        data->active_profile = -1;
+    }
+
+    k_mutex_unlock(&runtime_plan_mutex);
+}
+#endif
+
+int zmk_input_processor_runtime_save_profile(
+    const struct device *dev, uint8_t index, const char *name,
+    const struct zmk_input_processor_runtime_config *config) {
+#if RUNTIME_PROFILE_COUNT > 0
+    if (!dev || !name || index >= RUNTIME_PROFILE_COUNT) {
+        return -EINVAL;
+    }
+
+    if (!config) {
+        const struct runtime_processor_data *data = dev->data;
+        config = &data->persistent;
+    }
+
+    int ret = validate_config(config, ZMK_INPUT_PROCESSOR_CONFIG_ALL);
+    if (ret < 0) {
+        return ret;
+    }
 
-    // Initialize code mapping settings from DT defaults
-    data->xy_to_scroll_enabled = cfg->initial_xy_to_scroll_enabled;
-    data->xy_swap_enabled = cfg->initial_xy_swap_enabled;
-    data->persistent_xy_to_scroll_enabled = cfg->initial_xy_to_scroll_enabled;
-    data->persistent_xy_swap_enabled = cfg->initial_xy_swap_enabled;
-    // Initialize axis invert settings from DT defaults
-    data->x_invert = cfg->initial_x_invert;
-    data->y_invert = cfg->initial_y_invert;
-    data->persistent_x_invert = cfg->initial_x_invert;
-    data->persistent_y_invert = cfg->initial_y_invert;
+    store_profile(dev, index, name, config);
 
-    update_rotation_values(data);
+    LOG_INF("Saved profile %d: %s", index, name);
 
-    data->dev = dev;
 #if IS_ENABLED(CONFIG_SETTINGS)
-    k_work_init_delayable(&data->save_work, save_processor_settings_work_handler);
+    ret = schedule_save_profile(dev, index);
 #endif
-    // Initialize temp-layer work queues
-    k_work_init_delayable(&data->temp_layer_activation_work, temp_layer_activation_work_handler);
-    k_work_init_delayable(&data->temp_layer_deactivation_work,
-                          temp_layer_deactivation_work_handler);
-
-    LOG_INF("Runtime processor '%s' initialized", cfg->name);
 
-    return 0;
+    return ret;
+#else
+    return -ENOTSUP;
+#endif
 }
 
-// Helper to raise state changed event
-static void raise_state_changed_event(const struct device *dev) {
-    const char *name;
-    struct zmk_input_processor_runtime_config config;
+int zmk_input_processor_runtime_delete_profile(const struct device *dev, uint8_t index) {
+#if RUNTIME_PROFILE_COUNT > 0
+    if (!dev || index >= RUNTIME_PROFILE_COUNT) {
+        return -EINVAL;
+    }
 
-    int ret = zmk_input_processor_runtime_get_config(dev, &name, &config);
-    if (ret < 0) {
-        return;
+    struct runtime_processor_data *data = dev->data;
+    struct runtime_processor_profile *profile = &data->profiles[index];
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    profile->valid = false;
+    memset(profile->name, 0, sizeof(profile->name));
+    if (data->active_profile == index) {
+        data->active_profile = -1;
     }
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Deleted profile %d", index);
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    ret = schedule_save_profile(dev, index);
+#endif
 
-    raise_zmk_input_processor_state_changed(
-        (struct zmk_input_processor_state_changed){.name = name, .config = config});
+    return ret;
+#else
+    return -ENOTSUP;
+#endif
 }
 
-// Public API for runtime configuration
-int zmk_input_processor_runtime_set_scaling(const struct device *dev, uint32_t multiplier,
-                                            uint32_t divisor, bool persistent) {
-    if (!dev) {
+int zmk_input_processor_runtime_select_profile(const struct device *dev, uint8_t index,
+                                               bool persistent) {
+#if RUNTIME_PROFILE_COUNT > 0
+    if (!dev || index >= RUNTIME_PROFILE_COUNT) {
         return -EINVAL;
     }
 
     struct runtime_processor_data *data = dev->data;
-
-    if (multiplier > 0) {
-        data->scale_multiplier = multiplier;
-        if (persistent) {
-            data->persistent_scale_multiplier = multiplier;
-        }
-    }
-    if (divisor > 0) {
-        data->scale_divisor = divisor;
-        if (persistent) {
-            data->persistent_scale_divisor = divisor;
-        }
+    struct runtime_processor_profile *profile = &data->profiles[index];
+
+    // Held across the copy and the swap, so that the profile is not saved or
+    // deleted in between and the values always match the plan
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    if (!profile->valid) {
+        k_mutex_unlock(&runtime_plan_mutex);
+        return -ENOENT;
     }
 
-    LOG_INF("Set scaling to %d/%d%s", data->scale_multiplier, data->scale_divisor,
+    // Keep the config values in sync with the plan, then swap the plan in
+    apply_config_fields(dev, &profile->config, ZMK_INPUT_PROCESSOR_CONFIG_ALL, persistent);
+
+    int slot = RUNTIME_PROFILE_PLAN_SLOT(index);
+    if (atomic_get(&data->state.active_plan) != slot) {
+        update_accel_gains(data, &profile->config, &data->plans[slot]);
+        activate_plan_slot(data, slot);
+    }
+    data->active_profile = index;
+    LOG_INF("Selected profile %d: %s%s", index, profile->name,
             persistent ? " (persistent)" : " (temporary)");
+    k_mutex_unlock(&runtime_plan_mutex);
+    queue_relay_config(dev);
 
     int ret = 0;
 #if IS_ENABLED(CONFIG_SETTINGS)
     if (persistent) {
         ret = schedule_save_processor_settings(dev);
-        // Raise event for persistent changes
         raise_state_changed_event(dev);
     }
 #endif
 
     return ret;
+#else
+    return -ENOTSUP;
+#endif
 }
 
-int zmk_input_processor_runtime_set_rotation(const struct device *dev, int32_t degrees,
-                                             bool persistent) {
-    if (!dev) {
+int zmk_input_processor_runtime_get_profile(const struct device *dev, uint8_t index,
+                                            const char **name,
+                                            struct zmk_input_processor_runtime_config *config) {
+#if RUNTIME_PROFILE_COUNT > 0
+    if (!dev || index >= RUNTIME_PROFILE_COUNT) {
         return -EINVAL;
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->rotation_degrees = degrees;
-    if (persistent) {
-        data->persistent_rotation_degrees = degrees;
+    const struct runtime_processor_profile *profile = &data->profiles[index];
+    if (!profile->valid) {
+        return -ENOENT;
     }
-    update_rotation_values(data);
 
-    LOG_INF("Set rotation to %d degrees%s", degrees, persistent ? " (persistent)" : " (temporary)");
-
-    int ret = 0;
-#if IS_ENABLED(CONFIG_SETTINGS)
-    if (persistent) {
-        ret = schedule_save_processor_settings(dev);
-        // Raise event for persistent changes
-        raise_state_changed_event(dev);
+    if (name) {
+        *name = profile->name;
+    }
+    if (config) {
+        *config = profile->config;
     }
+    return 0;
+#else
+    return -ENOTSUP;
 #endif
+}
 
-    return ret;
+int zmk_input_processor_runtime_get_active_profile(const struct device *dev) {
+#if RUNTIME_PROFILE_COUNT > 0
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    const struct runtime_processor_data *data = dev->data;
+    return data->active_profile;
+#else
+    return -1;
+#endif
 }
 
 int zmk_input_processor_runtime_reset(const struct device *dev) {
@@ -766,43 +3412,62 @@ int zmk_input_processor_runtime_reset(const struct device *dev) {
     const struct runtime_processor_config *cfg = dev->config;
     struct runtime_processor_data *data = dev->data;
 
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+
     // Reset to initial values
-    data->scale_multiplier = cfg->initial_scale_multiplier;
-    data->scale_divisor = cfg->initial_scale_divisor;
-    data->rotation_degrees = cfg->initial_rotation_degrees;
+    data->current.scale_multiplier = cfg->initial_scale_multiplier;
+    data->current.scale_divisor = cfg->initial_scale_divisor;
+    data->current.rotation_degrees = cfg->initial_rotation_degrees;
 
-    data->persistent_scale_multiplier = cfg->initial_scale_multiplier;
-    data->persistent_scale_divisor = cfg->initial_scale_divisor;
-    data->persistent_rotation_degrees = cfg->initial_rotation_degrees;
+    data->persistent.scale_multiplier = cfg->initial_scale_multiplier;
+    data->persistent.scale_divisor = cfg->initial_scale_divisor;
+    data->persistent.rotation_degrees = cfg->initial_rotation_degrees;
 
     // Reset temp-layer settings to defaults
-    data->temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->temp_layer_deactivation_delay_ms = cfg->initial_temp_layer_deactivation_delay_ms;
-    data->persistent_temp_layer_enabled = cfg->initial_temp_layer_enabled;
-    data->persistent_temp_layer_layer = cfg->initial_temp_layer_layer;
-    data->persistent_temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
-    data->persistent_temp_layer_deactivation_delay_ms =
+    data->current.temp_layer_enabled = cfg->initial_temp_layer_enabled;
+    data->current.temp_layer_layer = cfg->initial_temp_layer_layer;
+    data->current.temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
+    data->current.temp_layer_deactivation_delay_ms = cfg->initial_temp_layer_deactivation_delay_ms;
+    data->persistent.temp_layer_enabled = cfg->initial_temp_layer_enabled;
+    data->persistent.temp_layer_layer = cfg->initial_temp_layer_layer;
+    data->persistent.temp_layer_activation_delay_ms = cfg->initial_temp_layer_activation_delay_ms;
+    data->persistent.temp_layer_deactivation_delay_ms =
         cfg->initial_temp_layer_deactivation_delay_ms;
+    data->current.temp_layer_activation_threshold = cfg->initial_temp_layer_activation_threshold;
+    data->current.temp_layer_release_threshold = cfg->initial_temp_layer_release_threshold;
+    data->current.temp_layer_motion_window_ms = cfg->initial_temp_layer_motion_window_ms;
+    data->persistent.temp_layer_activation_threshold = cfg->initial_temp_layer_activation_threshold;
+    data->persistent.temp_layer_release_threshold = cfg->initial_temp_layer_release_threshold;
+    data->persistent.temp_layer_motion_window_ms = cfg->initial_temp_layer_motion_window_ms;
+
+    update_temp_layer_keep_map(dev);
 
     // Reset active layers to defaults
-    data->active_layers = cfg->initial_active_layers;
-    data->persistent_active_layers = cfg->initial_active_layers;
+    data->current.active_layers = cfg->initial_active_layers;
+    data->persistent.active_layers = cfg->initial_active_layers;
+    update_active_for_layers(data);
 
+#if RUNTIME_HAS_TEMP_LAYER
     // Deactivate temp-layer layer if active
-    if (data->temp_layer_layer_active) {
-        zmk_keymap_layer_deactivate(data->temp_layer_layer);
-        data->temp_layer_layer_active = false;
+    if (data->state.temp_layer_layer_active) {
+        zmk_keymap_layer_deactivate(data->current.temp_layer_layer);
+        data->state.temp_layer_layer_active = false;
     }
+#endif
 
     // Reset axis invert settings to defaults
-    data->x_invert = cfg->initial_x_invert;
-    data->y_invert = cfg->initial_y_invert;
-    data->persistent_x_invert = cfg->initial_x_invert;
-    data->persistent_y_invert = cfg->initial_y_invert;
+    data->current.x_invert = cfg->initial_x_invert;
+    data->current.y_invert = cfg->initial_y_invert;
+    data->persistent.x_invert = cfg->initial_x_invert;
+    data->persistent.y_invert = cfg->initial_y_invert;
+
+    // Reset acceleration, jitter filter and scroll settings to defaults
+    init_accel_settings(cfg, data);
+    init_filter_settings(cfg, data);
+    init_scroll_settings(cfg, data);
 
-    update_rotation_values(data);
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
 
     LOG_INF("Reset processor '%s' to defaults", cfg->name);
 
@@ -823,23 +3488,11 @@ void zmk_input_processor_runtime_restore_persistent(const struct device *dev) {
 
     struct runtime_processor_data *data = dev->data;
 
-    // Restore persistent values (used after temporary behavior changes)
-    data->scale_multiplier = data->persistent_scale_multiplier;
-    data->scale_divisor = data->persistent_scale_divisor;
-    data->rotation_degrees = data->persistent_rotation_degrees;
-    update_rotation_values(data);
-
-    // Restore axis snap settings
-    data->axis_snap_mode = data->persistent_axis_snap_mode;
-    data->axis_snap_threshold = data->persistent_axis_snap_threshold;
-    data->axis_snap_timeout_ms = data->persistent_axis_snap_timeout_ms;
-    // Reset snap state when restoring
-    data->axis_snap_cross_axis_accum = 0;
-    data->axis_snap_last_decay_timestamp = 0;
-
-    // Restore axis invert settings
-    data->x_invert = data->persistent_x_invert;
-    data->y_invert = data->persistent_y_invert;
+    // Restore persistent values (used after temporary behavior and profile changes)
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    apply_config_fields(dev, &data->persistent, ZMK_INPUT_PROCESSOR_CONFIG_ALL, false);
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
 
     LOG_DBG("Restored persistent values");
 }
@@ -857,36 +3510,213 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
         *name = cfg->name;
     }
     if (config) {
-        config->scale_multiplier = data->persistent_scale_multiplier;
-        config->scale_divisor = data->persistent_scale_divisor;
-        config->rotation_degrees = data->persistent_rotation_degrees;
-        config->temp_layer_enabled = data->persistent_temp_layer_enabled;
-        config->temp_layer_layer = data->persistent_temp_layer_layer;
-        config->temp_layer_activation_delay_ms = data->persistent_temp_layer_activation_delay_ms;
-        config->temp_layer_deactivation_delay_ms =
-            data->persistent_temp_layer_deactivation_delay_ms;
-        config->active_layers = data->persistent_active_layers;
-        config->axis_snap_mode = data->persistent_axis_snap_mode;
-        config->axis_snap_threshold = data->persistent_axis_snap_threshold;
-        config->axis_snap_timeout_ms = data->persistent_axis_snap_timeout_ms;
-        config->xy_to_scroll_enabled = data->persistent_xy_to_scroll_enabled;
-        config->xy_swap_enabled = data->persistent_xy_swap_enabled;
-        config->x_invert = data->persistent_x_invert;
-        config->y_invert = data->persistent_y_invert;
+        k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+        *config = data->persistent;
+        k_mutex_unlock(&runtime_plan_mutex);
+    }
+
+    return 0;
+}
+
+int zmk_input_processor_runtime_get_stats(const struct device *dev,
+                                          struct zmk_input_processor_runtime_stats *stats) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+    if (!dev || !stats) {
+        return -EINVAL;
+    }
+
+    const struct runtime_processor_data *data = dev->data;
+    *stats = data->stats;
+    return 0;
+#else
+    ARG_UNUSED(dev);
+    ARG_UNUSED(stats);
+    return -ENOTSUP;
+#endif
+}
+
+int zmk_input_processor_runtime_reset_stats(const struct device *dev) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS)
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+    memset(&data->stats, 0, sizeof(data->stats));
+    LOG_INF("Statistics reset");
+    return 0;
+#else
+    ARG_UNUSED(dev);
+    return -ENOTSUP;
+#endif
+}
+
+int zmk_input_processor_runtime_set_telemetry(const struct device *dev, bool enabled) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+    if (enabled) {
+        atomic_set(&data->telemetry.enabled_since, k_uptime_get_32());
+    }
+    atomic_set(&data->telemetry.enabled, enabled);
+    LOG_INF("Telemetry %s", enabled ? "enabled" : "disabled");
+    return 0;
+#else
+    ARG_UNUSED(dev);
+    ARG_UNUSED(enabled);
+    return -ENOTSUP;
+#endif
+}
+
+bool zmk_input_processor_runtime_get_telemetry_enabled(const struct device *dev) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    if (!dev) {
+        return false;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+    return atomic_get(&data->telemetry.enabled) != 0;
+#else
+    ARG_UNUSED(dev);
+    return false;
+#endif
+}
+
+int zmk_input_processor_runtime_read_telemetry(
+    const struct device *dev, struct zmk_input_processor_telemetry_sample *samples, size_t max) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    if (!dev || (!samples && max > 0)) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+    struct runtime_processor_telemetry *t = &data->telemetry;
+    atomic_val_t head = atomic_get(&t->head);
+    atomic_val_t tail = atomic_get(&t->tail);
+
+    if (!atomic_get(&t->enabled)) {
+        atomic_set(&t->tail, head);
+        return 0;
+    }
+
+    runtime_tick_t since = atomic_get(&t->enabled_since);
+    size_t count = 0;
+    while (tail != head && count < max) {
+        const struct zmk_input_processor_telemetry_sample *sample =
+            &t->ring[tail & (RUNTIME_TELEMETRY_RING_LEN - 1)];
+        if ((int32_t)(sample->time_ms - since) >= 0) {
+            samples[count++] = *sample;
+        }
+        tail++;
+    }
+    // Give the slots back only once they have been copied
+    atomic_set(&t->tail, tail);
+    return count;
+#else
+    ARG_UNUSED(dev);
+    ARG_UNUSED(samples);
+    ARG_UNUSED(max);
+    return -ENOTSUP;
+#endif
+}
+
+uint32_t zmk_input_processor_runtime_get_overflow_count(const struct device *dev) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_OVERFLOW_COUNTER)
+    if (!dev) {
+        return 0;
     }
 
+    const struct runtime_processor_data *data = dev->data;
+    return data->state.overflow_count;
+#else
+    ARG_UNUSED(dev);
     return 0;
+#endif
 }
 
+#define RUNTIME_CODE_BIT(node_id, prop, idx) BIT64(DT_PROP_BY_IDX(node_id, prop, idx))
+#define RUNTIME_CODE_MASK(n, prop) (DT_INST_FOREACH_PROP_ELEM_SEP(n, prop, RUNTIME_CODE_BIT, (|)))
+#define RUNTIME_CODE_ASSERT(node_id, prop, idx)                                                    \
+    BUILD_ASSERT(DT_PROP_BY_IDX(node_id, prop, idx) < RUNTIME_CODE_MASK_BITS,                      \
+                 "x-codes and y-codes must be below " STRINGIFY(RUNTIME_CODE_MASK_BITS));
+
+// Source sub-configs default to no correction when their property is left out
+#define RUNTIME_SOURCE_PROP(node_id, prop, idx, default_value)                                     \
+    COND_CODE_1(DT_NODE_HAS_PROP(node_id, prop), (DT_PROP_BY_IDX(node_id, prop, idx)),             \
+                (default_value))
+#define RUNTIME_SOURCE_DEVICE(node_id, prop, idx)                                                  \
+    DEVICE_DT_GET(DT_PHANDLE_BY_IDX(node_id, prop, idx)),
+#define RUNTIME_SOURCE_CONFIG(node_id, prop, idx)                                                  \
+    {                                                                                              \
+        .rotation_degrees =                                                                        \
+            (int32_t)RUNTIME_SOURCE_PROP(node_id, source_rotation_degrees, idx, 0),                \
+        .scale_multiplier = RUNTIME_SOURCE_PROP(node_id, source_scale_multipliers, idx, 1),        \
+        .scale_divisor = RUNTIME_SOURCE_PROP(node_id, source_scale_divisors, idx, 1),              \
+    },
+#define RUNTIME_SOURCE_SCALE_ASSERT(node_id, prop, idx)                                            \
+    BUILD_ASSERT(DT_PROP_BY_IDX(node_id, prop, idx) > 0, #prop " must be positive");
+#define RUNTIME_SOURCE_LEN_ASSERT(n, prop)                                                         \
+    BUILD_ASSERT(DT_INST_PROP_LEN_OR(n, prop, RUNTIME_DT_SOURCES(n)) == RUNTIME_DT_SOURCES(n),     \
+                 #prop " needs one value per source-devices entry");
+#define RUNTIME_SOURCES(n)                                                                         \
+    COND_CODE_1(DT_INST_NODE_HAS_PROP(n, source_devices),                                          \
+                (static const struct device *const runtime_source_devices_##n[] = {                \
+                     DT_INST_FOREACH_PROP_ELEM(n, source_devices, RUNTIME_SOURCE_DEVICE)};         \
+                 static const struct runtime_source_config runtime_source_configs_##n[] = {        \
+                     DT_INST_FOREACH_PROP_ELEM(n, source_devices, RUNTIME_SOURCE_CONFIG)};),       \
+                ())                                                                                \
+    RUNTIME_SOURCE_LEN_ASSERT(n, source_rotation_degrees)                                          \
+    RUNTIME_SOURCE_LEN_ASSERT(n, source_scale_multipliers)                                         \
+    RUNTIME_SOURCE_LEN_ASSERT(n, source_scale_divisors)                                            \
+    COND_CODE_1(DT_INST_NODE_HAS_PROP(n, source_scale_multipliers),                                \
+                (DT_INST_FOREACH_PROP_ELEM(n, source_scale_multipliers,                            \
+                                           RUNTIME_SOURCE_SCALE_ASSERT)),                          \
+                ())                                                                                \
+    COND_CODE_1(DT_INST_NODE_HAS_PROP(n, source_scale_divisors),                                   \
+                (DT_INST_FOREACH_PROP_ELEM(n, source_scale_divisors,                               \
+                                           RUNTIME_SOURCE_SCALE_ASSERT)),                          \
+                ())
+#define RUNTIME_SOURCES_CONFIG(n)                                                                  \
+    .source_devices = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, source_devices),                        \
+                                  (runtime_source_devices_##n), (NULL)),                           \
+    .source_configs = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, source_devices),                        \
+                                  (runtime_source_configs_##n), (NULL)),                           \
+    .sources_len = RUNTIME_DT_SOURCES(n),
+
+#if RUNTIME_RELAY_CENTRAL
+#define RUNTIME_RELAY_CONFIG(n)                                                                    \
+    .relay_behavior = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, split_relay),                           \
+                                  (DEVICE_DT_GET(DT_INST_PHANDLE(n, split_relay))), (NULL)),       \
+    .relay_source = DT_INST_PROP_OR(n, split_relay_source, 0),
+// Relayed motion was already coalesced on the peripheral
+#define RUNTIME_COALESCE_INTERVAL(n)                                                               \
+    COND_CODE_1(DT_INST_NODE_HAS_PROP(n, split_relay), (0), (DT_INST_PROP(n, coalesce_interval_ms)))
+#else
+#define RUNTIME_RELAY_CONFIG(n)
+#define RUNTIME_COALESCE_INTERVAL(n) DT_INST_PROP(n, coalesce_interval_ms)
+#endif
+
 #define RUNTIME_PROCESSOR_INST(n)                                                                  \
-    static const uint16_t runtime_x_codes_##n[] = DT_INST_PROP(n, x_codes);                        \
-    static const uint16_t runtime_y_codes_##n[] = DT_INST_PROP(n, y_codes);                        \
-    BUILD_ASSERT(ARRAY_SIZE(runtime_x_codes_##n) == ARRAY_SIZE(runtime_y_codes_##n),               \
+    BUILD_ASSERT(DT_INST_PROP_LEN(n, x_codes) == DT_INST_PROP_LEN(n, y_codes),                     \
                  "X and Y codes need to be the same size");                                        \
+    DT_INST_FOREACH_PROP_ELEM(n, x_codes, RUNTIME_CODE_ASSERT)                                     \
+    DT_INST_FOREACH_PROP_ELEM(n, y_codes, RUNTIME_CODE_ASSERT)                                     \
     COND_CODE_1(DT_INST_NODE_HAS_PROP(n, temp_layer_keep_keycodes),                                \
                 (static const uint32_t runtime_temp_layer_keep_keycodes_##n[] =                    \
                      DT_INST_PROP(n, temp_layer_keep_keycodes);),                                  \
                 ())                                                                                \
+    COND_CODE_1(DT_INST_NODE_HAS_PROP(n, accel_lut),                                               \
+                (static const uint16_t runtime_accel_lut_##n[] = DT_INST_PROP(n, accel_lut);),     \
+                ())                                                                                \
+    BUILD_ASSERT(DT_INST_PROP_LEN_OR(n, accel_lut, 0) <= ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS, \
+                 "accel-lut has too many points");                                                 \
+    BUILD_ASSERT(DT_INST_PROP_OR(n, temp_layer_release_threshold, 0) <=                            \
+                     DT_INST_PROP_OR(n, temp_layer_activation_threshold, 0),                       \
+                 "temp-layer-release-threshold exceeds temp-layer-activation-threshold");          \
+    RUNTIME_SOURCES(n)                                                                             \
     BUILD_ASSERT(sizeof(DT_INST_PROP(n, processor_label)) <=                                       \
                      CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN,                              \
                  "processor_label " DT_INST_PROP(                                                  \
@@ -895,14 +3725,16 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
                                              CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN));    \
     static const struct runtime_processor_config runtime_config_##n = {                            \
         .name = DT_INST_PROP(n, processor_label),                                                  \
+        .id = n,                                                                                   \
         .type = DT_INST_PROP_OR(n, type, INPUT_EV_REL),                                            \
-        .x_codes_len = DT_INST_PROP_LEN(n, x_codes),                                               \
-        .y_codes_len = DT_INST_PROP_LEN(n, y_codes),                                               \
-        .x_codes = runtime_x_codes_##n,                                                            \
-        .y_codes = runtime_y_codes_##n,                                                            \
+        .code_mask = RUNTIME_CODE_MASK(n, x_codes) | RUNTIME_CODE_MASK(n, y_codes),                \
+        .x_code_mask = RUNTIME_CODE_MASK(n, x_codes),                                              \
         .initial_scale_multiplier = DT_INST_PROP_OR(n, scale_multiplier, 1),                       \
         .initial_scale_divisor = DT_INST_PROP_OR(n, scale_divisor, 1),                             \
         .initial_rotation_degrees = DT_INST_PROP_OR(n, rotation_degrees, 0),                       \
+        .rotation_frame_sync = DT_INST_PROP(n, rotation_frame_sync),                               \
+        RUNTIME_SOURCES_CONFIG(n)                                                                  \
+        .coalesce_interval_ms = RUNTIME_COALESCE_INTERVAL(n),                                      \
         .temp_layer_transparent_behavior = COND_CODE_1(                                            \
             DT_INST_NODE_HAS_PROP(n, temp_layer_transparent_behavior),                             \
             (DEVICE_DT_GET(DT_INST_PHANDLE(n, temp_layer_transparent_behavior))), (NULL)),         \
@@ -921,6 +3753,11 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
             DT_INST_PROP_OR(n, temp_layer_activation_delay_ms, 100),                               \
         .initial_temp_layer_deactivation_delay_ms =                                                \
             DT_INST_PROP_OR(n, temp_layer_deactivation_delay_ms, 500),                             \
+        .initial_temp_layer_activation_threshold =                                                 \
+            DT_INST_PROP_OR(n, temp_layer_activation_threshold, 0),                                \
+        .initial_temp_layer_release_threshold =                                                    \
+            DT_INST_PROP_OR(n, temp_layer_release_threshold, 0),                                   \
+        .initial_temp_layer_motion_window_ms = DT_INST_PROP_OR(n, temp_layer_motion_window_ms, 0), \
         .initial_active_layers = DT_INST_PROP_OR(n, active_layers, 0),                             \
         .initial_axis_snap_mode = DT_INST_PROP_OR(n, axis_snap_mode, 0),                           \
         .initial_axis_snap_threshold = DT_INST_PROP_OR(n, axis_snap_threshold, 100),               \
@@ -929,6 +3766,21 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
         .initial_xy_swap_enabled = DT_INST_PROP(n, xy_swap_enabled),                               \
         .initial_x_invert = DT_INST_PROP(n, x_invert),                                             \
         .initial_y_invert = DT_INST_PROP(n, y_invert),                                             \
+        .initial_accel_curve = DT_INST_PROP_OR(n, accel_curve, 0),                                 \
+        .initial_accel_speed_max = DT_INST_PROP_OR(n, accel_speed_max, 2000),                      \
+        .initial_accel_gain_max = DT_INST_PROP_OR(n, accel_gain_max, 200),                         \
+        .initial_accel_exponent = DT_INST_PROP_OR(n, accel_exponent, 200),                         \
+        .initial_accel_lut_len = DT_INST_PROP_LEN_OR(n, accel_lut, 0),                             \
+        .initial_accel_lut = COND_CODE_1(DT_INST_NODE_HAS_PROP(n, accel_lut),                      \
+                                         (runtime_accel_lut_##n), (NULL)),                         \
+        .initial_filter_dead_zone = DT_INST_PROP_OR(n, filter_dead_zone, 0),                       \
+        .initial_filter_idle_ms = DT_INST_PROP_OR(n, filter_idle_ms, 0),                           \
+        .initial_filter_iir_shift = DT_INST_PROP_OR(n, filter_iir_shift, 0),                       \
+        .initial_scroll_scale_multiplier = DT_INST_PROP_OR(n, scroll_scale_multiplier, 1),         \
+        .initial_scroll_scale_divisor = DT_INST_PROP_OR(n, scroll_scale_divisor, 0),               \
+        .initial_scroll_hires_multiplier = DT_INST_PROP_OR(n, scroll_hires_multiplier, 0),         \
+        .initial_scroll_snap = DT_INST_PROP_OR(n, scroll_snap, false),                             \
+        RUNTIME_RELAY_CONFIG(n)                                                                    \
     };                                                                                             \
     static struct runtime_processor_data runtime_data_##n;                                         \
     DEVICE_DT_INST_DEFINE(n, &runtime_processor_init, NULL, &runtime_data_##n,                     \
@@ -938,23 +3790,45 @@ int zmk_input_processor_runtime_get_config(const struct device *dev, const char
 DT_INST_FOREACH_STATUS_OKAY(RUNTIME_PROCESSOR_INST)
 
 #if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
-#define DEVICE_ADDR(idx) DEVICE_DT_GET(DT_DRV_INST(idx)),
+// Okay instances are numbered 0..N-1, so the instance number is the processor ID
+#define RUNTIME_PROCESSOR_ENTRY(n)                                                                 \
+    {                                                                                              \
+        .dev = DEVICE_DT_GET(DT_DRV_INST(n)),                                                      \
+        .name = DT_INST_PROP(n, processor_label),                                                  \
+        .config = &runtime_data_##n.persistent,                                                    \
+    },
 
-static struct device *runtime_processors[] = {DT_INST_FOREACH_STATUS_OKAY(DEVICE_ADDR)};
+static const struct zmk_input_processor_runtime_entry runtime_processors[] = {
+    DT_INST_FOREACH_STATUS_OKAY(RUNTIME_PROCESSOR_ENTRY)};
 
-static const size_t runtime_processors_count = sizeof(runtime_processors) / sizeof(struct device *);
+static const size_t runtime_processors_count = ARRAY_SIZE(runtime_processors);
 
 #else
 
-static struct device *runtime_processors[] = {};
+static const struct zmk_input_processor_runtime_entry runtime_processors[] = {};
 static const size_t runtime_processors_count = 0;
 
 #endif
 
+BUILD_ASSERT(ARRAY_SIZE(runtime_processors) <= UINT8_MAX, "Too many runtime input processors");
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SIZE_REPORT)
+// Layout sizes as absolute symbols, printed after linking by cmake/size_report.cmake. The
+// function is never called; it only carries the symbol definitions into the image.
+static void __used runtime_processor_size_symbols(void) {
+    GEN_ABSOLUTE_SYM(__rip_size_data, sizeof(struct runtime_processor_data));
+    GEN_ABSOLUTE_SYM(__rip_size_state, sizeof(struct runtime_processor_state));
+    GEN_ABSOLUTE_SYM(__rip_size_plan, sizeof(struct runtime_processor_plan));
+    GEN_ABSOLUTE_SYM(__rip_size_config, sizeof(struct zmk_input_processor_runtime_config));
+    GEN_ABSOLUTE_SYM(__rip_plan_slots, RUNTIME_PLAN_SLOTS);
+    GEN_ABSOLUTE_SYM(__rip_instances, ARRAY_SIZE(runtime_processors));
+}
+#endif
+
 int zmk_input_processor_runtime_foreach(int (*callback)(const struct device *dev, void *user_data),
                                         void *user_data) {
     for (size_t i = 0; i < runtime_processors_count; i++) {
-        int ret = callback(runtime_processors[i], user_data);
+        int ret = callback(runtime_processors[i].dev, user_data);
         if (ret != 0) {
             return ret;
         }
@@ -963,11 +3837,13 @@ int zmk_input_processor_runtime_foreach(int (*callback)(const struct device *dev
 }
 
 const struct device *zmk_input_processor_runtime_find_by_name(const char *name) {
+    if (!name) {
+        return NULL;
+    }
+
     for (size_t i = 0; i < runtime_processors_count; i++) {
-        const struct device *dev = runtime_processors[i];
-        const struct runtime_processor_config *cfg = dev->config;
-        if (strcmp(cfg->name, name) == 0) {
-            return dev;
+        if (strcmp(runtime_processors[i].name, name) == 0) {
+            return runtime_processors[i].dev;
         }
     }
 
@@ -976,36 +3852,69 @@ const struct device *zmk_input_processor_runtime_find_by_name(const char *name)
 
 const struct device *zmk_input_processor_runtime_find_by_id(uint8_t id) {
     if (id < runtime_processors_count) {
-        return runtime_processors[id];
+        return runtime_processors[id].dev;
+    }
+    return NULL;
+}
+
+const struct zmk_input_processor_runtime_entry *zmk_input_processor_runtime_get_entry(uint8_t id) {
+    if (id < runtime_processors_count) {
+        return &runtime_processors[id];
     }
     return NULL;
 }
 
 int zmk_input_processor_runtime_get_id(const struct device *dev) {
-    for (size_t i = 0; i < runtime_processors_count; i++) {
-        if (runtime_processors[i] == dev) {
-            return i;
-        }
+    if (!dev || dev->api != &runtime_processor_driver_api) {
+        return -1;
     }
-    return -1;
+
+    const struct runtime_processor_config *cfg = dev->config;
+    return cfg->id;
+}
+
+const char *zmk_input_processor_runtime_get_name(const struct device *dev) {
+    int id = zmk_input_processor_runtime_get_id(dev);
+    return id < 0 ? NULL : runtime_processors[id].name;
 }
 
 #if IS_ENABLED(CONFIG_SETTINGS)
 
 static int runtime_processor_settings_load_cb(const char *name, size_t len,
                                               settings_read_cb read_cb, void *cb_arg) {
+    if (strcmp(name, RUNTIME_SETTINGS_AGGREGATE_NAME) == 0) {
+        return load_aggregated_settings_cb(len, read_cb, cb_arg);
+    }
+
+    // "<processor>" or "<processor>/p<index>"
+    const char *next;
+    int name_len = settings_name_next(name, &next);
+
     for (size_t i = 0; i < runtime_processors_count; i++) {
-        const struct device *dev = runtime_processors[i];
+        const struct device *dev = runtime_processors[i].dev;
         const struct runtime_processor_config *cfg = dev->config;
-        if (strcmp(name, cfg->name) == 0) {
+        if (strlen(cfg->name) != name_len || strncmp(name, cfg->name, name_len) != 0) {
+            continue;
+        }
+        if (!next) {
             return load_processor_settings_cb(name, len, read_cb, cb_arg, (void *)dev);
         }
+#if RUNTIME_PROFILE_COUNT > 0
+        if (next[0] == 'p') {
+            unsigned long index = strtoul(&next[1], NULL, 10);
+            if (index < RUNTIME_PROFILE_COUNT) {
+                return load_profile_settings_cb(dev, index, len, read_cb, cb_arg);
+            }
+        }
+#endif
+        break;
     }
     return -ENOENT;
 }
 
 #endif
 
+#if RUNTIME_HAS_TEMP_LAYER
 // Event listener for keycode changes (for timestamp tracking)
 static int keycode_state_changed_listener(const zmk_event_t *eh) {
     struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
@@ -1013,176 +3922,369 @@ static int keycode_state_changed_listener(const zmk_event_t *eh) {
         return ZMK_EV_EVENT_BUBBLE;
     }
 
-    // Only handle key presses
-    if (!ev->state) {
+    // Only handle key presses
+    if (!ev->state) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // Update the last keypress timestamp shared by all processors
+    runtime_last_keypress = k_uptime_get_32();
+    runtime_keypress_seen = true;
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+static bool is_transparent_binding(const struct runtime_processor_config *cfg,
+                                   const struct zmk_behavior_binding *binding) {
+    // Use device pointer comparison if transparent behavior is configured
+    if (cfg->temp_layer_transparent_behavior) {
+        const struct device *binding_dev = zmk_behavior_get_binding(binding->behavior_dev);
+        return binding_dev == cfg->temp_layer_transparent_behavior;
+    }
+    // Fallback to string comparison if not configured
+    return strcmp(binding->behavior_dev, "trans") == 0 ||
+           strcmp(binding->behavior_dev, "TRANS") == 0;
+}
+
+// Whether a press at position keeps the temp-layer layer active under the
+// current layer state
+static bool temp_layer_position_keeps_layer(const struct runtime_processor_config *cfg,
+                                            const struct runtime_processor_data *data,
+                                            uint32_t position) {
+    // If temp-layer layer has non-transparent binding, don't deactivate
+    const struct zmk_behavior_binding *temp_layer_binding =
+        zmk_keymap_get_layer_binding_at_idx(data->current.temp_layer_layer, position);
+    if (temp_layer_binding && !is_transparent_binding(cfg, temp_layer_binding)) {
+        return true;
+    }
+
+    // Temp-layer binding is transparent, check the resolved binding
+    // Find the highest active layer's non-transparent binding
+    const struct zmk_behavior_binding *resolved_binding = NULL;
+
+    for (int layer_idx = ZMK_KEYMAP_LAYERS_LEN - 1; layer_idx >= 0; layer_idx--) {
+        zmk_keymap_layer_id_t layer_id = zmk_keymap_layer_index_to_id(layer_idx);
+
+        if (layer_id == ZMK_KEYMAP_LAYER_ID_INVAL) {
+            continue;
+        }
+
+        if (!zmk_keymap_layer_active(layer_id)) {
+            continue;
+        }
+
+        const struct zmk_behavior_binding *binding =
+            zmk_keymap_get_layer_binding_at_idx(layer_id, position);
+
+        if (binding && !is_transparent_binding(cfg, binding)) {
+            resolved_binding = binding;
+            break;
+        }
+    }
+
+    if (!resolved_binding) {
+        return false;
+    }
+
+    // If resolved binding is &kp with a modifier keycode, don't deactivate
+    bool is_kp = false;
+    if (cfg->temp_layer_kp_behavior) {
+        const struct device *binding_dev = zmk_behavior_get_binding(resolved_binding->behavior_dev);
+        is_kp = (binding_dev == cfg->temp_layer_kp_behavior);
+    } else {
+        is_kp = (strcmp(resolved_binding->behavior_dev, "kp") == 0 ||
+                 strcmp(resolved_binding->behavior_dev, "KEY_PRESS") == 0);
+    }
+
+    if (!is_kp) {
+        return false;
+    }
+
+    // The param1 contains the keycode for &kp behavior
+    uint32_t keycode_encoded = resolved_binding->param1;
+    uint16_t usage_page = ZMK_HID_USAGE_PAGE(keycode_encoded);
+    uint16_t usage_id = ZMK_HID_USAGE_ID(keycode_encoded);
+
+    if (!usage_page) {
+        usage_page = HID_USAGE_KEY;
+    }
+
+    uint32_t usage = ZMK_HID_USAGE(usage_page, usage_id);
+
+    // Check if it's in the keep-keycodes list if configured
+    if (cfg->temp_layer_keep_keycodes_len > 0) {
+        for (size_t j = 0; j < cfg->temp_layer_keep_keycodes_len; j++) {
+            if (cfg->temp_layer_keep_keycodes[j] == usage) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Fallback to is_mod check if keycodes not configured
+    return is_mod(usage_page, usage_id);
+}
+
+// Rebuild the per-position keep bitmap. Called on layer state changes and
+// temp-layer config changes, so a key press only needs a bit test. Studio
+// keymap edits are picked up on the next layer change, which always happens
+// when the temp-layer layer is activated.
+static void update_temp_layer_keep_map(const struct device *dev) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+
+    memset(data->temp_layer_keep_map, 0, sizeof(data->temp_layer_keep_map));
+    if (!data->current.temp_layer_enabled) {
+        return;
+    }
+
+    for (uint32_t position = 0; position < ZMK_KEYMAP_LEN; position++) {
+        if (temp_layer_position_keeps_layer(cfg, data, position)) {
+            data->temp_layer_keep_map[position / 32] |= BIT(position % 32);
+        }
+    }
+}
+
+// Event listener for position changes (for temp-layer deactivation logic)
+static int position_state_changed_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    if (ev == NULL) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // Only handle key presses
+    if (!ev->state || ev->position >= ZMK_KEYMAP_LEN) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // Check temp-layer deactivation for all processors
+    for (size_t i = 0; i < runtime_processors_count; i++) {
+        const struct device *dev = runtime_processors[i].dev;
+        struct runtime_processor_data *data = dev->data;
+
+        // Check if temp-layer layer should be deactivated
+        if (!data->current.temp_layer_enabled || !data->state.temp_layer_layer_active ||
+            data->state.temp_layer_keep_active) {
+            continue;
+        }
+
+        if (data->temp_layer_keep_map[ev->position / 32] & BIT(ev->position % 32)) {
+            LOG_DBG("Key press at position %d keeps temp-layer layer active", ev->position);
+            continue;
+        }
+
+        // Deactivate the temp-layer layer
+        LOG_DBG("Deactivating temp-layer layer %d due to key press at position %d",
+                data->current.temp_layer_layer, ev->position);
+        // The shared deactivation work skips processors that are not armed
+        atomic_clear_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED);
+        int ret = zmk_keymap_layer_deactivate(data->current.temp_layer_layer);
+        if (ret == 0) {
+            data->state.temp_layer_layer_active = false;
+            LOG_INF("Temp-layer layer %d deactivated by key press", data->current.temp_layer_layer);
+        }
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+#endif
+
+#if RUNTIME_HAS_KEYMAP
+// Event listener for layer changes (refreshes the cached per-layer-state verdicts)
+static int layer_state_changed_listener(const zmk_event_t *eh) {
+    if (as_zmk_layer_state_changed(eh) == NULL) {
         return ZMK_EV_EVENT_BUBBLE;
     }
 
-    // Update last keypress timestamp for all processors
-    int64_t now = k_uptime_get();
     for (size_t i = 0; i < runtime_processors_count; i++) {
-        const struct device *dev = runtime_processors[i];
+        const struct device *dev = runtime_processors[i].dev;
         struct runtime_processor_data *data = dev->data;
-        data->last_keypress_timestamp = now;
+        bool was_active = data->state.active_for_layers;
+
+        update_active_for_layers(data);
+        update_temp_layer_keep_map(dev);
+        // A relayed processor is switched on and off on the peripheral
+        if (data->state.active_for_layers != was_active) {
+            queue_relay_config(dev);
+        }
     }
 
     return ZMK_EV_EVENT_BUBBLE;
 }
 
-// Event listener for position changes (for temp-layer deactivation logic)
-static int position_state_changed_listener(const zmk_event_t *eh) {
-    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
-    if (ev == NULL) {
-        return ZMK_EV_EVENT_BUBBLE;
-    }
+ZMK_LISTENER(runtime_processor_layer_listener, layer_state_changed_listener);
+ZMK_SUBSCRIPTION(runtime_processor_layer_listener, zmk_layer_state_changed);
+#endif
 
-    // Only handle key presses
-    if (!ev->state) {
-        return ZMK_EV_EVENT_BUBBLE;
+#if RUNTIME_HAS_TEMP_LAYER
+// Without temp-layer support no listener sees key presses at all
+ZMK_LISTENER(runtime_processor_keycode_listener, keycode_state_changed_listener);
+ZMK_SUBSCRIPTION(runtime_processor_keycode_listener, zmk_keycode_state_changed);
+
+ZMK_LISTENER(runtime_processor_position_listener, position_state_changed_listener);
+ZMK_SUBSCRIPTION(runtime_processor_position_listener, zmk_position_state_changed);
+#endif
+
+#if RUNTIME_RELAY_CENTRAL
+// Temp-layer stays on the central; the peripheral runs with the other fields
+#define RUNTIME_RELAY_TEMP_LAYER_FIELDS                                                            \
+    (ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED | ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER | \
+     ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_DELAY |                                      \
+     ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_DEACTIVATION_DELAY |                                    \
+     ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD |                                  \
+     ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD |                                     \
+     ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_MOTION_WINDOW)
+#define RUNTIME_RELAY_FIELDS (ZMK_INPUT_PROCESSOR_CONFIG_ALL & ~RUNTIME_RELAY_TEMP_LAYER_FIELDS)
+
+BUILD_ASSERT(ARRAY_SIZE(runtime_processors) <= 32, "Too many processors for the split relay");
+
+// Processors (by ID) whose configuration is waiting to be relayed, and those
+// whose peripheral (re)connected and needs the full configuration
+static atomic_t relay_pending;
+static atomic_t relay_resync;
+
+static void relay_work_handler(struct k_work *work);
+static K_WORK_DEFINE(relay_work, relay_work_handler);
+
+static void queue_relay_config(const struct device *dev) {
+    const struct runtime_processor_config *cfg = dev->config;
+
+    if (cfg->relay_behavior) {
+        atomic_or(&relay_pending, BIT(cfg->id));
+        k_work_submit(&relay_work);
     }
+}
 
-    // Check temp-layer deactivation for all processors
-    for (size_t i = 0; i < runtime_processors_count; i++) {
-        const struct device *dev = runtime_processors[i];
-        const struct runtime_processor_config *cfg = dev->config;
-        struct runtime_processor_data *data = dev->data;
+static int relay_send(const struct runtime_processor_config *cfg, uint8_t command,
+                      uint8_t argument, uint32_t value) {
+    struct zmk_behavior_binding binding = {
+        .behavior_dev = cfg->relay_behavior->name,
+        .param1 = ZMK_INPUT_PROCESSOR_RELAY_PARAM1(command, argument),
+        .param2 = value,
+    };
+    struct zmk_behavior_binding_event event = {.timestamp = k_uptime_get()};
 
-        // Check if temp-layer layer should be deactivated
-        if (!data->temp_layer_enabled || !data->temp_layer_layer_active ||
-            data->temp_layer_keep_active) {
-            continue;
-        }
+    return zmk_split_central_invoke_behavior(cfg->relay_source, &binding, event, true);
+}
 
-        // Check if the temp-layer layer has a non-transparent binding for this
-        // position
-        zmk_keymap_layer_id_t temp_layer_layer_id = data->temp_layer_layer;
-        const struct zmk_behavior_binding *temp_layer_binding =
-            zmk_keymap_get_layer_binding_at_idx(temp_layer_layer_id, ev->position);
-
-        // If temp-layer layer has non-transparent binding, don't deactivate
-        // Use device pointer comparison if transparent behavior is configured
-        bool is_transparent = false;
-        if (temp_layer_binding) {
-            if (cfg->temp_layer_transparent_behavior) {
-                // Efficient device pointer comparison
-                const struct device *binding_dev =
-                    zmk_behavior_get_binding(temp_layer_binding->behavior_dev);
-                is_transparent = (binding_dev == cfg->temp_layer_transparent_behavior);
-            } else {
-                // Fallback to string comparison if not configured
-                is_transparent = (strcmp(temp_layer_binding->behavior_dev, "trans") == 0 ||
-                                  strcmp(temp_layer_binding->behavior_dev, "TRANS") == 0);
+// Send one field; the LUT points go ahead of the LUT length
+static int relay_field(const struct runtime_processor_config *cfg,
+                       const struct zmk_input_processor_runtime_config *config, uint8_t field) {
+    if (BIT(field) == ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT) {
+        for (uint8_t i = 0; i * 2 < config->accel_lut_len; i++) {
+            uint32_t pair = config->accel_lut[i * 2] | (uint32_t)config->accel_lut[i * 2 + 1] << 16;
+            int ret = relay_send(cfg, ZMK_INPUT_PROCESSOR_RELAY_LUT_PAIR, i, pair);
+            if (ret < 0) {
+                return ret;
             }
+        }
+    }
 
-            if (!is_transparent) {
-                LOG_DBG("Temp-layer layer has non-transparent binding at position "
-                        "%d, not deactivating",
-                        ev->position);
-                continue;
-            }
+    return relay_send(cfg, ZMK_INPUT_PROCESSOR_RELAY_FIELD, field,
+                      zmk_input_processor_relay_get_field(config, field));
+}
+
+// Fields of config that differ from what the peripheral runs with
+static uint32_t relay_changed_fields(const struct runtime_processor_data *data,
+                                     const struct zmk_input_processor_runtime_config *config) {
+    if (!data->relay_synced) {
+        return RUNTIME_RELAY_FIELDS;
+    }
+
+    uint32_t changed = 0;
+    for (uint32_t fields = RUNTIME_RELAY_FIELDS; fields; fields &= fields - 1) {
+        uint8_t field = __builtin_ctz(fields);
+        if (zmk_input_processor_relay_get_field(&data->relay_sent, field) !=
+            zmk_input_processor_relay_get_field(config, field)) {
+            changed |= BIT(field);
         }
+    }
+    if (memcmp(data->relay_sent.accel_lut, config->accel_lut, sizeof(config->accel_lut)) != 0) {
+        changed |= ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT;
+    }
+    return changed;
+}
 
-        // Temp-layer binding is transparent, check the resolved binding
-        // Find the highest active layer's non-transparent binding
-        const struct zmk_behavior_binding *resolved_binding = NULL;
+static void relay_processor_config(const struct device *dev) {
+    const struct runtime_processor_config *cfg = dev->config;
+    struct runtime_processor_data *data = dev->data;
+    struct zmk_input_processor_runtime_config config;
 
-        for (int layer_idx = ZMK_KEYMAP_LAYERS_LEN - 1; layer_idx >= 0; layer_idx--) {
-            zmk_keymap_layer_id_t layer_id = zmk_keymap_layer_index_to_id(layer_idx);
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    config = data->current;
+    k_mutex_unlock(&runtime_plan_mutex);
 
-            if (layer_id == ZMK_KEYMAP_LAYER_ID_INVAL) {
-                continue;
-            }
+    // The peripheral has no layers: it runs the processor while it gets 0
+    // and leaves motion alone for any other mask
+    if (data->state.active_for_layers) {
+        config.active_layers = 0;
+    }
 
-            if (!zmk_keymap_layer_active(layer_id)) {
-                continue;
-            }
+    uint32_t changed = relay_changed_fields(data, &config);
+    if (!changed) {
+        return;
+    }
 
-            const struct zmk_behavior_binding *binding =
-                zmk_keymap_get_layer_binding_at_idx(layer_id, ev->position);
-
-            if (binding) {
-                bool binding_is_transparent = false;
-                if (cfg->temp_layer_transparent_behavior) {
-                    const struct device *binding_dev =
-                        zmk_behavior_get_binding(binding->behavior_dev);
-                    binding_is_transparent = (binding_dev == cfg->temp_layer_transparent_behavior);
-                } else {
-                    binding_is_transparent = (strcmp(binding->behavior_dev, "trans") == 0 ||
-                                              strcmp(binding->behavior_dev, "TRANS") == 0);
-                }
-
-                if (!binding_is_transparent) {
-                    resolved_binding = binding;
-                    break;
-                }
-            }
-        }
+    int ret = 0;
+    for (uint32_t fields = changed; fields && ret >= 0; fields &= fields - 1) {
+        ret = relay_field(cfg, &config, __builtin_ctz(fields));
+    }
+    if (ret >= 0) {
+        ret = relay_send(cfg, ZMK_INPUT_PROCESSOR_RELAY_APPLY, 0, changed);
+    }
+    if (ret < 0) {
+        // Sent in full once the peripheral connects
+        data->relay_synced = false;
+        LOG_WRN("Failed to relay config of %s to peripheral %d: %d", cfg->name,
+                cfg->relay_source, ret);
+        return;
+    }
 
-        // If resolved binding is &kp with a modifier keycode, don't deactivate
-        if (resolved_binding) {
-            bool is_kp = false;
-            if (cfg->temp_layer_kp_behavior) {
-                const struct device *binding_dev =
-                    zmk_behavior_get_binding(resolved_binding->behavior_dev);
-                is_kp = (binding_dev == cfg->temp_layer_kp_behavior);
-            } else {
-                is_kp = (strcmp(resolved_binding->behavior_dev, "kp") == 0 ||
-                         strcmp(resolved_binding->behavior_dev, "KEY_PRESS") == 0);
-            }
+    data->relay_sent = config;
+    data->relay_synced = true;
+    LOG_DBG("Relayed config fields 0x%08x of %s", changed, cfg->name);
+}
 
-            if (is_kp) {
-                // The param1 contains the keycode for &kp behavior
-                uint32_t keycode_encoded = resolved_binding->param1;
-                uint16_t usage_page = ZMK_HID_USAGE_PAGE(keycode_encoded);
-                uint16_t usage_id = ZMK_HID_USAGE_ID(keycode_encoded);
-
-                if (!usage_page) {
-                    usage_page = HID_USAGE_KEY;
-                }
-
-                uint32_t usage = ZMK_HID_USAGE(usage_page, usage_id);
-
-                // Check if it's in the keep-keycodes list if configured
-                bool should_keep = false;
-                if (cfg->temp_layer_keep_keycodes_len > 0) {
-                    for (size_t j = 0; j < cfg->temp_layer_keep_keycodes_len; j++) {
-                        if (cfg->temp_layer_keep_keycodes[j] == usage) {
-                            should_keep = true;
-                            break;
-                        }
-                    }
-                } else {
-                    // Fallback to is_mod check if keycodes not configured
-                    should_keep = is_mod(usage_page, usage_id);
-                }
-
-                if (should_keep) {
-                    LOG_DBG("Resolved binding is keep keycode, not deactivating "
-                            "temp-layer layer");
-                    continue;
-                }
-            }
+static void relay_work_handler(struct k_work *work) {
+    uint32_t resync = atomic_clear(&relay_resync);
+    uint32_t pending = atomic_clear(&relay_pending);
+
+    for (; pending; pending &= pending - 1) {
+        uint8_t id = __builtin_ctz(pending);
+        const struct device *dev = runtime_processors[id].dev;
+        struct runtime_processor_data *data = dev->data;
+
+        if (resync & BIT(id)) {
+            data->relay_synced = false;
         }
+        relay_processor_config(dev);
+    }
+}
 
-        // Deactivate the temp-layer layer
-        LOG_DBG("Deactivating temp-layer layer %d due to key press at position %d",
-                data->temp_layer_layer, ev->position);
-        k_work_cancel_delayable(&data->temp_layer_deactivation_work);
-        int ret = zmk_keymap_layer_deactivate(data->temp_layer_layer);
-        if (ret == 0) {
-            data->temp_layer_layer_active = false;
-            LOG_INF("Temp-layer layer %d deactivated by key press", data->temp_layer_layer);
+// A peripheral starts from its devicetree defaults after every connection
+static int split_peripheral_status_changed_listener(const zmk_event_t *eh) {
+    const struct zmk_split_peripheral_status_changed *ev =
+        as_zmk_split_peripheral_status_changed(eh);
+    if (ev == NULL || !ev->connected) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    for (size_t i = 0; i < runtime_processors_count; i++) {
+        const struct device *dev = runtime_processors[i].dev;
+        const struct runtime_processor_config *cfg = dev->config;
+
+        if (cfg->relay_behavior) {
+            atomic_or(&relay_resync, BIT(cfg->id));
+            queue_relay_config(dev);
         }
     }
 
     return ZMK_EV_EVENT_BUBBLE;
 }
 
-ZMK_LISTENER(runtime_processor_keycode_listener, keycode_state_changed_listener);
-ZMK_SUBSCRIPTION(runtime_processor_keycode_listener, zmk_keycode_state_changed);
-
-ZMK_LISTENER(runtime_processor_position_listener, position_state_changed_listener);
-ZMK_SUBSCRIPTION(runtime_processor_position_listener, zmk_position_state_changed);
+ZMK_LISTENER(runtime_processor_relay_listener, split_peripheral_status_changed_listener);
+ZMK_SUBSCRIPTION(runtime_processor_relay_listener, zmk_split_peripheral_status_changed);
+#endif
 
 // Temp-layer layer configuration API
 int zmk_input_processor_runtime_set_temp_layer(const struct device *dev, bool enabled,
@@ -1192,20 +4294,29 @@ int zmk_input_processor_runtime_set_temp_layer(const struct device *dev, bool en
         return -EINVAL;
     }
 
+    if (!RUNTIME_HAS_TEMP_LAYER && enabled) {
+        return -ENOTSUP;
+    }
+
     struct runtime_processor_data *data = dev->data;
 
-    data->temp_layer_enabled = enabled;
-    data->temp_layer_layer = layer;
-    data->temp_layer_activation_delay_ms = activation_delay_ms;
-    data->temp_layer_deactivation_delay_ms = deactivation_delay_ms;
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.temp_layer_enabled = enabled;
+    data->current.temp_layer_layer = layer;
+    data->current.temp_layer_activation_delay_ms = activation_delay_ms;
+    data->current.temp_layer_deactivation_delay_ms = deactivation_delay_ms;
 
     if (persistent) {
-        data->persistent_temp_layer_enabled = enabled;
-        data->persistent_temp_layer_layer = layer;
-        data->persistent_temp_layer_activation_delay_ms = activation_delay_ms;
-        data->persistent_temp_layer_deactivation_delay_ms = deactivation_delay_ms;
+        data->persistent.temp_layer_enabled = enabled;
+        data->persistent.temp_layer_layer = layer;
+        data->persistent.temp_layer_activation_delay_ms = activation_delay_ms;
+        data->persistent.temp_layer_deactivation_delay_ms = deactivation_delay_ms;
     }
 
+    update_processor_plan(dev);
+    update_temp_layer_keep_map(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Temp-layer layer config: enabled=%d, layer=%d, act_delay=%d, "
             "deact_delay=%d%s",
             enabled, layer, activation_delay_ms, deactivation_delay_ms,
@@ -1229,13 +4340,23 @@ int zmk_input_processor_runtime_set_temp_layer_enabled(const struct device *dev,
         return -EINVAL;
     }
 
+    if (!RUNTIME_HAS_TEMP_LAYER && enabled) {
+        return -ENOTSUP;
+    }
+
     struct runtime_processor_data *data = dev->data;
-    data->temp_layer_enabled = enabled;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.temp_layer_enabled = enabled;
 
     if (persistent) {
-        data->persistent_temp_layer_enabled = enabled;
+        data->persistent.temp_layer_enabled = enabled;
     }
 
+    update_processor_plan(dev);
+    update_temp_layer_keep_map(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Temp-layer enabled: %d%s", enabled, persistent ? " (persistent)" : " (temporary)");
 
     int ret = 0;
@@ -1256,12 +4377,17 @@ int zmk_input_processor_runtime_set_temp_layer_layer(const struct device *dev, u
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->temp_layer_layer = layer;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.temp_layer_layer = layer;
 
     if (persistent) {
-        data->persistent_temp_layer_layer = layer;
+        data->persistent.temp_layer_layer = layer;
     }
 
+    update_temp_layer_keep_map(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Temp-layer layer: %d%s", layer, persistent ? " (persistent)" : " (temporary)");
 
     int ret = 0;
@@ -1283,12 +4409,17 @@ int zmk_input_processor_runtime_set_temp_layer_activation_delay(const struct dev
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->temp_layer_activation_delay_ms = activation_delay_ms;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.temp_layer_activation_delay_ms = activation_delay_ms;
 
     if (persistent) {
-        data->persistent_temp_layer_activation_delay_ms = activation_delay_ms;
+        data->persistent.temp_layer_activation_delay_ms = activation_delay_ms;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Temp-layer activation delay: %dms%s", activation_delay_ms,
             persistent ? " (persistent)" : " (temporary)");
 
@@ -1311,12 +4442,17 @@ int zmk_input_processor_runtime_set_temp_layer_deactivation_delay(const struct d
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->temp_layer_deactivation_delay_ms = deactivation_delay_ms;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.temp_layer_deactivation_delay_ms = deactivation_delay_ms;
 
     if (persistent) {
-        data->persistent_temp_layer_deactivation_delay_ms = deactivation_delay_ms;
+        data->persistent.temp_layer_deactivation_delay_ms = deactivation_delay_ms;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Temp-layer deactivation delay: %dms%s", deactivation_delay_ms,
             persistent ? " (persistent)" : " (temporary)");
 
@@ -1331,6 +4467,48 @@ int zmk_input_processor_runtime_set_temp_layer_deactivation_delay(const struct d
     return ret;
 }
 
+int zmk_input_processor_runtime_set_temp_layer_motion(const struct device *dev,
+                                                      uint16_t activation_threshold,
+                                                      uint16_t release_threshold,
+                                                      uint16_t window_ms, bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    if (release_threshold > activation_threshold) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.temp_layer_activation_threshold = activation_threshold;
+    data->current.temp_layer_release_threshold = release_threshold;
+    data->current.temp_layer_motion_window_ms = window_ms;
+
+    if (persistent) {
+        data->persistent.temp_layer_activation_threshold = activation_threshold;
+        data->persistent.temp_layer_release_threshold = release_threshold;
+        data->persistent.temp_layer_motion_window_ms = window_ms;
+    }
+
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Temp-layer motion: activation=%d, release=%d, window=%dms%s", activation_threshold,
+            release_threshold, window_ms, persistent ? " (persistent)" : " (temporary)");
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
 int zmk_input_processor_runtime_set_active_layers(const struct device *dev, uint32_t layers,
                                                   bool persistent) {
     if (!dev) {
@@ -1338,11 +4516,21 @@ int zmk_input_processor_runtime_set_active_layers(const struct device *dev, uint
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->active_layers = layers;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    bool was_active = data->state.active_for_layers;
+
+    data->current.active_layers = layers;
+    update_active_for_layers(data);
+    // A relayed processor is switched on and off on the peripheral
+    if (data->state.active_for_layers != was_active) {
+        queue_relay_config(dev);
+    }
 
     if (persistent) {
-        data->persistent_active_layers = layers;
+        data->persistent.active_layers = layers;
     }
+    k_mutex_unlock(&runtime_plan_mutex);
 
     LOG_INF("Active layers: 0x%08x%s", layers, persistent ? " (persistent)" : " (temporary)");
 
@@ -1363,20 +4551,25 @@ int zmk_input_processor_runtime_set_axis_snap_mode(const struct device *dev, uin
         return -EINVAL;
     }
 
-    if (mode > ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_Y) {
+    if (mode > ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_AUTO) {
         return -EINVAL;
     }
+    if (!RUNTIME_HAS_AXIS_SNAP && mode != ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE) {
+        return -ENOTSUP;
+    }
 
     struct runtime_processor_data *data = dev->data;
-    data->axis_snap_mode = mode;
 
-    // Reset snap state when mode changes
-    data->axis_snap_cross_axis_accum = 0;
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.axis_snap_mode = mode;
 
     if (persistent) {
-        data->persistent_axis_snap_mode = mode;
+        data->persistent.axis_snap_mode = mode;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Axis snap mode: %d%s", mode, persistent ? " (persistent)" : " (temporary)");
 
     int ret = 0;
@@ -1397,12 +4590,17 @@ int zmk_input_processor_runtime_set_axis_snap_threshold(const struct device *dev
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->axis_snap_threshold = threshold;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.axis_snap_threshold = threshold;
 
     if (persistent) {
-        data->persistent_axis_snap_threshold = threshold;
+        data->persistent.axis_snap_threshold = threshold;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Axis snap threshold: %d%s", threshold, persistent ? " (persistent)" : " (temporary)");
 
     int ret = 0;
@@ -1423,12 +4621,17 @@ int zmk_input_processor_runtime_set_axis_snap_timeout(const struct device *dev,
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->axis_snap_timeout_ms = timeout_ms;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.axis_snap_timeout_ms = timeout_ms;
 
     if (persistent) {
-        data->persistent_axis_snap_timeout_ms = timeout_ms;
+        data->persistent.axis_snap_timeout_ms = timeout_ms;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Axis snap timeout: %d ms%s", timeout_ms,
             persistent ? " (persistent)" : " (temporary)");
 
@@ -1450,24 +4653,29 @@ int zmk_input_processor_runtime_set_axis_snap(const struct device *dev, uint8_t
         return -EINVAL;
     }
 
-    if (mode > ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_Y) {
+    if (mode > ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_AUTO) {
         return -EINVAL;
     }
+    if (!RUNTIME_HAS_AXIS_SNAP && mode != ZMK_INPUT_PROCESSOR_AXIS_SNAP_MODE_NONE) {
+        return -ENOTSUP;
+    }
 
     struct runtime_processor_data *data = dev->data;
-    data->axis_snap_mode = mode;
-    data->axis_snap_threshold = threshold;
-    data->axis_snap_timeout_ms = timeout_ms;
 
-    // Reset snap state when configuration changes
-    data->axis_snap_cross_axis_accum = 0;
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.axis_snap_mode = mode;
+    data->current.axis_snap_threshold = threshold;
+    data->current.axis_snap_timeout_ms = timeout_ms;
 
     if (persistent) {
-        data->persistent_axis_snap_mode = mode;
-        data->persistent_axis_snap_threshold = threshold;
-        data->persistent_axis_snap_timeout_ms = timeout_ms;
+        data->persistent.axis_snap_mode = mode;
+        data->persistent.axis_snap_threshold = threshold;
+        data->persistent.axis_snap_timeout_ms = timeout_ms;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Axis snap config: mode=%d, threshold=%d, timeout=%d ms%s", mode, threshold, timeout_ms,
             persistent ? " (persistent)" : " (temporary)");
 
@@ -1489,12 +4697,17 @@ int zmk_input_processor_runtime_set_x_invert(const struct device *dev, bool inve
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->x_invert = invert;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.x_invert = invert;
 
     if (persistent) {
-        data->persistent_x_invert = invert;
+        data->persistent.x_invert = invert;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("X axis invert: %s%s", invert ? "true" : "false",
             persistent ? " (persistent)" : " (temporary)");
 
@@ -1516,12 +4729,17 @@ int zmk_input_processor_runtime_set_y_invert(const struct device *dev, bool inve
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->y_invert = invert;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.y_invert = invert;
 
     if (persistent) {
-        data->persistent_y_invert = invert;
+        data->persistent.y_invert = invert;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("Y axis invert: %s%s", invert ? "true" : "false",
             persistent ? " (persistent)" : " (temporary)");
 
@@ -1542,16 +4760,20 @@ void zmk_input_processor_runtime_temp_layer_keep_active(const struct device *dev
         return;
     }
 
+#if RUNTIME_HAS_TEMP_LAYER
     struct runtime_processor_data *data = dev->data;
-    data->temp_layer_keep_active = keep_active;
+    data->state.temp_layer_keep_active = keep_active;
 
     LOG_DBG("Temp-layer keep_active set to %d", keep_active);
 
     // If releasing keep_active and layer is still active, deactivate
     // immediately
-    if (!keep_active && data->temp_layer_enabled && data->temp_layer_layer_active) {
-        k_work_reschedule(&data->temp_layer_deactivation_work, K_NO_WAIT);
+    if (!keep_active && data->current.temp_layer_enabled && data->state.temp_layer_layer_active) {
+        atomic_set_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATE_NOW);
+        atomic_set_bit(&data->temp_layer_flags, RUNTIME_TEMP_LAYER_DEACTIVATION_ARMED);
+        arm_temp_layer_deactivation(0);
     }
+#endif
 }
 
 int zmk_input_processor_runtime_set_xy_to_scroll_enabled(const struct device *dev, bool enabled,
@@ -1561,12 +4783,17 @@ int zmk_input_processor_runtime_set_xy_to_scroll_enabled(const struct device *de
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->xy_to_scroll_enabled = enabled;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.xy_to_scroll_enabled = enabled;
 
     if (persistent) {
-        data->persistent_xy_to_scroll_enabled = enabled;
+        data->persistent.xy_to_scroll_enabled = enabled;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("XY-to-scroll enabled: %d%s", enabled, persistent ? " (persistent)" : " (temporary)");
 
     int ret = 0;
@@ -1587,12 +4814,17 @@ int zmk_input_processor_runtime_set_xy_swap_enabled(const struct device *dev, bo
     }
 
     struct runtime_processor_data *data = dev->data;
-    data->xy_swap_enabled = enabled;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.xy_swap_enabled = enabled;
 
     if (persistent) {
-        data->persistent_xy_swap_enabled = enabled;
+        data->persistent.xy_swap_enabled = enabled;
     }
 
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
     LOG_INF("XY-swap enabled: %d%s", enabled, persistent ? " (persistent)" : " (temporary)");
 
     int ret = 0;
@@ -1605,3 +4837,179 @@ int zmk_input_processor_runtime_set_xy_swap_enabled(const struct device *dev, bo
 
     return ret;
 }
+
+int zmk_input_processor_runtime_set_accel(const struct device *dev, uint8_t curve,
+                                          uint16_t speed_max, uint16_t gain_max,
+                                          uint16_t exponent, bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    if (curve > ZMK_INPUT_PROCESSOR_ACCEL_CURVE_LUT || speed_max == 0) {
+        return -EINVAL;
+    }
+    if (!RUNTIME_HAS_ACCEL && curve != ZMK_INPUT_PROCESSOR_ACCEL_CURVE_NONE) {
+        return -ENOTSUP;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.accel_curve = curve;
+    data->current.accel_speed_max = speed_max;
+    data->current.accel_gain_max = gain_max;
+    data->current.accel_exponent = exponent;
+
+    if (persistent) {
+        data->persistent.accel_curve = curve;
+        data->persistent.accel_speed_max = speed_max;
+        data->persistent.accel_gain_max = gain_max;
+        data->persistent.accel_exponent = exponent;
+    }
+
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Acceleration config: curve=%d, speed_max=%d, gain_max=%d%%, exponent=%d%s", curve,
+            speed_max, gain_max, exponent, persistent ? " (persistent)" : " (temporary)");
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
+int zmk_input_processor_runtime_set_accel_lut(const struct device *dev, const uint16_t *gains,
+                                              uint8_t len, bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    if (len > ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS || (len > 0 && !gains)) {
+        return -EINVAL;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.accel_lut_len = len;
+    memset(data->current.accel_lut, 0, sizeof(data->current.accel_lut));
+    if (len > 0) {
+        memcpy(data->current.accel_lut, gains, len * sizeof(data->current.accel_lut[0]));
+    }
+
+    if (persistent) {
+        data->persistent.accel_lut_len = len;
+        memcpy(data->persistent.accel_lut, data->current.accel_lut,
+               sizeof(data->persistent.accel_lut));
+    }
+
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Acceleration LUT: %d points%s", len, persistent ? " (persistent)" : " (temporary)");
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
+int zmk_input_processor_runtime_set_filter(const struct device *dev, uint16_t dead_zone,
+                                           uint8_t iir_shift, uint16_t idle_ms, bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    if (iir_shift > ZMK_INPUT_PROCESSOR_FILTER_IIR_SHIFT_MAX) {
+        return -EINVAL;
+    }
+    if (!RUNTIME_HAS_FILTER && (dead_zone != 0 || iir_shift != 0)) {
+        return -ENOTSUP;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.filter_dead_zone = dead_zone;
+    data->current.filter_iir_shift = iir_shift;
+    data->current.filter_idle_ms = idle_ms;
+
+    if (persistent) {
+        data->persistent.filter_dead_zone = dead_zone;
+        data->persistent.filter_iir_shift = iir_shift;
+        data->persistent.filter_idle_ms = idle_ms;
+    }
+
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Filter config: dead_zone=%d, iir_shift=%d, idle_ms=%d%s", dead_zone, iir_shift,
+            idle_ms, persistent ? " (persistent)" : " (temporary)");
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
+
+int zmk_input_processor_runtime_set_scroll(const struct device *dev, uint16_t multiplier,
+                                           uint16_t divisor, uint8_t hires_multiplier, bool snap,
+                                           bool persistent) {
+    if (!dev) {
+        return -EINVAL;
+    }
+
+    if (hires_multiplier > ZMK_INPUT_PROCESSOR_SCROLL_HIRES_MAX) {
+        return -EINVAL;
+    }
+    if (!RUNTIME_HAS_SCROLL && divisor != 0) {
+        return -ENOTSUP;
+    }
+
+    struct runtime_processor_data *data = dev->data;
+
+    k_mutex_lock(&runtime_plan_mutex, K_FOREVER);
+    data->current.scroll_scale_multiplier = multiplier;
+    data->current.scroll_scale_divisor = divisor;
+    data->current.scroll_hires_multiplier = hires_multiplier;
+    data->current.scroll_snap = snap;
+
+    if (persistent) {
+        data->persistent.scroll_scale_multiplier = multiplier;
+        data->persistent.scroll_scale_divisor = divisor;
+        data->persistent.scroll_hires_multiplier = hires_multiplier;
+        data->persistent.scroll_snap = snap;
+    }
+
+    update_processor_plan(dev);
+    k_mutex_unlock(&runtime_plan_mutex);
+
+    LOG_INF("Scroll config: scale=%d/%d, hires=%d, snap=%d%s", multiplier, divisor,
+            hires_multiplier, snap, persistent ? " (persistent)" : " (temporary)");
+
+    int ret = 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    if (persistent) {
+        ret = schedule_save_processor_settings(dev);
+        raise_state_changed_event(dev);
+    }
+#endif
+
+    return ret;
+}
@@ -9,11 +9,12 @@
 #include <pb_decode.h>
 #include <pb_encode.h>
 #include <zephyr/logging/log.h>
-#include <zmk/event_manager.h>
-#include <zmk/events/input_processor_state_changed.h>
 #include <zmk/keymap.h>
 #include <zmk/pointing/input_processor_runtime.h>
 #include <zmk/studio/custom.h>
+
+#include "input_processor_listener.h"
+
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR)
@@ -74,6 +75,27 @@ static int handle_set_x_invert(const cormoran_rip_SetXInvertRequest *req,
                                cormoran_rip_Response *resp);
 static int handle_set_y_invert(const cormoran_rip_SetYInvertRequest *req,
                                cormoran_rip_Response *resp);
+static int handle_set_accel(const cormoran_rip_SetAccelRequest *req, cormoran_rip_Response *resp);
+static int handle_set_accel_lut(const cormoran_rip_SetAccelLutRequest *req,
+                                cormoran_rip_Response *resp);
+static int handle_set_filter(const cormoran_rip_SetFilterRequest *req, cormoran_rip_Response *resp);
+static int handle_set_scroll(const cormoran_rip_SetScrollRequest *req, cormoran_rip_Response *resp);
+static int handle_set_input_processor_config(const cormoran_rip_SetInputProcessorConfigRequest *req,
+                                             cormoran_rip_Response *resp);
+static int handle_list_profiles(const cormoran_rip_ListProfilesRequest *req,
+                                cormoran_rip_Response *resp);
+static int handle_save_profile(const cormoran_rip_SaveProfileRequest *req,
+                               cormoran_rip_Response *resp);
+static int handle_delete_profile(const cormoran_rip_DeleteProfileRequest *req,
+                                 cormoran_rip_Response *resp);
+static int handle_select_profile(const cormoran_rip_SelectProfileRequest *req,
+                                 cormoran_rip_Response *resp);
+static int handle_get_processor_stats(const cormoran_rip_GetProcessorStatsRequest *req,
+                                      cormoran_rip_Response *resp);
+static int handle_set_telemetry(const cormoran_rip_SetTelemetryRequest *req,
+                                cormoran_rip_Response *resp);
+static int handle_set_temp_layer_motion(const cormoran_rip_SetTempLayerMotionRequest *req,
+                                        cormoran_rip_Response *resp);
 
 /**
  * Main request handler for the custom RPC subsystem.
@@ -151,12 +173,49 @@ static bool rip_rpc_handle_request(const zmk_custom_CallRequest *raw_request,
         break;
     case cormoran_rip_Request_set_xy_swap_enabled_tag:
         rc = handle_set_xy_swap_enabled(&req.request_type.set_xy_swap_enabled, resp);
+        break;
     case cormoran_rip_Request_set_x_invert_tag:
         rc = handle_set_x_invert(&req.request_type.set_x_invert, resp);
         break;
     case cormoran_rip_Request_set_y_invert_tag:
         rc = handle_set_y_invert(&req.request_type.set_y_invert, resp);
         break;
+    case cormoran_rip_Request_set_accel_tag:
+        rc = handle_set_accel(&req.request_type.set_accel, resp);
+        break;
+    case cormoran_rip_Request_set_accel_lut_tag:
+        rc = handle_set_accel_lut(&req.request_type.set_accel_lut, resp);
+        break;
+    case cormoran_rip_Request_set_filter_tag:
+        rc = handle_set_filter(&req.request_type.set_filter, resp);
+        break;
+    case cormoran_rip_Request_set_scroll_tag:
+        rc = handle_set_scroll(&req.request_type.set_scroll, resp);
+        break;
+    case cormoran_rip_Request_set_input_processor_config_tag:
+        rc = handle_set_input_processor_config(&req.request_type.set_input_processor_config, resp);
+        break;
+    case cormoran_rip_Request_list_profiles_tag:
+        rc = handle_list_profiles(&req.request_type.list_profiles, resp);
+        break;
+    case cormoran_rip_Request_save_profile_tag:
+        rc = handle_save_profile(&req.request_type.save_profile, resp);
+        break;
+    case cormoran_rip_Request_delete_profile_tag:
+        rc = handle_delete_profile(&req.request_type.delete_profile, resp);
+        break;
+    case cormoran_rip_Request_select_profile_tag:
+        rc = handle_select_profile(&req.request_type.select_profile, resp);
+        break;
+    case cormoran_rip_Request_get_processor_stats_tag:
+        rc = handle_get_processor_stats(&req.request_type.get_processor_stats, resp);
+        break;
+    case cormoran_rip_Request_set_telemetry_tag:
+        rc = handle_set_telemetry(&req.request_type.set_telemetry, resp);
+        break;
+    case cormoran_rip_Request_set_temp_layer_motion_tag:
+        rc = handle_set_temp_layer_motion(&req.request_type.set_temp_layer_motion, resp);
+        break;
     default:
         LOG_WRN("Unsupported rip request type: %d", req.which_request_type);
         rc = -1;
@@ -171,54 +230,85 @@ static bool rip_rpc_handle_request(const zmk_custom_CallRequest *raw_request,
     return true;
 }
 
-// Helper callback to send notification for each processor during list operation
-struct list_processors_context {
-    int count;
-};
-
-static int list_processors_callback(const struct device *dev, void *user_data) {
-    struct list_processors_context *ctx = (struct list_processors_context *)user_data;
-
-    const char *name;
-    struct zmk_input_processor_runtime_config config;
-    int ret = zmk_input_processor_runtime_get_config(dev, &name, &config);
-    if (ret < 0) {
-        return 0;
+// Fill the processor info message from a processor table entry
+static void fill_processor_info(uint8_t id, const struct zmk_input_processor_runtime_entry *entry,
+                                cormoran_rip_InputProcessorInfo *info) {
+    const struct zmk_input_processor_runtime_config *config = entry->config;
+
+    info->id = id;
+    strncpy(info->name, entry->name, sizeof(info->name) - 1);
+    info->name[sizeof(info->name) - 1] = '\0';
+    info->scale_multiplier = config->scale_multiplier;
+    info->scale_divisor = config->scale_divisor;
+    info->rotation_degrees = config->rotation_degrees;
+    info->temp_layer_enabled = config->temp_layer_enabled;
+    info->temp_layer_layer = config->temp_layer_layer;
+    info->temp_layer_activation_delay_ms = config->temp_layer_activation_delay_ms;
+    info->temp_layer_deactivation_delay_ms = config->temp_layer_deactivation_delay_ms;
+    info->active_layers = config->active_layers;
+    info->axis_snap_mode = (cormoran_rip_AxisSnapMode)config->axis_snap_mode;
+    info->axis_snap_threshold = config->axis_snap_threshold;
+    info->axis_snap_timeout_ms = config->axis_snap_timeout_ms;
+    info->xy_to_scroll_enabled = config->xy_to_scroll_enabled;
+    info->xy_swap_enabled = config->xy_swap_enabled;
+    info->x_invert = config->x_invert;
+    info->y_invert = config->y_invert;
+    info->accel_curve = (cormoran_rip_AccelCurve)config->accel_curve;
+    info->accel_speed_max = config->accel_speed_max;
+    info->accel_gain_max = config->accel_gain_max;
+    info->accel_exponent = config->accel_exponent;
+    info->accel_lut_count = config->accel_lut_len;
+    for (int i = 0; i < config->accel_lut_len; i++) {
+        info->accel_lut[i] = config->accel_lut[i];
     }
+    info->filter_dead_zone = config->filter_dead_zone;
+    info->filter_iir_shift = config->filter_iir_shift;
+    info->filter_idle_ms = config->filter_idle_ms;
+    info->scroll_scale_multiplier = config->scroll_scale_multiplier;
+    info->scroll_scale_divisor = config->scroll_scale_divisor;
+    info->scroll_hires_multiplier = config->scroll_hires_multiplier;
+    info->scroll_snap = config->scroll_snap;
+    info->temp_layer_activation_threshold = config->temp_layer_activation_threshold;
+    info->temp_layer_release_threshold = config->temp_layer_release_threshold;
+    info->temp_layer_motion_window_ms = config->temp_layer_motion_window_ms;
+}
 
-    // Get processor ID
-    int id = zmk_input_processor_runtime_get_id(dev);
-    if (id < 0) {
-        return 0;
-    }
+// Encode every processor into the repeated processors field, one at a time so
+// the list is never held in memory as a whole
+static bool encode_processor_list(pb_ostream_t *stream, const pb_field_t *field, void *const *arg) {
+    const struct zmk_input_processor_runtime_entry *entry;
 
-    // Raise event which will be caught by listener and sent as notification
-    raise_zmk_input_processor_state_changed((struct zmk_input_processor_state_changed){
-        .id = (uint8_t)id, .name = name, .config = config});
+    for (uint8_t id = 0; (entry = zmk_input_processor_runtime_get_entry(id)) != NULL; id++) {
+        cormoran_rip_InputProcessorInfo info = cormoran_rip_InputProcessorInfo_init_zero;
+        fill_processor_info(id, entry, &info);
 
-    ctx->count++;
-    return 0;
-}
+        if (!pb_encode_tag_for_field(stream, field)) {
+            return false;
+        }
 
-static void list_input_processors_work_handler(struct k_work *work) {
-    struct list_processors_context ctx = {.count = 0};
-    zmk_input_processor_runtime_foreach(list_processors_callback, &ctx);
-    LOG_INF("Raised events for %d input processors", ctx.count);
-}
+        if (!pb_encode_submessage(stream, cormoran_rip_InputProcessorInfo_fields, &info)) {
+            return false;
+        }
+    }
 
-K_WORK_DEFINE(list_input_processors_work, list_input_processors_work_handler);
+    return true;
+}
 
 /**
- * Handle listing all input processors - raises events for each
+ * Handle listing all input processors
  */
 static int handle_list_input_processors(const cormoran_rip_ListInputProcessorsRequest *req,
                                         cormoran_rip_Response *resp) {
-    k_work_submit(&list_input_processors_work);
+    LOG_DBG("Listing input processors");
 
-    // Return empty response (notifications sent via events contain the data)
-    resp->which_response_type = cormoran_rip_Response_list_input_processors_tag;
-    resp->response_type.list_input_processors = (cormoran_rip_ListInputProcessorsResponse)
+    cormoran_rip_ListInputProcessorsResponse result =
         cormoran_rip_ListInputProcessorsResponse_init_zero;
+
+    // Set up callback for encoding processors
+    result.processors.funcs.encode = encode_processor_list;
+
+    resp->which_response_type = cormoran_rip_Response_list_input_processors_tag;
+    resp->response_type.list_input_processors = result;
     return 0;
 }
 
@@ -229,8 +319,9 @@ static int handle_get_input_processor(const cormoran_rip_GetInputProcessorReques
                                       cormoran_rip_Response *resp) {
     LOG_DBG("Getting input processor: id=%d", req->id);
 
-    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
-    if (!dev) {
+    const struct zmk_input_processor_runtime_entry *entry =
+        zmk_input_processor_runtime_get_entry(req->id);
+    if (!entry) {
         LOG_WRN("Input processor not found: id=%d", req->id);
         return -ENODEV;
     }
@@ -238,29 +329,8 @@ static int handle_get_input_processor(const cormoran_rip_GetInputProcessorReques
     cormoran_rip_GetInputProcessorResponse result =
         cormoran_rip_GetInputProcessorResponse_init_zero;
 
-    const char *name;
-    struct zmk_input_processor_runtime_config config;
-    int ret = zmk_input_processor_runtime_get_config(dev, &name, &config);
-    if (ret < 0) {
-        return ret;
-    }
-
-    result.processor.id = req->id;
-    strncpy(result.processor.name, name, sizeof(result.processor.name) - 1);
-    result.processor.name[sizeof(result.processor.name) - 1] = '\0';
-    result.processor.scale_multiplier = config.scale_multiplier;
-    result.processor.scale_divisor = config.scale_divisor;
-    result.processor.rotation_degrees = config.rotation_degrees;
-    result.processor.temp_layer_enabled = config.temp_layer_enabled;
-    result.processor.temp_layer_layer = config.temp_layer_layer;
-    result.processor.temp_layer_activation_delay_ms = config.temp_layer_activation_delay_ms;
-    result.processor.temp_layer_deactivation_delay_ms = config.temp_layer_deactivation_delay_ms;
-    result.processor.active_layers = config.active_layers;
-    result.processor.axis_snap_mode = (cormoran_rip_AxisSnapMode)config.axis_snap_mode;
-    result.processor.axis_snap_threshold = config.axis_snap_threshold;
-    result.processor.axis_snap_timeout_ms = config.axis_snap_timeout_ms;
-    result.processor.x_invert = config.x_invert;
-    result.processor.y_invert = config.y_invert;
+    result.has_processor = true;
+    fill_processor_info(req->id, entry, &result.processor);
 
     resp->which_response_type = cormoran_rip_Response_get_input_processor_tag;
     resp->response_type.get_input_processor = result;
@@ -275,21 +345,16 @@ static int handle_set_scale_multiplier(const cormoran_rip_SetScaleMultiplierRequ
                                        cormoran_rip_Response *resp) {
     LOG_DBG("Setting scale multiplier for id=%d to %d", req->id, req->value);
 
-    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
-    if (!dev) {
+    const struct zmk_input_processor_runtime_entry *entry =
+        zmk_input_processor_runtime_get_entry(req->id);
+    if (!entry) {
         LOG_WRN("Input processor not found: id=%d", req->id);
         return -ENODEV;
     }
 
-    // Get current divisor
-    struct zmk_input_processor_runtime_config config;
-    int ret = zmk_input_processor_runtime_get_config(dev, NULL, &config);
-    if (ret < 0) {
-        return ret;
-    }
-
     // Set new multiplier (persistent)
-    ret = zmk_input_processor_runtime_set_scaling(dev, req->value, config.scale_divisor, true);
+    int ret = zmk_input_processor_runtime_set_scaling(entry->dev, req->value,
+                                                      entry->config->scale_divisor, true);
     if (ret < 0) {
         LOG_ERR("Failed to set scale multiplier: %d", ret);
         return ret;
@@ -310,21 +375,16 @@ static int handle_set_scale_divisor(const cormoran_rip_SetScaleDivisorRequest *r
                                     cormoran_rip_Response *resp) {
     LOG_DBG("Setting scale divisor for id=%d to %d", req->id, req->value);
 
-    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
-    if (!dev) {
+    const struct zmk_input_processor_runtime_entry *entry =
+        zmk_input_processor_runtime_get_entry(req->id);
+    if (!entry) {
         LOG_WRN("Input processor not found: id=%d", req->id);
         return -ENODEV;
     }
 
-    // Get current multiplier
-    struct zmk_input_processor_runtime_config config;
-    int ret = zmk_input_processor_runtime_get_config(dev, NULL, &config);
-    if (ret < 0) {
-        return ret;
-    }
-
     // Set new divisor (persistent)
-    ret = zmk_input_processor_runtime_set_scaling(dev, config.scale_multiplier, req->value, true);
+    int ret = zmk_input_processor_runtime_set_scaling(entry->dev, entry->config->scale_multiplier,
+                                                      req->value, true);
     if (ret < 0) {
         LOG_ERR("Failed to set scale divisor: %d", ret);
         return ret;
@@ -681,6 +741,438 @@ static int handle_set_y_invert(const cormoran_rip_SetYInvertRequest *req,
     return 0;
 }
 
+/**
+ * Handle setting acceleration curve
+ */
+static int handle_set_accel(const cormoran_rip_SetAccelRequest *req, cormoran_rip_Response *resp) {
+    LOG_DBG("Setting acceleration for id=%d: curve=%d, speed_max=%d, gain_max=%d, exponent=%d",
+            req->id, req->curve, req->speed_max, req->gain_max, req->exponent);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    // Set acceleration (persistent)
+    int ret = zmk_input_processor_runtime_set_accel(dev, req->curve, req->speed_max,
+                                                    req->gain_max, req->exponent, true);
+    if (ret < 0) {
+        LOG_ERR("Failed to set acceleration: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_set_accel_tag;
+    resp->response_type.set_accel =
+        (cormoran_rip_SetAccelResponse)cormoran_rip_SetAccelResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle setting acceleration lookup table
+ */
+static int handle_set_accel_lut(const cormoran_rip_SetAccelLutRequest *req,
+                                cormoran_rip_Response *resp) {
+    LOG_DBG("Setting acceleration LUT for id=%d: %d points", req->id, req->gains_count);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    uint16_t gains[ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS];
+    uint8_t len = MIN(req->gains_count, ARRAY_SIZE(gains));
+    for (int i = 0; i < len; i++) {
+        gains[i] = MIN(req->gains[i], UINT16_MAX);
+    }
+
+    // Set acceleration LUT (persistent)
+    int ret = zmk_input_processor_runtime_set_accel_lut(dev, gains, len, true);
+    if (ret < 0) {
+        LOG_ERR("Failed to set acceleration LUT: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_set_accel_lut_tag;
+    resp->response_type.set_accel_lut =
+        (cormoran_rip_SetAccelLutResponse)cormoran_rip_SetAccelLutResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle setting the jitter filter
+ */
+static int handle_set_filter(const cormoran_rip_SetFilterRequest *req,
+                             cormoran_rip_Response *resp) {
+    LOG_DBG("Setting filter for id=%d: dead_zone=%d, iir_shift=%d, idle_ms=%d", req->id,
+            req->dead_zone, req->iir_shift, req->idle_ms);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    // Set filter (persistent)
+    int ret = zmk_input_processor_runtime_set_filter(dev, MIN(req->dead_zone, UINT16_MAX),
+                                                     MIN(req->iir_shift, UINT8_MAX),
+                                                     MIN(req->idle_ms, UINT16_MAX), true);
+    if (ret < 0) {
+        LOG_ERR("Failed to set filter: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_set_filter_tag;
+    resp->response_type.set_filter =
+        (cormoran_rip_SetFilterResponse)cormoran_rip_SetFilterResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle setting the scroll sub-pipeline
+ */
+static int handle_set_scroll(const cormoran_rip_SetScrollRequest *req,
+                             cormoran_rip_Response *resp) {
+    LOG_DBG("Setting scroll for id=%d: scale=%d/%d, hires=%d, snap=%d", req->id,
+            req->scale_multiplier, req->scale_divisor, req->hires_multiplier, req->snap);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    // Set scroll (persistent)
+    int ret = zmk_input_processor_runtime_set_scroll(
+        dev, MIN(req->scale_multiplier, UINT16_MAX), MIN(req->scale_divisor, UINT16_MAX),
+        MIN(req->hires_multiplier, UINT8_MAX), req->snap, true);
+    if (ret < 0) {
+        LOG_ERR("Failed to set scroll: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_set_scroll_tag;
+    resp->response_type.set_scroll =
+        (cormoran_rip_SetScrollResponse)cormoran_rip_SetScrollResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle setting several configuration fields at once
+ */
+static int handle_set_input_processor_config(const cormoran_rip_SetInputProcessorConfigRequest *req,
+                                             cormoran_rip_Response *resp) {
+    LOG_DBG("Setting config for id=%d: field_mask=0x%08x", req->id, req->field_mask);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    const cormoran_rip_InputProcessorInfo *info = &req->config;
+    struct zmk_input_processor_runtime_config config = {
+        .scale_multiplier = info->scale_multiplier,
+        .scale_divisor = info->scale_divisor,
+        .rotation_degrees = info->rotation_degrees,
+        .temp_layer_enabled = info->temp_layer_enabled,
+        .temp_layer_layer = info->temp_layer_layer,
+        .temp_layer_activation_delay_ms = MIN(info->temp_layer_activation_delay_ms, UINT16_MAX),
+        .temp_layer_deactivation_delay_ms =
+            MIN(info->temp_layer_deactivation_delay_ms, UINT16_MAX),
+        .active_layers = info->active_layers,
+        .axis_snap_mode = info->axis_snap_mode,
+        .axis_snap_threshold = MIN(info->axis_snap_threshold, UINT16_MAX),
+        .axis_snap_timeout_ms = MIN(info->axis_snap_timeout_ms, UINT16_MAX),
+        .xy_to_scroll_enabled = info->xy_to_scroll_enabled,
+        .xy_swap_enabled = info->xy_swap_enabled,
+        .x_invert = info->x_invert,
+        .y_invert = info->y_invert,
+        .accel_curve = info->accel_curve,
+        .accel_speed_max = MIN(info->accel_speed_max, UINT16_MAX),
+        .accel_gain_max = MIN(info->accel_gain_max, UINT16_MAX),
+        .accel_exponent = MIN(info->accel_exponent, UINT16_MAX),
+        .accel_lut_len = MIN(info->accel_lut_count, ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS),
+        .filter_dead_zone = MIN(info->filter_dead_zone, UINT16_MAX),
+        .filter_iir_shift = MIN(info->filter_iir_shift, UINT8_MAX),
+        .filter_idle_ms = MIN(info->filter_idle_ms, UINT16_MAX),
+        .scroll_scale_multiplier = MIN(info->scroll_scale_multiplier, UINT16_MAX),
+        .scroll_scale_divisor = MIN(info->scroll_scale_divisor, UINT16_MAX),
+        .scroll_hires_multiplier = MIN(info->scroll_hires_multiplier, UINT8_MAX),
+        .scroll_snap = info->scroll_snap,
+        .temp_layer_activation_threshold = MIN(info->temp_layer_activation_threshold, UINT16_MAX),
+        .temp_layer_release_threshold = MIN(info->temp_layer_release_threshold, UINT16_MAX),
+        .temp_layer_motion_window_ms = MIN(info->temp_layer_motion_window_ms, UINT16_MAX),
+    };
+    for (int i = 0; i < config.accel_lut_len; i++) {
+        config.accel_lut[i] = MIN(info->accel_lut[i], UINT16_MAX);
+    }
+
+    // Apply all selected fields (persistent)
+    int ret = zmk_input_processor_runtime_set_config(dev, &config, req->field_mask, true);
+    if (ret < 0) {
+        LOG_ERR("Failed to set config: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_set_input_processor_config_tag;
+    resp->response_type.set_input_processor_config =
+        (cormoran_rip_SetInputProcessorConfigResponse)
+            cormoran_rip_SetInputProcessorConfigResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle listing the stored profiles of an input processor
+ */
+static int handle_list_profiles(const cormoran_rip_ListProfilesRequest *req,
+                                cormoran_rip_Response *resp) {
+    LOG_DBG("Listing profiles for id=%d", req->id);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    cormoran_rip_ListProfilesResponse result = cormoran_rip_ListProfilesResponse_init_zero;
+
+    // Empty profiles are skipped; -EINVAL marks the end of the profile slots
+    for (uint8_t index = 0; index < ARRAY_SIZE(result.profiles); index++) {
+        const char *name;
+        int ret = zmk_input_processor_runtime_get_profile(dev, index, &name, NULL);
+        if (ret == -ENOENT) {
+            continue;
+        }
+        if (ret < 0) {
+            break;
+        }
+
+        cormoran_rip_ProfileInfo *info = &result.profiles[result.profiles_count++];
+        info->index = index;
+        strncpy(info->name, name, sizeof(info->name) - 1);
+        info->name[sizeof(info->name) - 1] = '\0';
+    }
+    result.active_profile = zmk_input_processor_runtime_get_active_profile(dev);
+
+    resp->which_response_type = cormoran_rip_Response_list_profiles_tag;
+    resp->response_type.list_profiles = result;
+
+    return 0;
+}
+
+/**
+ * Handle storing the current configuration as a profile
+ */
+static int handle_save_profile(const cormoran_rip_SaveProfileRequest *req,
+                               cormoran_rip_Response *resp) {
+    LOG_DBG("Saving profile %d for id=%d: %s", req->index, req->id, req->name);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    // Store the current persistent configuration
+    int ret = zmk_input_processor_runtime_save_profile(dev, MIN(req->index, UINT8_MAX),
+                                                       req->name, NULL);
+    if (ret < 0) {
+        LOG_ERR("Failed to save profile: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_save_profile_tag;
+    resp->response_type.save_profile =
+        (cormoran_rip_SaveProfileResponse)cormoran_rip_SaveProfileResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle deleting a profile
+ */
+static int handle_delete_profile(const cormoran_rip_DeleteProfileRequest *req,
+                                 cormoran_rip_Response *resp) {
+    LOG_DBG("Deleting profile %d for id=%d", req->index, req->id);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    int ret = zmk_input_processor_runtime_delete_profile(dev, MIN(req->index, UINT8_MAX));
+    if (ret < 0) {
+        LOG_ERR("Failed to delete profile: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_delete_profile_tag;
+    resp->response_type.delete_profile =
+        (cormoran_rip_DeleteProfileResponse)cormoran_rip_DeleteProfileResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle switching to a profile
+ */
+static int handle_select_profile(const cormoran_rip_SelectProfileRequest *req,
+                                 cormoran_rip_Response *resp) {
+    LOG_DBG("Selecting profile %d for id=%d", req->index, req->id);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    int ret = zmk_input_processor_runtime_select_profile(dev, MIN(req->index, UINT8_MAX),
+                                                         req->persistent);
+    if (ret < 0) {
+        LOG_ERR("Failed to select profile: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_select_profile_tag;
+    resp->response_type.select_profile =
+        (cormoran_rip_SelectProfileResponse)cormoran_rip_SelectProfileResponse_init_zero;
+
+    return 0;
+}
+
+/**
+ * Handle reading (and optionally clearing) event path statistics
+ */
+static int handle_get_processor_stats(const cormoran_rip_GetProcessorStatsRequest *req,
+                                      cormoran_rip_Response *resp) {
+    LOG_DBG("Getting statistics for id=%d", req->id);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    struct zmk_input_processor_runtime_stats stats;
+    int ret = zmk_input_processor_runtime_get_stats(dev, &stats);
+    if (ret < 0) {
+        LOG_ERR("Failed to get statistics: %d", ret);
+        return ret;
+    }
+    if (req->reset) {
+        zmk_input_processor_runtime_reset_stats(dev);
+    }
+
+    cormoran_rip_GetProcessorStatsResponse result =
+        cormoran_rip_GetProcessorStatsResponse_init_zero;
+    result.events = stats.events;
+    result.processed = stats.processed;
+    result.stage_events_count =
+        MIN(ARRAY_SIZE(stats.stage_events), ARRAY_SIZE(result.stage_events));
+    memcpy(result.stage_events, stats.stage_events,
+           result.stage_events_count * sizeof(result.stage_events[0]));
+    result.snap_suppressed = stats.snap_suppressed;
+    result.rotation_dropped = stats.rotation_dropped;
+    result.overflows = stats.overflows;
+    result.temp_layer_activations = stats.temp_layer_activations;
+    result.coalesced = stats.coalesced;
+    result.filter_dropped = stats.filter_dropped;
+    result.scroll_held = stats.scroll_held;
+    result.cycles_max = stats.cycles_max;
+    result.cycle_histogram_count =
+        MIN(ARRAY_SIZE(stats.cycle_histogram), ARRAY_SIZE(result.cycle_histogram));
+    memcpy(result.cycle_histogram, stats.cycle_histogram,
+           result.cycle_histogram_count * sizeof(result.cycle_histogram[0]));
+    result.cycles_per_second = sys_clock_hw_cycles_per_sec();
+
+    resp->which_response_type = cormoran_rip_Response_get_processor_stats_tag;
+    resp->response_type.get_processor_stats = result;
+
+    return 0;
+}
+
+/**
+ * Handle starting or stopping the live telemetry stream of a processor
+ */
+static int handle_set_telemetry(const cormoran_rip_SetTelemetryRequest *req,
+                                cormoran_rip_Response *resp) {
+    LOG_DBG("Setting telemetry for id=%d: %d", req->id, req->enabled);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    int ret = zmk_input_processor_runtime_set_telemetry(dev, req->enabled);
+    if (ret < 0) {
+        LOG_ERR("Failed to set telemetry: %d", ret);
+        return ret;
+    }
+
+    cormoran_rip_SetTelemetryResponse result = cormoran_rip_SetTelemetryResponse_init_zero;
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+    // The work stops by itself once no processor has telemetry enabled
+    if (req->enabled) {
+        rip_telemetry_start();
+    }
+    result.interval_ms = CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_INTERVAL_MS;
+    result.batch = CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_BATCH;
+#endif
+
+    resp->which_response_type = cormoran_rip_Response_set_telemetry_tag;
+    resp->response_type.set_telemetry = result;
+
+    return 0;
+}
+
+/**
+ * Handle setting the temp-layer motion gate
+ */
+static int handle_set_temp_layer_motion(const cormoran_rip_SetTempLayerMotionRequest *req,
+                                        cormoran_rip_Response *resp) {
+    LOG_DBG("Setting temp-layer motion for id=%d: activation=%d, release=%d, window_ms=%d",
+            req->id, req->activation_threshold, req->release_threshold, req->window_ms);
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_id(req->id);
+    if (!dev) {
+        LOG_WRN("Input processor not found: id=%d", req->id);
+        return -ENODEV;
+    }
+
+    // Set temp-layer motion gate (persistent)
+    int ret = zmk_input_processor_runtime_set_temp_layer_motion(
+        dev, MIN(req->activation_threshold, UINT16_MAX), MIN(req->release_threshold, UINT16_MAX),
+        MIN(req->window_ms, UINT16_MAX), true);
+    if (ret < 0) {
+        LOG_ERR("Failed to set temp-layer motion: %d", ret);
+        return ret;
+    }
+
+    // Return empty response
+    resp->which_response_type = cormoran_rip_Response_set_temp_layer_motion_tag;
+    resp->response_type.set_temp_layer_motion =
+        (cormoran_rip_SetTempLayerMotionResponse)cormoran_rip_SetTempLayerMotionResponse_init_zero;
+
+    return 0;
+}
+
 /**
  * Handle getting layer information
  */
@@ -7,10 +7,15 @@
 
 #include <cormoran/rip/custom.pb.h>
 #include <pb_encode.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/input_processor_state_changed.h>
+#include <zmk/pointing/input_processor_runtime.h>
 #include <zmk/studio/custom.h>
+
+#include "input_processor_listener.h"
+
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STUDIO_RPC)
@@ -50,39 +55,50 @@ static uint8_t find_subsystem_index(const char *identifier) {
     return 0; // Default to first subsystem if not found
 }
 
-static int input_processor_state_changed_listener(const zmk_event_t *eh) {
-    const struct zmk_input_processor_state_changed *ev = as_zmk_input_processor_state_changed(eh);
-
-    if (!ev) {
-        return ZMK_EV_EVENT_BUBBLE;
-    }
-
-    LOG_DBG("Input processor state changed: %s (id=%d)", ev->name, ev->id);
-
+static void send_processor_notification(uint8_t id, const char *name,
+                                        const struct zmk_input_processor_runtime_config *config) {
     cormoran_rip_Notification notification = cormoran_rip_Notification_init_zero;
     notification.which_notification_type = cormoran_rip_Notification_input_processor_changed_tag;
     notification.notification_type.input_processor_changed.has_processor = true;
     cormoran_rip_InputProcessorInfo *info =
         &notification.notification_type.input_processor_changed.processor;
 
-    info->id = ev->id;
-    strncpy(info->name, ev->name, sizeof(info->name) - 1);
+    info->id = id;
+    strncpy(info->name, name, sizeof(info->name) - 1);
     info->name[sizeof(info->name) - 1] = '\0';
-    info->scale_multiplier = ev->config.scale_multiplier;
-    info->scale_divisor = ev->config.scale_divisor;
-    info->rotation_degrees = ev->config.rotation_degrees;
-    info->temp_layer_enabled = ev->config.temp_layer_enabled;
-    info->temp_layer_layer = ev->config.temp_layer_layer;
-    info->temp_layer_activation_delay_ms = ev->config.temp_layer_activation_delay_ms;
-    info->temp_layer_deactivation_delay_ms = ev->config.temp_layer_deactivation_delay_ms;
-    info->active_layers = ev->config.active_layers;
-    info->axis_snap_mode = ev->config.axis_snap_mode;
-    info->axis_snap_threshold = ev->config.axis_snap_threshold;
-    info->axis_snap_timeout_ms = ev->config.axis_snap_timeout_ms;
-    info->xy_to_scroll_enabled = ev->config.xy_to_scroll_enabled;
-    info->xy_swap_enabled = ev->config.xy_swap_enabled;
-    info->x_invert = ev->config.x_invert;
-    info->y_invert = ev->config.y_invert;
+    info->scale_multiplier = config->scale_multiplier;
+    info->scale_divisor = config->scale_divisor;
+    info->rotation_degrees = config->rotation_degrees;
+    info->temp_layer_enabled = config->temp_layer_enabled;
+    info->temp_layer_layer = config->temp_layer_layer;
+    info->temp_layer_activation_delay_ms = config->temp_layer_activation_delay_ms;
+    info->temp_layer_deactivation_delay_ms = config->temp_layer_deactivation_delay_ms;
+    info->active_layers = config->active_layers;
+    info->axis_snap_mode = config->axis_snap_mode;
+    info->axis_snap_threshold = config->axis_snap_threshold;
+    info->axis_snap_timeout_ms = config->axis_snap_timeout_ms;
+    info->xy_to_scroll_enabled = config->xy_to_scroll_enabled;
+    info->xy_swap_enabled = config->xy_swap_enabled;
+    info->x_invert = config->x_invert;
+    info->y_invert = config->y_invert;
+    info->accel_curve = config->accel_curve;
+    info->accel_speed_max = config->accel_speed_max;
+    info->accel_gain_max = config->accel_gain_max;
+    info->accel_exponent = config->accel_exponent;
+    info->accel_lut_count = config->accel_lut_len;
+    for (int i = 0; i < config->accel_lut_len; i++) {
+        info->accel_lut[i] = config->accel_lut[i];
+    }
+    info->filter_dead_zone = config->filter_dead_zone;
+    info->filter_iir_shift = config->filter_iir_shift;
+    info->filter_idle_ms = config->filter_idle_ms;
+    info->scroll_scale_multiplier = config->scroll_scale_multiplier;
+    info->scroll_scale_divisor = config->scroll_scale_divisor;
+    info->scroll_hires_multiplier = config->scroll_hires_multiplier;
+    info->scroll_snap = config->scroll_snap;
+    info->temp_layer_activation_threshold = config->temp_layer_activation_threshold;
+    info->temp_layer_release_threshold = config->temp_layer_release_threshold;
+    info->temp_layer_motion_window_ms = config->temp_layer_motion_window_ms;
 
     // Send notification via custom studio subsystem
     pb_callback_t encode_cb = {.funcs.encode = encode_notification, .arg = &notification};
@@ -91,7 +107,57 @@ static int input_processor_state_changed_listener(const zmk_event_t *eh) {
     raise_zmk_studio_custom_notification((struct zmk_studio_custom_notification){
         .subsystem_index = find_subsystem_index("cormoran_rip"), .encode_payload = encode_cb});
 
-    LOG_INF("Sent notification for processor %s", ev->name);
+    LOG_INF("Sent notification for processor %s", name);
+}
+
+// Processors (by ID) with a state change not yet sent
+#define NOTIFY_MAX_PROCESSORS 32
+static atomic_t notify_dirty;
+static int64_t notify_last_sent;
+
+// Send the latest state of every dirty processor
+static void notify_work_handler(struct k_work *work) {
+    uint32_t dirty = (uint32_t)atomic_clear(&notify_dirty);
+    notify_last_sent = k_uptime_get();
+
+    while (dirty) {
+        uint8_t id = __builtin_ctz(dirty);
+        dirty &= dirty - 1;
+
+        const struct zmk_input_processor_runtime_entry *entry =
+            zmk_input_processor_runtime_get_entry(id);
+        if (!entry) {
+            continue;
+        }
+
+        send_processor_notification(id, entry->name, entry->config);
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(notify_work, notify_work_handler);
+
+static int input_processor_state_changed_listener(const zmk_event_t *eh) {
+    const struct zmk_input_processor_state_changed *ev = as_zmk_input_processor_state_changed(eh);
+
+    if (!ev) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    LOG_DBG("Input processor state changed: %s (id=%d)", ev->name, ev->id);
+
+    if (ev->id >= NOTIFY_MAX_PROCESSORS) {
+        send_processor_notification(ev->id, ev->name, &ev->config);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    atomic_or(&notify_dirty, BIT(ev->id));
+
+    // Send right away after a quiet period, otherwise at the end of the
+    // current window. Scheduling is a no-op while a send is already pending,
+    // so a burst collapses into one notification per processor.
+    const int64_t window = CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STUDIO_NOTIFY_INTERVAL_MS;
+    int64_t delay = window - (k_uptime_get() - notify_last_sent);
+    k_work_schedule(&notify_work, K_MSEC(CLAMP(delay, 0, window)));
 
     return ZMK_EV_EVENT_BUBBLE;
 }
@@ -99,8 +165,74 @@ static int input_processor_state_changed_listener(const zmk_event_t *eh) {
 ZMK_LISTENER(input_processor_state_listener, input_processor_state_changed_listener);
 ZMK_SUBSCRIPTION(input_processor_state_listener, zmk_input_processor_state_changed);
 
-// NOTE: relay from peripheral is not required because all input-processors can
-// be defined in central side
-//       input-processor should be set to zmk,input-split in central side
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY)
+#define TELEMETRY_BATCH CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_BATCH
+#define TELEMETRY_INTERVAL_MS CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY_INTERVAL_MS
+
+BUILD_ASSERT(TELEMETRY_BATCH <= ARRAY_SIZE(((cormoran_rip_TelemetryNotification *)0)->samples),
+             "TelemetryNotification.samples max_count is too small");
+
+static void send_telemetry_notification(uint8_t id,
+                                        const struct zmk_input_processor_telemetry_sample *samples,
+                                        int count) {
+    cormoran_rip_Notification notification = cormoran_rip_Notification_init_zero;
+    notification.which_notification_type = cormoran_rip_Notification_telemetry_tag;
+    cormoran_rip_TelemetryNotification *telemetry = &notification.notification_type.telemetry;
+
+    telemetry->id = id;
+    telemetry->samples_count = count;
+    for (int i = 0; i < count; i++) {
+        cormoran_rip_TelemetrySample *out = &telemetry->samples[i];
+        out->time_ms = samples[i].time_ms;
+        out->in_x = samples[i].in[0];
+        out->in_y = samples[i].in[1];
+        out->out_x = samples[i].out[0];
+        out->out_y = samples[i].out[1];
+        out->events = samples[i].events;
+        out->snap_axis = samples[i].snap_axis;
+        out->snap_unlocked = samples[i].snap_unlocked;
+        out->temp_layer_active = samples[i].temp_layer_active;
+        out->lost = samples[i].lost;
+    }
+
+    pb_callback_t encode_cb = {.funcs.encode = encode_notification, .arg = &notification};
+    raise_zmk_studio_custom_notification((struct zmk_studio_custom_notification){
+        .subsystem_index = find_subsystem_index("cormoran_rip"), .encode_payload = encode_cb});
+}
+
+static void telemetry_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(telemetry_work, telemetry_work_handler);
+
+// Drain the telemetry rings once per batch of windows, for as long as any
+// processor has telemetry enabled
+static void telemetry_work_handler(struct k_work *work) {
+    struct zmk_input_processor_telemetry_sample samples[TELEMETRY_BATCH];
+    bool streaming = false;
+
+    const struct zmk_input_processor_runtime_entry *entry;
+    for (uint8_t id = 0; (entry = zmk_input_processor_runtime_get_entry(id)) != NULL; id++) {
+        int count;
+        do {
+            count = zmk_input_processor_runtime_read_telemetry(entry->dev, samples,
+                                                               ARRAY_SIZE(samples));
+            if (count > 0) {
+                send_telemetry_notification(id, samples, count);
+            }
+        } while (count == (int)ARRAY_SIZE(samples));
+
+        streaming |= zmk_input_processor_runtime_get_telemetry_enabled(entry->dev);
+    }
+
+    if (streaming) {
+        k_work_schedule(&telemetry_work, K_MSEC(TELEMETRY_INTERVAL_MS * TELEMETRY_BATCH));
+    }
+}
+
+void rip_telemetry_start(void) { k_work_schedule(&telemetry_work, K_NO_WAIT); }
+#endif
+
+// NOTE: relay from peripheral is not required because the central keeps the
+//       configuration of every processor. Processors that run on a split
+//       peripheral (split-relay) get it relayed from the central driver.
 
 #endif // CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STUDIO_RPC
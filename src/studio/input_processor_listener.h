@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @brief Start sending the telemetry of every processor that has it enabled
+ *
+ * Called after telemetry has been enabled for a processor. The telemetry work
+ * keeps running while any processor has telemetry enabled.
+ */
+void rip_telemetry_start(void);
@@ -42,6 +42,19 @@ class WestCommandsTests(unittest.TestCase):
         self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
         self.assertIn("PASS: studio", result.stdout,  result.stdout + result.stderr)
 
+    @unittest.skipUnless(shutil.which("cmake") and shutil.which("ctest"), "cmake is not installed")
+    def test_host_replay(self):
+        host_build = self.BUILD_DIR / "host"
+        shutil.rmtree(host_build, ignore_errors=True)
+
+        for args in (
+            ["cmake", "-S", str(THIS_DIR / "tests" / "host"), "-B", str(host_build)],
+            ["cmake", "--build", str(host_build)],
+            ["ctest", "--test-dir", str(host_build), "--output-on-failure"],
+        ):
+            result = subprocess.run(args, capture_output=True, text=True, cwd=THIS_DIR)
+            self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+
     def test_zmk_build(self):
         artifacts_and_expected_config: dict[str, list[str | NotFound]] = {
             "my_awesome_keyboard_with_custom_rpc_support": [
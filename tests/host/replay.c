@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Host replay and benchmark harness for the runtime input processor.
+//
+// Replays a recorded trace through runtime_processor_handle_event() with the
+// processor configured from the command line, and prints every output event
+// (and temp-layer layer change) so runs can be diffed against golden files.
+// With --bench, the trace is replayed repeatedly without output and the
+// event throughput is reported instead.
+//
+// Trace format (CSV, '#' starts a comment):
+//   <time_ms>,rel,<code>,<value>,<sync>[,<source>]
+//                                         relative input event, from the given
+//                                         trackball (rip_replay_sources, default 0)
+//   <time_ms>,key,<position>,<pressed>    key press / release
+//
+// Output format:
+//   <time_ms>,<code>,<value>              one line per relative input event
+//   <time_ms>,layer,<layer>,<active>      keymap layer changes
+//   <time_ms>,telemetry,<in_x>,<in_y>,<out_x>,<out_y>,<events>,<snap_axis>,<unlocked>,
+//       <temp_layer>,<lost>                 closed telemetry windows (--telemetry)
+//
+// Events that a processor stops are not printed. Input that work items report
+// (coalescing flushes) goes through the processors as well and is printed at
+// the time it is reported. With --peripheral (in the rip_replay_relay build),
+// events go through the given processor, which stands in for the one on a
+// split peripheral, before the configured one, which relays its configuration
+// to it. With --settings, the given record is stored for the processor and
+// loaded through the settings handler, as at boot, before the other options
+// are applied.
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <drivers/behavior.h>
+#include <drivers/input_processor.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/keymap.h>
+#include <zmk/keys.h>
+#include <zmk/pointing/input_processor_runtime.h>
+
+#define TRACE_MAX_EVENTS 65536
+
+enum trace_kind {
+    TRACE_REL,
+    TRACE_KEY,
+};
+
+struct trace_event {
+    uint32_t time_ms;
+    uint8_t kind;
+    uint16_t code; // Input code or key position
+    int32_t value; // Input value or key state
+    bool sync;
+    uint8_t source; // Input device index
+};
+
+#ifdef RIP_HOST_SOURCES
+// The trackballs "mouse" fuses
+const struct device DEVICE_DT_NAME(DT_N_S_trackball_0) = {.name = "trackball_0"};
+const struct device DEVICE_DT_NAME(DT_N_S_trackball_1) = {.name = "trackball_1"};
+
+static const struct device *const trace_sources[] = {
+    DEVICE_DT_GET(DT_N_S_trackball_0),
+    DEVICE_DT_GET(DT_N_S_trackball_1),
+};
+#else
+static const struct device *const trace_sources[] = {NULL};
+#endif
+
+static struct trace_event trace[TRACE_MAX_EVENTS];
+static size_t trace_len;
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [options] <trace.csv>\n"
+            "  --processor NAME          processor to configure (default: mouse)\n"
+            "  --peripheral NAME         processor that runs the relayed configuration\n"
+            "  --scale MUL/DIV           scaling\n"
+            "  --rotation DEG            rotation in degrees\n"
+            "  --invert X,Y              axis inversion (0/1 each)\n"
+            "  --swap                    swap X and Y\n"
+            "  --scroll                  map X/Y to scroll\n"
+            "  --scroll-scale MUL,DIV,HIRES,SNAP\n"
+            "                            scroll sub-pipeline\n"
+            "  --snap MODE,THR,TIMEOUT   axis snap\n"
+            "  --accel CURVE,SPEED,GAIN,EXP\n"
+            "                            pointer acceleration\n"
+            "  --lut G1,G2,...           acceleration lookup table gains\n"
+            "  --filter DZ,SHIFT,IDLE    jitter filter dead zone, smoothing and idle (ms)\n"
+            "  --temp-layer L,ACT,DEACT  temp-layer layer and delays (ms)\n"
+            "  --temp-layer-motion ACT,REL,WINDOW\n"
+            "                            temp-layer motion thresholds and window (ms)\n"
+            "  --telemetry               print the telemetry windows\n"
+            "  --settings HEX            load a stored settings record for the processor\n"
+            "  --bench N                 replay N times and report throughput\n",
+            argv0);
+}
+
+static int parse_list(const char *arg, long *out, int max) {
+    int n = 0;
+    char *end;
+
+    while (n < max) {
+        out[n++] = strtol(arg, &end, 10);
+        if (end == arg) {
+            return -1;
+        }
+        if (*end == '\0') {
+            return n;
+        }
+        if (*end != ',' && *end != '/') {
+            return -1;
+        }
+        arg = end + 1;
+    }
+    return -1;
+}
+
+static int load_trace(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    char line[128];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+        if (strspn(line, " \t\r\n") == strlen(line)) {
+            continue;
+        }
+        if (trace_len >= TRACE_MAX_EVENTS) {
+            fprintf(stderr, "%s: more than %d events\n", path, TRACE_MAX_EVENTS);
+            fclose(f);
+            return -1;
+        }
+
+        struct trace_event *ev = &trace[trace_len];
+        unsigned int time_ms, code, source = 0;
+        int value, sync = 0;
+        char kind[8];
+        if (sscanf(line, "%u,%7[a-z],%u,%d,%d,%u", &time_ms, kind, &code, &value, &sync,
+                   &source) < 4) {
+            fprintf(stderr, "%s:%d: malformed line\n", path, lineno);
+            fclose(f);
+            return -1;
+        }
+        if (source >= ARRAY_SIZE(trace_sources)) {
+            fprintf(stderr, "%s:%d: unknown source %u\n", path, lineno, source);
+            fclose(f);
+            return -1;
+        }
+        ev->time_ms = time_ms;
+        ev->code = code;
+        ev->value = value;
+        ev->sync = sync != 0;
+        ev->source = source;
+        if (strcmp(kind, "rel") == 0) {
+            ev->kind = TRACE_REL;
+        } else if (strcmp(kind, "key") == 0) {
+            ev->kind = TRACE_KEY;
+        } else {
+            fprintf(stderr, "%s:%d: unknown event kind '%s'\n", path, lineno, kind);
+            fclose(f);
+            return -1;
+        }
+        trace_len++;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+static int apply_option(const struct device *dev, struct zmk_input_processor_runtime_config *c,
+                        uint32_t *mask, const char *opt, const char *arg) {
+    long v[ZMK_INPUT_PROCESSOR_ACCEL_LUT_MAX_POINTS];
+    int n = arg ? parse_list(arg, v, ARRAY_SIZE(v)) : 0;
+
+    if (strcmp(opt, "--scale") == 0 && n == 2) {
+        c->scale_multiplier = v[0];
+        c->scale_divisor = v[1];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_SCALE_MULTIPLIER |
+                 ZMK_INPUT_PROCESSOR_CONFIG_SCALE_DIVISOR;
+    } else if (strcmp(opt, "--rotation") == 0 && n == 1) {
+        c->rotation_degrees = v[0];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_ROTATION_DEGREES;
+    } else if (strcmp(opt, "--invert") == 0 && n == 2) {
+        c->x_invert = v[0] != 0;
+        c->y_invert = v[1] != 0;
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_X_INVERT | ZMK_INPUT_PROCESSOR_CONFIG_Y_INVERT;
+    } else if (strcmp(opt, "--swap") == 0) {
+        c->xy_swap_enabled = true;
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_XY_SWAP_ENABLED;
+    } else if (strcmp(opt, "--scroll") == 0) {
+        c->xy_to_scroll_enabled = true;
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_XY_TO_SCROLL_ENABLED;
+    } else if (strcmp(opt, "--snap") == 0 && n == 3) {
+        c->axis_snap_mode = v[0];
+        c->axis_snap_threshold = v[1];
+        c->axis_snap_timeout_ms = v[2];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_MODE |
+                 ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_THRESHOLD |
+                 ZMK_INPUT_PROCESSOR_CONFIG_AXIS_SNAP_TIMEOUT;
+    } else if (strcmp(opt, "--accel") == 0 && n == 4) {
+        c->accel_curve = v[0];
+        c->accel_speed_max = v[1];
+        c->accel_gain_max = v[2];
+        c->accel_exponent = v[3];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_CURVE |
+                 ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_SPEED_MAX |
+                 ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_GAIN_MAX |
+                 ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_EXPONENT;
+    } else if (strcmp(opt, "--lut") == 0 && n >= 1) {
+        c->accel_lut_len = n;
+        for (int i = 0; i < n; i++) {
+            c->accel_lut[i] = v[i];
+        }
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_ACCEL_LUT;
+    } else if (strcmp(opt, "--scroll-scale") == 0 && n == 4) {
+        c->scroll_scale_multiplier = v[0];
+        c->scroll_scale_divisor = v[1];
+        c->scroll_hires_multiplier = v[2];
+        c->scroll_snap = v[3] != 0;
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_MULTIPLIER |
+                 ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SCALE_DIVISOR |
+                 ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_HIRES | ZMK_INPUT_PROCESSOR_CONFIG_SCROLL_SNAP;
+    } else if (strcmp(opt, "--filter") == 0 && n == 3) {
+        c->filter_dead_zone = v[0];
+        c->filter_iir_shift = v[1];
+        c->filter_idle_ms = v[2];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_FILTER_DEAD_ZONE |
+                 ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IIR_SHIFT |
+                 ZMK_INPUT_PROCESSOR_CONFIG_FILTER_IDLE;
+    } else if (strcmp(opt, "--temp-layer") == 0 && n == 3) {
+        c->temp_layer_enabled = true;
+        c->temp_layer_layer = v[0];
+        c->temp_layer_activation_delay_ms = v[1];
+        c->temp_layer_deactivation_delay_ms = v[2];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ENABLED |
+                 ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_LAYER |
+                 ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_DELAY |
+                 ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_DEACTIVATION_DELAY;
+    } else if (strcmp(opt, "--temp-layer-motion") == 0 && n == 3) {
+        c->temp_layer_activation_threshold = v[0];
+        c->temp_layer_release_threshold = v[1];
+        c->temp_layer_motion_window_ms = v[2];
+        *mask |= ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_ACTIVATION_THRESHOLD |
+                 ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_RELEASE_THRESHOLD |
+                 ZMK_INPUT_PROCESSOR_CONFIG_TEMP_LAYER_MOTION_WINDOW;
+    } else {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+// Layer changes are printed as they happen, relative to the replay start
+static bool print_layers;
+static uint32_t replay_base_ms;
+
+static int layer_state_changed_listener(const zmk_event_t *eh) {
+    const struct zmk_layer_state_changed *ev = as_zmk_layer_state_changed(eh);
+    if (ev && print_layers) {
+        printf("%u,layer,%u,%d\n", (uint32_t)(ev->timestamp - replay_base_ms), ev->layer,
+               ev->state);
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(replay_layer_listener, layer_state_changed_listener);
+ZMK_SUBSCRIPTION(replay_layer_listener, zmk_layer_state_changed);
+
+// Processor on the "peripheral" side of dev, or NULL
+static const struct device *peripheral_dev;
+
+// Print the telemetry windows of dev closed so far, as the Studio work would send them
+static bool print_telemetry;
+
+static void drain_telemetry(const struct device *dev) {
+    struct zmk_input_processor_telemetry_sample samples[4];
+    int n;
+
+    do {
+        n = zmk_input_processor_runtime_read_telemetry(dev, samples, ARRAY_SIZE(samples));
+        for (int i = 0; i < n; i++) {
+            const struct zmk_input_processor_telemetry_sample *s = &samples[i];
+            printf("%u,telemetry,%d,%d,%d,%d,%u,%d,%d,%d,%u\n", s->time_ms - replay_base_ms,
+                   s->in[0], s->in[1], s->out[0], s->out[1], s->events, s->snap_axis,
+                   s->snap_unlocked, s->temp_layer_active, s->lost);
+        }
+    } while (n == ARRAY_SIZE(samples));
+}
+
+static int handle_event(const struct device *dev, struct input_event *ev,
+                        struct zmk_input_processor_state *state) {
+    const struct zmk_input_processor_driver_api *api = dev->api;
+    return api->handle_event(dev, ev, 0, 0, state);
+}
+
+static int16_t replay_remainder;
+static struct zmk_input_processor_state replay_state = {.remainder = &replay_remainder};
+static bool print_events;
+
+// Run an event through the processors and print it unless one stops it
+static void route_event(const struct device *dev, struct input_event *ev, uint32_t time_ms) {
+    int ret = ZMK_INPUT_PROC_CONTINUE;
+    if (peripheral_dev) {
+        ret = handle_event(peripheral_dev, ev, &replay_state);
+    }
+    if (ret == ZMK_INPUT_PROC_CONTINUE) {
+        ret = handle_event(dev, ev, &replay_state);
+    }
+    if (print_events && ret == ZMK_INPUT_PROC_CONTINUE) {
+        printf("%u,%u,%d\n", time_ms, ev->code, ev->value);
+    }
+}
+
+// Processor the trace is replayed through, which work items report input to
+static const struct device *replay_dev;
+
+// Input reported by work items (coalescing flushes) goes through the same
+// processors as the trace
+int input_report(const struct device *dev, uint8_t type, uint16_t code, int32_t value, bool sync,
+                 k_timeout_t timeout) {
+    struct input_event ev = {.dev = dev, .type = type, .code = code, .value = value, .sync = sync};
+    route_event(replay_dev, &ev, k_uptime_get_32() - replay_base_ms);
+    return 0;
+}
+
+// Replay the trace starting at virtual time base_ms. Returns the number of
+// relative input events handled.
+static size_t replay(const struct device *dev, uint32_t base_ms, bool print) {
+    uint32_t now = base_ms;
+    size_t handled = 0;
+
+    replay_dev = dev;
+    replay_remainder = 0;
+    print_layers = print;
+    print_events = print;
+    replay_base_ms = base_ms;
+
+    for (size_t i = 0; i < trace_len; i++) {
+        const struct trace_event *t = &trace[i];
+        uint32_t at = base_ms + t->time_ms;
+        if (at > now) {
+            shim_advance_time_ms(at - now);
+            now = at;
+        }
+
+        if (t->kind == TRACE_KEY) {
+            raise_zmk_position_state_changed((struct zmk_position_state_changed){
+                .position = t->code, .state = t->value != 0, .timestamp = now});
+            raise_zmk_keycode_state_changed((struct zmk_keycode_state_changed){
+                .usage_page = HID_USAGE_KEY, .keycode = 0x04, .state = t->value != 0,
+                .timestamp = now});
+        } else {
+            struct input_event ev = {.dev = trace_sources[t->source],
+                                     .type = INPUT_EV_REL,
+                                     .code = t->code,
+                                     .value = t->value,
+                                     .sync = t->sync};
+            route_event(dev, &ev, t->time_ms);
+            handled++;
+        }
+        // Work submitted from the event path runs before the next event
+        shim_run_pending_work();
+        if (print && print_telemetry) {
+            drain_telemetry(dev);
+        }
+    }
+    return handled;
+}
+
+extern const struct settings_handler_static settings_handler_input_proc;
+
+// Store a settings record (hex bytes) for the processor and load it
+static int load_settings(const char *processor, const char *hex) {
+    uint8_t buf[256];
+    size_t len = strlen(hex) / 2;
+    if (strlen(hex) % 2 != 0 || len > sizeof(buf)) {
+        return -EINVAL;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char byte[3] = {hex[2 * i], hex[2 * i + 1], '\0'};
+        char *end;
+        buf[i] = strtoul(byte, &end, 16);
+        if (*end != '\0') {
+            return -EINVAL;
+        }
+    }
+
+    char key[64];
+    snprintf(key, sizeof(key), "input_proc/%s", processor);
+    int ret = settings_save_one(key, buf, len);
+    return ret < 0 ? ret : shim_settings_load(&settings_handler_input_proc);
+}
+
+static int init_processor(const struct device *dev, void *user_data) {
+    return dev->init(dev);
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    const char *processor = "mouse";
+    const char *peripheral = NULL;
+    const char *trace_path = NULL;
+    const char *settings = NULL;
+    long bench = 0;
+
+    // Options are applied after the processor is known, so collect them first
+    const char *opts[32][2];
+    int opts_len = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        bool has_arg = strcmp(opt, "--swap") != 0 && strcmp(opt, "--scroll") != 0 &&
+                       strcmp(opt, "--telemetry") != 0;
+        if (strncmp(opt, "--", 2) != 0) {
+            trace_path = opt;
+            continue;
+        }
+        if (has_arg && i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(opt, "--processor") == 0) {
+            processor = argv[++i];
+        } else if (strcmp(opt, "--peripheral") == 0) {
+            peripheral = argv[++i];
+        } else if (strcmp(opt, "--bench") == 0) {
+            bench = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(opt, "--telemetry") == 0) {
+            print_telemetry = true;
+        } else if (strcmp(opt, "--settings") == 0) {
+            settings = argv[++i];
+        } else if (opts_len < (int)ARRAY_SIZE(opts)) {
+            opts[opts_len][0] = opt;
+            opts[opts_len][1] = has_arg ? argv[++i] : NULL;
+            opts_len++;
+        }
+    }
+    if (!trace_path || load_trace(trace_path) < 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Device init, as the kernel would run it at boot
+    zmk_input_processor_runtime_foreach(init_processor, NULL);
+    shim_init_behaviors();
+
+    const struct device *dev = zmk_input_processor_runtime_find_by_name(processor);
+    if (!dev) {
+        fprintf(stderr, "unknown processor '%s'\n", processor);
+        return 2;
+    }
+    if (peripheral) {
+        peripheral_dev = zmk_input_processor_runtime_find_by_name(peripheral);
+        if (!peripheral_dev) {
+            fprintf(stderr, "unknown processor '%s'\n", peripheral);
+            return 2;
+        }
+    }
+
+    if (settings && load_settings(processor, settings) < 0) {
+        fprintf(stderr, "settings record rejected\n");
+        return 2;
+    }
+
+    struct zmk_input_processor_runtime_config config;
+    uint32_t mask = 0;
+    zmk_input_processor_runtime_get_config(dev, NULL, &config);
+    for (int i = 0; i < opts_len; i++) {
+        if (apply_option(dev, &config, &mask, opts[i][0], opts[i][1]) < 0) {
+            fprintf(stderr, "invalid option %s %s\n", opts[i][0], opts[i][1] ? opts[i][1] : "");
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    int ret = zmk_input_processor_runtime_set_config(dev, &config, mask, false);
+    if (ret < 0) {
+        fprintf(stderr, "configuration rejected: %d\n", ret);
+        return 2;
+    }
+    if (print_telemetry) {
+        ret = zmk_input_processor_runtime_set_telemetry(dev, true);
+        if (ret < 0) {
+            fprintf(stderr, "telemetry rejected: %d\n", ret);
+            return 2;
+        }
+    }
+    // Relayed configuration reaches the peripheral before the first event
+    shim_run_pending_work();
+
+    if (bench <= 0) {
+        replay(dev, 0, true);
+        return 0;
+    }
+
+    // Space the repetitions so that each one starts an independent gesture
+    uint32_t span = trace_len > 0 ? trace[trace_len - 1].time_ms + 1000 : 1000;
+    size_t events = 0;
+    uint64_t start = monotonic_ns();
+    for (long i = 0; i < bench; i++) {
+        events += replay(dev, (uint32_t)i * span, false);
+    }
+    uint64_t elapsed = monotonic_ns() - start;
+
+    printf("events: %zu\n", events);
+    printf("events/s: %.0f\n", events * 1e9 / (elapsed ? elapsed : 1));
+    printf("ns/event: %.1f\n", events ? (double)elapsed / events : 0.0);
+    return 0;
+}
@@ -0,0 +1,27 @@
+# Run one replay and compare its output with the golden file (see CMakeLists.txt)
+
+separate_arguments(ARGS)
+get_filename_component(OUTPUT_DIR ${OUTPUT} DIRECTORY)
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+execute_process(
+    COMMAND ${REPLAY} ${ARGS} ${TRACE}
+    OUTPUT_FILE ${OUTPUT}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${REPLAY} exited with ${result}")
+endif()
+
+if(UPDATE)
+    configure_file(${OUTPUT} ${GOLDEN} COPYONLY)
+    return()
+endif()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT} ${GOLDEN}
+    RESULT_VARIABLE differs
+)
+if(differs)
+    message(FATAL_ERROR "Output ${OUTPUT} differs from ${GOLDEN}")
+endif()
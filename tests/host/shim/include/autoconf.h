@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Kconfig values for the host build (stands in for the generated autoconf.h)
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_NAME_MAX_LEN 8
+#define CONFIG_SETTINGS 1
+#define CONFIG_ZMK_SETTINGS_SAVE_DEBOUNCE 60000
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILES 3
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_PROFILE_NAME_MAX_LEN 12
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SETTINGS_SAVE_IDLE_MS 500
+#define CONFIG_ZMK_LOG_LEVEL 4
+#define CONFIG_KERNEL_INIT_PRIORITY_DEFAULT 40
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_OVERFLOW_COUNTER 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_AXIS_SNAP_AUTO_COUNTS 8
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_AXIS_SNAP_AUTO_GAP_MS 100
+
+// Optional stages, left out by the rip_replay_minimal variant
+#ifndef RIP_HOST_MINIMAL
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_ROTATION 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_AXIS_SNAP 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_ACCEL 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_FILTER 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SCROLL 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TEMP_LAYER 1
+#endif
+
+// Split halves: rip_replay_relay is a central that relays processors to a
+// peripheral, rip_replay_peripheral the peripheral that runs them
+#if defined(RIP_HOST_RELAY) || defined(RIP_HOST_PERIPHERAL)
+#define CONFIG_ZMK_SPLIT 1
+#define CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_SPLIT_RELAY 1
+#endif
+#ifdef RIP_HOST_RELAY
+#define CONFIG_ZMK_SPLIT_ROLE_CENTRAL 1
+#endif
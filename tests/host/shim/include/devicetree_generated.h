@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Devicetree used by the host build: the two processors from
+// dts/input/processors/runtime-input-processor.dtsi ("mouse" and "scroll"),
+// with rotation-frame-sync enabled on "mouse". rip_replay_coalesce also sets
+// coalesce-interval-ms on "mouse", and rip_replay_sources has "mouse" fuse two
+// trackballs, the second one mounted at 90 degrees with twice the resolution.
+
+#ifndef RIP_HOST_RELAY
+#define DT_FOREACH_OKAY_INST_zmk_input_processor_runtime(fn) fn(0) fn(1)
+#define DT_N_INST_zmk_input_processor_runtime_NUM_OKAY 2
+#else
+#define DT_FOREACH_OKAY_INST_zmk_input_processor_runtime(fn) fn(0) fn(1) fn(2)
+#define DT_N_INST_zmk_input_processor_runtime_NUM_OKAY 3
+#endif
+#define DT_COMPAT_HAS_OKAY_zmk_input_processor_runtime 1
+
+#define DT_N_INST_0_zmk_input_processor_runtime_P_processor_label "mouse"
+#define DT_N_INST_0_zmk_input_processor_runtime_P_processor_label_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_type 2
+#define DT_N_INST_0_zmk_input_processor_runtime_P_type_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_codes {0}
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_codes_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_codes_LEN 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_codes_IDX_0 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_codes_FOREACH_PROP_ELEM_SEP(fn, sep)            \
+    fn(DT_N_INST_0_zmk_input_processor_runtime, x_codes, 0)
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_codes_FOREACH_PROP_ELEM(fn)                    \
+    fn(DT_N_INST_0_zmk_input_processor_runtime, x_codes, 0)
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_codes {1}
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_codes_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_codes_LEN 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_codes_IDX_0 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_codes_FOREACH_PROP_ELEM_SEP(fn, sep)            \
+    fn(DT_N_INST_0_zmk_input_processor_runtime, y_codes, 0)
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_codes_FOREACH_PROP_ELEM(fn)                    \
+    fn(DT_N_INST_0_zmk_input_processor_runtime, y_codes, 0)
+#define DT_N_INST_0_zmk_input_processor_runtime_P_scale_multiplier 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_scale_multiplier_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_scale_divisor 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_scale_divisor_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_rotation_degrees 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_rotation_degrees_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_rotation_frame_sync 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_track_remainders 1
+#ifdef RIP_HOST_COALESCE
+#define DT_N_INST_0_zmk_input_processor_runtime_P_coalesce_interval_ms 16
+#else
+#define DT_N_INST_0_zmk_input_processor_runtime_P_coalesce_interval_ms 0
+#endif
+#define DT_N_INST_0_zmk_input_processor_runtime_P_temp_layer_enabled 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_xy_to_scroll_enabled 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_xy_swap_enabled 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_x_invert 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_y_invert 0
+#ifdef RIP_HOST_SOURCES
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_devices_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_devices_LEN 2
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_devices_IDX_0 DT_N_S_trackball_0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_devices_IDX_1 DT_N_S_trackball_1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_devices_FOREACH_PROP_ELEM(fn)             \
+    fn(DT_N_INST_0_zmk_input_processor_runtime, source_devices, 0)                                 \
+        fn(DT_N_INST_0_zmk_input_processor_runtime, source_devices, 1)
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_rotation_degrees {0, 90}
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_rotation_degrees_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_rotation_degrees_LEN 2
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_rotation_degrees_IDX_0 0
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_rotation_degrees_IDX_1 90
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_scale_divisors {1, 2}
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_scale_divisors_EXISTS 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_scale_divisors_LEN 2
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_scale_divisors_IDX_0 1
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_scale_divisors_IDX_1 2
+#define DT_N_INST_0_zmk_input_processor_runtime_P_source_scale_divisors_FOREACH_PROP_ELEM(fn)      \
+    fn(DT_N_INST_0_zmk_input_processor_runtime, source_scale_divisors, 0)                          \
+        fn(DT_N_INST_0_zmk_input_processor_runtime, source_scale_divisors, 1)
+#endif
+
+#define DT_N_INST_1_zmk_input_processor_runtime_P_processor_label "scroll"
+#define DT_N_INST_1_zmk_input_processor_runtime_P_processor_label_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_type 2
+#define DT_N_INST_1_zmk_input_processor_runtime_P_type_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_codes {6}
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_codes_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_codes_LEN 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_codes_IDX_0 6
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_codes_FOREACH_PROP_ELEM_SEP(fn, sep)            \
+    fn(DT_N_INST_1_zmk_input_processor_runtime, x_codes, 0)
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_codes_FOREACH_PROP_ELEM(fn)                    \
+    fn(DT_N_INST_1_zmk_input_processor_runtime, x_codes, 0)
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_codes {8}
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_codes_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_codes_LEN 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_codes_IDX_0 8
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_codes_FOREACH_PROP_ELEM_SEP(fn, sep)            \
+    fn(DT_N_INST_1_zmk_input_processor_runtime, y_codes, 0)
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_codes_FOREACH_PROP_ELEM(fn)                    \
+    fn(DT_N_INST_1_zmk_input_processor_runtime, y_codes, 0)
+#define DT_N_INST_1_zmk_input_processor_runtime_P_scale_multiplier 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_scale_multiplier_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_scale_divisor 60
+#define DT_N_INST_1_zmk_input_processor_runtime_P_scale_divisor_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_rotation_degrees 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_rotation_degrees_EXISTS 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_rotation_frame_sync 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_track_remainders 1
+#define DT_N_INST_1_zmk_input_processor_runtime_P_coalesce_interval_ms 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_temp_layer_enabled 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_xy_to_scroll_enabled 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_xy_swap_enabled 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_x_invert 0
+#define DT_N_INST_1_zmk_input_processor_runtime_P_y_invert 0
+
+// rip_replay_relay: "mirror" is the central side of "mouse", which stands in
+// for the processor on the peripheral and is configured through the relay
+// behavior
+#ifdef RIP_HOST_RELAY
+#define DT_N_INST_2_zmk_input_processor_runtime_P_processor_label "mirror"
+#define DT_N_INST_2_zmk_input_processor_runtime_P_processor_label_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_type 2
+#define DT_N_INST_2_zmk_input_processor_runtime_P_type_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_codes {0}
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_codes_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_codes_LEN 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_codes_IDX_0 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_codes_FOREACH_PROP_ELEM_SEP(fn, sep)            \
+    fn(DT_N_INST_2_zmk_input_processor_runtime, x_codes, 0)
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_codes_FOREACH_PROP_ELEM(fn)                    \
+    fn(DT_N_INST_2_zmk_input_processor_runtime, x_codes, 0)
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_codes {1}
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_codes_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_codes_LEN 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_codes_IDX_0 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_codes_FOREACH_PROP_ELEM_SEP(fn, sep)            \
+    fn(DT_N_INST_2_zmk_input_processor_runtime, y_codes, 0)
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_codes_FOREACH_PROP_ELEM(fn)                    \
+    fn(DT_N_INST_2_zmk_input_processor_runtime, y_codes, 0)
+#define DT_N_INST_2_zmk_input_processor_runtime_P_scale_multiplier 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_scale_multiplier_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_scale_divisor 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_scale_divisor_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_rotation_degrees 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_rotation_degrees_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_rotation_frame_sync 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_track_remainders 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_coalesce_interval_ms 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_temp_layer_enabled 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_xy_to_scroll_enabled 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_xy_swap_enabled 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_x_invert 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_y_invert 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_split_relay                                      \
+    DT_N_INST_0_zmk_behavior_input_processor_relay
+#define DT_N_INST_2_zmk_input_processor_runtime_P_split_relay_EXISTS 1
+#define DT_N_INST_2_zmk_input_processor_runtime_P_split_relay_source 0
+#define DT_N_INST_2_zmk_input_processor_runtime_P_split_relay_source_EXISTS 1
+
+#define DT_FOREACH_OKAY_INST_zmk_behavior_input_processor_relay(fn) fn(0)
+#define DT_N_INST_zmk_behavior_input_processor_relay_NUM_OKAY 1
+#define DT_COMPAT_HAS_OKAY_zmk_behavior_input_processor_relay 1
+
+#define DT_N_INST_0_zmk_behavior_input_processor_relay_P_processor                                 \
+    DT_N_INST_0_zmk_input_processor_runtime
+#define DT_N_INST_0_zmk_behavior_input_processor_relay_P_processor_EXISTS 1
+
+// Devices referenced by phandle from another translation unit
+#define DT_FOREACH_EXTERN_DEVICE(fn)                                                               \
+    fn(DT_N_INST_0_zmk_input_processor_runtime) fn(DT_N_INST_0_zmk_behavior_input_processor_relay)
+#elif defined(RIP_HOST_SOURCES)
+// The trackballs fused by "mouse", defined by the replay harness
+#define DT_FOREACH_EXTERN_DEVICE(fn) fn(DT_N_S_trackball_0) fn(DT_N_S_trackball_1)
+#else
+#define DT_FOREACH_EXTERN_DEVICE(fn)
+#endif
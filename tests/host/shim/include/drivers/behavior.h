@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/behavior.h>
+
+// Behaviors register themselves so zmk_behavior_get_binding() can find them
+// by name, and are initialized by shim_init_behaviors()
+void shim_register_behavior(const struct device *dev);
+void shim_init_behaviors(void);
+
+#define BEHAVIOR_DT_INST_DEFINE(inst, init_fn, pm, data_ptr, cfg_ptr, level, prio, api_ptr, ...)   \
+    DEVICE_DT_INST_DEFINE(inst, init_fn, pm, data_ptr, cfg_ptr, level, prio, api_ptr);             \
+    __attribute__((constructor)) static void UTIL_CAT(shim_register_behavior_, inst)(void) {       \
+        shim_register_behavior(DEVICE_DT_INST_GET(inst));                                          \
+    }
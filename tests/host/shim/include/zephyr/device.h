@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+
+struct device {
+    const char *name;
+    const void *config;
+    const void *api;
+    void *data;
+    int (*init)(const struct device *dev);
+};
+
+#define DEVICE_DT_NAME(node_id) Z_DEVICE_NAME(node_id)
+#define Z_DEVICE_NAME(node_id) __device_##node_id
+
+// Stands in for the device declarations Zephyr generates for every node
+#define Z_DEVICE_EXTERN(node_id) extern const struct device Z_DEVICE_NAME(node_id);
+DT_FOREACH_EXTERN_DEVICE(Z_DEVICE_EXTERN)
+
+#define DEVICE_DT_GET(node_id) (&DEVICE_DT_NAME(node_id))
+#define DEVICE_DT_INST_GET(inst) DEVICE_DT_GET(DT_DRV_INST(inst))
+#define DEVICE_DT_INST_DEFINE(inst, init_fn, pm, data_ptr, cfg_ptr, level, prio, api_ptr, ...)     \
+    Z_DEVICE_DT_DEFINE(DT_DRV_INST(inst), init_fn, data_ptr, cfg_ptr, api_ptr)
+#define Z_DEVICE_DT_DEFINE(node_id, init_fn, data_ptr, cfg_ptr, api_ptr)                           \
+    const struct device DEVICE_DT_NAME(node_id) = {                                                \
+        .name = #node_id,                                                                          \
+        .config = (cfg_ptr),                                                                       \
+        .api = (api_ptr),                                                                          \
+        .data = (data_ptr),                                                                        \
+        .init = (init_fn),                                                                         \
+    }
+
+static inline bool device_is_ready(const struct device *dev) { return dev != NULL; }
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Minimal devicetree macro layer. Instances are described by the harness in
+// devicetree_generated.h using the naming scheme below, which mirrors (a much
+// reduced form of) Zephyr's generated DT_N_* tokens.
+
+#include <zephyr/sys/util.h>
+#include <devicetree_generated.h>
+
+#define DT_DRV_INST(inst) UTIL_CAT(DT_N_INST_, UTIL_CAT(inst, UTIL_CAT(_, DT_DRV_COMPAT)))
+
+#define DT_PROP(node_id, prop) Z_DT_PROP(node_id, prop)
+#define Z_DT_PROP(node_id, prop) node_id##_P_##prop
+#define DT_PROP_LEN(node_id, prop) Z_DT_PROP_LEN(node_id, prop)
+#define Z_DT_PROP_LEN(node_id, prop) node_id##_P_##prop##_LEN
+#define DT_PROP_BY_IDX(node_id, prop, idx) Z_DT_PROP_BY_IDX(node_id, prop, idx)
+#define Z_DT_PROP_BY_IDX(node_id, prop, idx) node_id##_P_##prop##_IDX_##idx
+#define DT_NODE_HAS_PROP(node_id, prop) Z_DT_NODE_HAS_PROP(node_id, prop)
+#define Z_DT_NODE_HAS_PROP(node_id, prop) IS_ENABLED(node_id##_P_##prop##_EXISTS)
+#define DT_PROP_OR(node_id, prop, default_value)                                                   \
+    COND_CODE_1(DT_NODE_HAS_PROP(node_id, prop), (DT_PROP(node_id, prop)), (default_value))
+#define DT_PROP_LEN_OR(node_id, prop, default_value)                                               \
+    COND_CODE_1(DT_NODE_HAS_PROP(node_id, prop), (DT_PROP_LEN(node_id, prop)), (default_value))
+#define DT_PHANDLE(node_id, prop) DT_PROP(node_id, prop)
+#define DT_PHANDLE_BY_IDX(node_id, prop, idx) DT_PROP_BY_IDX(node_id, prop, idx)
+#define DT_FOREACH_PROP_ELEM_SEP(node_id, prop, fn, sep)                                           \
+    Z_DT_FOREACH_PROP_ELEM_SEP(node_id, prop, fn, sep)
+#define Z_DT_FOREACH_PROP_ELEM_SEP(node_id, prop, fn, sep)                                         \
+    node_id##_P_##prop##_FOREACH_PROP_ELEM_SEP(fn, sep)
+#define DT_FOREACH_PROP_ELEM(node_id, prop, fn) Z_DT_FOREACH_PROP_ELEM(node_id, prop, fn)
+#define Z_DT_FOREACH_PROP_ELEM(node_id, prop, fn) node_id##_P_##prop##_FOREACH_PROP_ELEM(fn)
+
+#define DT_INST_PROP(inst, prop) DT_PROP(DT_DRV_INST(inst), prop)
+#define DT_INST_PROP_LEN(inst, prop) DT_PROP_LEN(DT_DRV_INST(inst), prop)
+#define DT_INST_PROP_BY_IDX(inst, prop, idx) DT_PROP_BY_IDX(DT_DRV_INST(inst), prop, idx)
+#define DT_INST_PROP_OR(inst, prop, default_value)                                                 \
+    DT_PROP_OR(DT_DRV_INST(inst), prop, default_value)
+#define DT_INST_PROP_LEN_OR(inst, prop, default_value)                                             \
+    DT_PROP_LEN_OR(DT_DRV_INST(inst), prop, default_value)
+#define DT_INST_NODE_HAS_PROP(inst, prop) DT_NODE_HAS_PROP(DT_DRV_INST(inst), prop)
+#define DT_INST_PHANDLE(inst, prop) DT_PHANDLE(DT_DRV_INST(inst), prop)
+#define DT_INST_FOREACH_PROP_ELEM_SEP(inst, prop, fn, sep)                                         \
+    DT_FOREACH_PROP_ELEM_SEP(DT_DRV_INST(inst), prop, fn, sep)
+#define DT_INST_FOREACH_PROP_ELEM(inst, prop, fn) DT_FOREACH_PROP_ELEM(DT_DRV_INST(inst), prop, fn)
+
+#define DT_INST_FOREACH_STATUS_OKAY(fn) UTIL_CAT(DT_FOREACH_OKAY_INST_, DT_DRV_COMPAT)(fn)
+#define DT_FOREACH_STATUS_OKAY(compat, fn)                                                         \
+    COND_CODE_1(DT_HAS_COMPAT_STATUS_OKAY(compat), (UTIL_CAT(DT_FOREACH_OKAY_, compat)(fn)), ())
+#define DT_HAS_COMPAT_STATUS_OKAY(compat) IS_ENABLED(UTIL_CAT(DT_COMPAT_HAS_OKAY_, compat))
+#define DT_NUM_INST_STATUS_OKAY(compat) UTIL_CAT(DT_N_INST_, UTIL_CAT(compat, _NUM_OKAY))
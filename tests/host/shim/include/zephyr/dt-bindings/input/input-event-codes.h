@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#define INPUT_EV_KEY 0x01
+#define INPUT_EV_REL 0x02
+#define INPUT_EV_ABS 0x03
+
+#define INPUT_REL_X 0x00
+#define INPUT_REL_Y 0x01
+#define INPUT_REL_Z 0x02
+#define INPUT_REL_RX 0x03
+#define INPUT_REL_RY 0x04
+#define INPUT_REL_RZ 0x05
+#define INPUT_REL_HWHEEL 0x06
+#define INPUT_REL_DIAL 0x07
+#define INPUT_REL_WHEEL 0x08
+#define INPUT_REL_MISC 0x09
+#define INPUT_REL_MAX 0x0f
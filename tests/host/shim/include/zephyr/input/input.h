@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/dt-bindings/input/input-event-codes.h>
+
+struct input_event {
+    const struct device *dev;
+    uint8_t sync;
+    uint8_t type;
+    uint16_t code;
+    int32_t value;
+};
+
+// Provided by the harness, which stands in for the input listener
+int input_report(const struct device *dev, uint8_t type, uint16_t code, int32_t value, bool sync,
+                 k_timeout_t timeout);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Host implementation of the <zephyr/kernel.h> subset used by the module.
+// Time is virtual and only advances through shim_advance_time_ms(); delayable
+// work items run synchronously from there, in deadline order.
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/atomic.h>
+
+typedef struct {
+    int64_t ms;
+} k_timeout_t;
+
+// The shim kernel ticks once per millisecond
+typedef int64_t k_ticks_t;
+static inline uint32_t k_ticks_to_ms_ceil32(k_ticks_t t) {
+    return (uint32_t)t;
+}
+
+#define K_MSEC(ms_) ((k_timeout_t){.ms = (ms_)})
+#define K_NO_WAIT K_MSEC(0)
+#define K_FOREVER K_MSEC(-1)
+#define K_SECONDS(s) K_MSEC((int64_t)(s) * 1000)
+
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work {
+    k_work_handler_t handler;
+    bool pending;
+};
+
+struct k_work_delayable {
+    struct k_work work;
+    int64_t deadline_ms;
+    struct k_work_delayable *next;
+};
+
+#define K_WORK_DEFINE(work_, handler_) struct k_work work_ = {.handler = (handler_)}
+#define K_WORK_DELAYABLE_DEFINE(work_, handler_)                                                   \
+    struct k_work_delayable work_ = {.work = {.handler = (handler_)}}
+
+void k_work_init(struct k_work *work, k_work_handler_t handler);
+int k_work_submit(struct k_work *work);
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler);
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_cancel_delayable(struct k_work_delayable *dwork);
+bool k_work_delayable_is_pending(const struct k_work_delayable *dwork);
+k_ticks_t k_work_delayable_remaining_get(const struct k_work_delayable *dwork);
+
+static inline struct k_work_delayable *k_work_delayable_from_work(struct k_work *work) {
+    return CONTAINER_OF(work, struct k_work_delayable, work);
+}
+
+int64_t k_uptime_get(void);
+uint32_t k_uptime_get_32(void);
+uint32_t k_cycle_get_32(void);
+uint32_t sys_clock_hw_cycles_per_sec(void);
+static inline unsigned int find_msb_set(uint32_t op) {
+    return op == 0 ? 0 : 32 - __builtin_clz(op);
+}
+
+struct k_mutex {
+    int locked;
+};
+#define K_MUTEX_DEFINE(name) struct k_mutex name = {0}
+static inline int k_mutex_init(struct k_mutex *m) {
+    m->locked = 0;
+    return 0;
+}
+static inline int k_mutex_lock(struct k_mutex *m, k_timeout_t timeout) {
+    (void)timeout;
+    m->locked++;
+    return 0;
+}
+static inline int k_mutex_unlock(struct k_mutex *m) {
+    m->locked--;
+    return 0;
+}
+
+struct k_spinlock {
+    int unused;
+};
+typedef int k_spinlock_key_t;
+static inline k_spinlock_key_t k_spin_lock(struct k_spinlock *l) {
+    (void)l;
+    return 0;
+}
+static inline void k_spin_unlock(struct k_spinlock *l, k_spinlock_key_t key) {
+    (void)l;
+    (void)key;
+}
+
+static inline void k_yield(void) {}
+static inline int32_t k_msleep(int32_t ms) { (void)ms; return 0; }
+static inline int32_t k_sleep(k_timeout_t timeout) {
+    (void)timeout;
+    return 0;
+}
+
+// Shim control API used by the host harness
+void shim_advance_time_ms(int64_t ms);
+void shim_run_pending_work(void);
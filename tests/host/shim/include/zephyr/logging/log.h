@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Log calls are compiled (so arguments stay type-checked) but only printed
+// when the harness raises shim_log_level.
+extern int shim_log_level;
+void shim_log(int level, const char *fmt, ...);
+
+#define LOG_MODULE_DECLARE(...)
+#define LOG_MODULE_REGISTER(...)
+#define LOG_ERR(...) shim_log(1, __VA_ARGS__)
+#define LOG_WRN(...) shim_log(2, __VA_ARGS__)
+#define LOG_INF(...) shim_log(3, __VA_ARGS__)
+#define LOG_DBG(...) shim_log(4, __VA_ARGS__)
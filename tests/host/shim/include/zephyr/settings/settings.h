@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <sys/types.h>
+
+typedef ssize_t (*settings_read_cb)(void *cb_arg, void *data, size_t len);
+
+struct settings_handler_static {
+    const char *name;
+    int (*h_get)(const char *key, char *val, int val_len_max);
+    int (*h_set)(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg);
+    int (*h_commit)(void);
+    int (*h_export)(int (*export_func)(const char *name, const void *val, size_t val_len));
+};
+
+#define SETTINGS_STATIC_HANDLER_DEFINE(_hname, _tree, _get, _set, _commit, _export)               \
+    const struct settings_handler_static settings_handler_##_hname = {                            \
+        .name = _tree, .h_get = _get, .h_set = _set, .h_commit = _commit, .h_export = _export}
+
+int settings_save_one(const char *name, const void *value, size_t val_len);
+int settings_delete(const char *name);
+int settings_name_next(const char *name, const char **next);
+
+// Shim control API: number of settings_save_one() calls so far, and replay of
+// the stored records into a handler (as settings_load() would).
+extern int shim_settings_save_count;
+int shim_settings_load(const struct settings_handler_static *handler);
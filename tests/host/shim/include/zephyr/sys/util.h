@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Minimal subset of <zephyr/sys/util.h> and <zephyr/sys/util_macro.h>
+#define BIT(n) (1UL << (n))
+#define BIT64(n) (1ULL << (n))
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define BUILD_ASSERT(EXPR, ...) _Static_assert(EXPR, "" __VA_ARGS__)
+#define STRINGIFY(s) Z_STRINGIFY(s)
+#define Z_STRINGIFY(s) #s
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define CLAMP(val, low, high) (((val) <= (low)) ? (low) : MIN(val, high))
+#define ROUND_UP(x, align) ((((x) + (align) - 1) / (align)) * (align))
+#define DIV_ROUND_UP(n, d) (((n) + (d) - 1) / (d))
+#define __maybe_unused __attribute__((unused))
+#define __packed __attribute__((__packed__))
+#define ARG_UNUSED(x) (void)(x)
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+#define Z_XXXX1 Z_YYYY,
+#define Z_IS_ENABLED1(config_macro) Z_IS_ENABLED2(Z_XXXX##config_macro)
+#define Z_IS_ENABLED2(one_or_two_args) Z_IS_ENABLED3(one_or_two_args 1, 0)
+#define Z_IS_ENABLED3(ignore_this, val, ...) val
+#define IS_ENABLED(config_macro) Z_IS_ENABLED1(config_macro)
+
+#define Z_DEBRACKET(...) __VA_ARGS__
+#define Z_GET_ARG2_DEBRACKET(ignore_this, val, ...) Z_DEBRACKET val
+#define Z_COND_CODE_1(_flag, _if_1_code, _else_code)                                              \
+    Z_COND_CODE_1_2(Z_XXXX##_flag, _if_1_code, _else_code)
+#define Z_COND_CODE_1_2(one_or_two_args, _if_code, _else_code)                                     \
+    Z_GET_ARG2_DEBRACKET(one_or_two_args _if_code, _else_code)
+#define COND_CODE_1(_flag, _if_1_code, _else_code) Z_COND_CODE_1(_flag, _if_1_code, _else_code)
+#define IF_ENABLED(_flag, _code) COND_CODE_1(_flag, _code, ())
+
+#define Z_UTIL_CAT(a, b) a##b
+#define UTIL_CAT(a, b) Z_UTIL_CAT(a, b)
+#define _CONCAT(a, b) Z_UTIL_CAT(a, b)
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#define __used __attribute__((__used__))
+
+// Same form as Zephyr's x86 definition, so the host binary carries the symbols too
+#define GEN_ABSOLUTE_SYM(name, value)                                                              \
+    __asm__(".globl\t" #name "\n\t.equ\t" #name ",%c0"                                             \
+            "\n\t.type\t" #name ",@object"                                                         \
+            :                                                                                      \
+            : "n"(value))
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/device.h>
+
+struct zmk_behavior_binding {
+    const char *behavior_dev;
+    uint32_t param1;
+    uint32_t param2;
+};
+
+struct zmk_behavior_binding_event {
+    int layer;
+    uint32_t position;
+    int64_t timestamp;
+};
+
+typedef int (*behavior_keymap_binding_callback_t)(struct zmk_behavior_binding *binding,
+                                                  struct zmk_behavior_binding_event event);
+
+struct behavior_driver_api {
+    behavior_keymap_binding_callback_t binding_pressed;
+    behavior_keymap_binding_callback_t binding_released;
+};
+
+#define ZMK_BEHAVIOR_OPAQUE 0
+#define ZMK_BEHAVIOR_TRANSPARENT 1
+
+const struct device *zmk_behavior_get_binding(const char *name);
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// Host event manager: events are dispatched synchronously to every
+// subscribed listener in subscription order.
+
+struct zmk_event_type {
+    const char *name;
+};
+
+typedef struct {
+    const struct zmk_event_type *event;
+} zmk_event_t;
+
+struct zmk_listener {
+    int (*callback)(const zmk_event_t *eh);
+};
+
+#define ZMK_EV_EVENT_BUBBLE 0
+#define ZMK_EV_EVENT_HANDLED 1
+#define ZMK_EV_EVENT_CAPTURED 2
+
+int shim_event_dispatch(const zmk_event_t *eh);
+void shim_event_subscribe(const struct zmk_event_type *type, const struct zmk_listener *listener);
+
+#define ZMK_EVENT_DECLARE(event_type)                                                              \
+    struct event_type##_event {                                                                    \
+        zmk_event_t header;                                                                        \
+        struct event_type data;                                                                    \
+    };                                                                                             \
+    extern const struct zmk_event_type zmk_event_##event_type;                                     \
+    struct event_type *as_##event_type(const zmk_event_t *eh);                                     \
+    int raise_##event_type(struct event_type data);
+
+#define ZMK_EVENT_IMPL(event_type)                                                                 \
+    const struct zmk_event_type zmk_event_##event_type = {.name = #event_type};                    \
+    struct event_type *as_##event_type(const zmk_event_t *eh) {                                    \
+        return (eh->event == &zmk_event_##event_type)                                              \
+                   ? &((struct event_type##_event *)eh)->data                                      \
+                   : NULL;                                                                         \
+    }                                                                                              \
+    int raise_##event_type(struct event_type data) {                                               \
+        struct event_type##_event ev = {.header = {.event = &zmk_event_##event_type},              \
+                                        .data = data};                                             \
+        return shim_event_dispatch(&ev.header);                                                    \
+    }
+
+#define ZMK_LISTENER(mod, cb) const struct zmk_listener zmk_listener_##mod = {.callback = (cb)};
+#define ZMK_SUBSCRIPTION(mod, ev_type)                                                             \
+    __attribute__((constructor)) static void zmk_subscription_##mod##_##ev_type(void) {            \
+        shim_event_subscribe(&zmk_event_##ev_type, &zmk_listener_##mod);                           \
+    }
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/event_manager.h>
+
+struct zmk_split_peripheral_status_changed {
+    bool connected;
+};
+
+ZMK_EVENT_DECLARE(zmk_split_peripheral_status_changed);
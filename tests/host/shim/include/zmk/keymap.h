@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/behavior.h>
+
+#define ZMK_KEYMAP_LAYERS_LEN 4
+#define ZMK_KEYMAP_LEN 16
+#define ZMK_KEYMAP_LAYER_ID_INVAL UINT8_MAX
+
+typedef uint8_t zmk_keymap_layer_id_t;
+typedef uint8_t zmk_keymap_layer_index_t;
+
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t layer_index);
+bool zmk_keymap_layer_active(zmk_keymap_layer_id_t layer);
+int zmk_keymap_layer_activate(zmk_keymap_layer_id_t layer);
+int zmk_keymap_layer_deactivate(zmk_keymap_layer_id_t layer);
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer);
+const struct zmk_behavior_binding *
+zmk_keymap_get_layer_binding_at_idx(zmk_keymap_layer_id_t layer_id, uint8_t binding_idx);
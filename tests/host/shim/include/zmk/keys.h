@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HID_USAGE_KEY 0x07
+#define HID_USAGE_KEY_KEYBOARD_LEFTCONTROL 0xE0
+#define HID_USAGE_KEY_KEYBOARD_RIGHT_GUI 0xE7
+
+#define ZMK_HID_USAGE(page, id) ((page << 16) | id)
+#define ZMK_HID_USAGE_ID(usage) (usage & 0xFFFF)
+#define ZMK_HID_USAGE_PAGE(usage) ((usage >> 16) & 0xFF)
+
+static inline bool is_mod(uint8_t usage_page, uint32_t keycode) {
+    return (keycode >= HID_USAGE_KEY_KEYBOARD_LEFTCONTROL &&
+            keycode <= HID_USAGE_KEY_KEYBOARD_RIGHT_GUI && usage_page == HID_USAGE_KEY);
+}
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2026 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/events/split_peripheral_status_changed.h>
+#include <zmk/keymap.h>
+#include <zmk/split/central.h>
+#include <drivers/behavior.h>
+
+ZMK_EVENT_IMPL(zmk_keycode_state_changed);
+ZMK_EVENT_IMPL(zmk_position_state_changed);
+ZMK_EVENT_IMPL(zmk_layer_state_changed);
+ZMK_EVENT_IMPL(zmk_split_peripheral_status_changed);
+
+int shim_log_level = 0;
+
+void shim_log(int level, const char *fmt, ...) {
+    if (level > shim_log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+/* Time */
+
+static int64_t now_ms;
+
+int64_t k_uptime_get(void) { return now_ms; }
+
+uint32_t k_uptime_get_32(void) { return (uint32_t)now_ms; }
+
+uint32_t k_cycle_get_32(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t sys_clock_hw_cycles_per_sec(void) { return 1000000000U; }
+
+/* Work queue */
+
+static struct k_work_delayable *scheduled;
+static struct k_work *submitted[16];
+static size_t submitted_len;
+
+static void unlink_delayable(struct k_work_delayable *dwork) {
+    for (struct k_work_delayable **it = &scheduled; *it; it = &(*it)->next) {
+        if (*it == dwork) {
+            *it = dwork->next;
+            dwork->next = NULL;
+            return;
+        }
+    }
+}
+
+void k_work_init(struct k_work *work, k_work_handler_t handler) {
+    work->handler = handler;
+    work->pending = false;
+}
+
+int k_work_submit(struct k_work *work) {
+    if (work->pending) {
+        return 0;
+    }
+    if (submitted_len >= ARRAY_SIZE(submitted)) {
+        return -EBUSY;
+    }
+    work->pending = true;
+    submitted[submitted_len++] = work;
+    return 1;
+}
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler) {
+    k_work_init(&dwork->work, handler);
+    dwork->deadline_ms = 0;
+    dwork->next = NULL;
+}
+
+int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+    unlink_delayable(dwork);
+    dwork->deadline_ms = now_ms + (delay.ms < 0 ? 0 : delay.ms);
+    dwork->work.pending = true;
+    dwork->next = scheduled;
+    scheduled = dwork;
+    return 1;
+}
+
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+    if (dwork->work.pending) {
+        return 0;
+    }
+    return k_work_reschedule(dwork, delay);
+}
+
+int k_work_cancel_delayable(struct k_work_delayable *dwork) {
+    unlink_delayable(dwork);
+    dwork->work.pending = false;
+    return 0;
+}
+
+bool k_work_delayable_is_pending(const struct k_work_delayable *dwork) {
+    return dwork->work.pending;
+}
+
+k_ticks_t k_work_delayable_remaining_get(const struct k_work_delayable *dwork) {
+    return dwork->work.pending ? MAX(dwork->deadline_ms - now_ms, 0) : 0;
+}
+
+void shim_run_pending_work(void) {
+    bool ran = true;
+    while (ran) {
+        ran = false;
+        while (submitted_len > 0) {
+            struct k_work *work = submitted[0];
+            memmove(&submitted[0], &submitted[1], (--submitted_len) * sizeof(submitted[0]));
+            work->pending = false;
+            work->handler(work);
+            ran = true;
+        }
+
+        struct k_work_delayable *due = NULL;
+        for (struct k_work_delayable *it = scheduled; it; it = it->next) {
+            if (it->deadline_ms <= now_ms && (!due || it->deadline_ms < due->deadline_ms)) {
+                due = it;
+            }
+        }
+        if (due) {
+            unlink_delayable(due);
+            due->work.pending = false;
+            due->work.handler(&due->work);
+            ran = true;
+        }
+    }
+}
+
+void shim_advance_time_ms(int64_t ms) {
+    int64_t target = now_ms + ms;
+    while (true) {
+        shim_run_pending_work();
+        int64_t next = target;
+        for (struct k_work_delayable *it = scheduled; it; it = it->next) {
+            next = MIN(next, it->deadline_ms);
+        }
+        if (next > target || (next == now_ms && next == target)) {
+            break;
+        }
+        now_ms = MAX(next, now_ms);
+        if (now_ms == target) {
+            shim_run_pending_work();
+            break;
+        }
+    }
+    now_ms = target;
+}
+
+/* Event manager */
+
+struct subscription {
+    const struct zmk_event_type *type;
+    const struct zmk_listener *listener;
+};
+
+static struct subscription subscriptions[32];
+static size_t subscriptions_len;
+
+void shim_event_subscribe(const struct zmk_event_type *type, const struct zmk_listener *listener) {
+    if (subscriptions_len < ARRAY_SIZE(subscriptions)) {
+        subscriptions[subscriptions_len++] =
+            (struct subscription){.type = type, .listener = listener};
+    }
+}
+
+int shim_event_dispatch(const zmk_event_t *eh) {
+    for (size_t i = 0; i < subscriptions_len; i++) {
+        if (subscriptions[i].type != eh->event) {
+            continue;
+        }
+        int ret = subscriptions[i].listener->callback(eh);
+        if (ret != ZMK_EV_EVENT_BUBBLE) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+/* Keymap */
+
+static uint32_t layer_state = BIT(0);
+
+static const struct zmk_behavior_binding trans_binding = {.behavior_dev = "trans"};
+
+zmk_keymap_layer_id_t zmk_keymap_layer_index_to_id(zmk_keymap_layer_index_t layer_index) {
+    return layer_index < ZMK_KEYMAP_LAYERS_LEN ? layer_index : ZMK_KEYMAP_LAYER_ID_INVAL;
+}
+
+bool zmk_keymap_layer_active(zmk_keymap_layer_id_t layer) {
+    return layer < ZMK_KEYMAP_LAYERS_LEN && (layer_state & BIT(layer));
+}
+
+static int set_layer_state(zmk_keymap_layer_id_t layer, bool state) {
+    if (layer >= ZMK_KEYMAP_LAYERS_LEN) {
+        return -EINVAL;
+    }
+    if (zmk_keymap_layer_active(layer) == state) {
+        return 0;
+    }
+    layer_state = state ? (layer_state | BIT(layer)) : (layer_state & ~BIT(layer));
+    raise_zmk_layer_state_changed(
+        (struct zmk_layer_state_changed){.layer = layer, .state = state, .timestamp = now_ms});
+    return 0;
+}
+
+int zmk_keymap_layer_activate(zmk_keymap_layer_id_t layer) { return set_layer_state(layer, true); }
+
+int zmk_keymap_layer_deactivate(zmk_keymap_layer_id_t layer) {
+    return set_layer_state(layer, false);
+}
+
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer) {
+    static const char *names[] = {"base", "mouse", "scroll", "fn"};
+    return layer < ZMK_KEYMAP_LAYERS_LEN ? names[layer] : NULL;
+}
+
+const struct zmk_behavior_binding *
+zmk_keymap_get_layer_binding_at_idx(zmk_keymap_layer_id_t layer_id, uint8_t binding_idx) {
+    return (layer_id < ZMK_KEYMAP_LAYERS_LEN && binding_idx < ZMK_KEYMAP_LEN) ? &trans_binding
+                                                                              : NULL;
+}
+
+/* Behaviors */
+
+static const struct device *behaviors[8];
+static size_t behaviors_len;
+
+void shim_register_behavior(const struct device *dev) {
+    if (behaviors_len < ARRAY_SIZE(behaviors)) {
+        behaviors[behaviors_len++] = dev;
+    }
+}
+
+void shim_init_behaviors(void) {
+    for (size_t i = 0; i < behaviors_len; i++) {
+        behaviors[i]->init(behaviors[i]);
+    }
+}
+
+const struct device *zmk_behavior_get_binding(const char *name) {
+    for (size_t i = 0; i < behaviors_len; i++) {
+        if (name && strcmp(behaviors[i]->name, name) == 0) {
+            return behaviors[i];
+        }
+    }
+    return NULL;
+}
+
+/* Split */
+
+int zmk_split_central_invoke_behavior(uint8_t source, struct zmk_behavior_binding *binding,
+                                      struct zmk_behavior_binding_event event, bool state) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    if (!dev) {
+        return -ENODEV;
+    }
+    const struct behavior_driver_api *api = dev->api;
+    return state ? api->binding_pressed(binding, event) : api->binding_released(binding, event);
+}
+
+/* Settings */
+
+struct stored_setting {
+    char name[64];
+    uint8_t value[512];
+    size_t len;
+};
+
+static struct stored_setting stored_settings[16];
+static size_t stored_settings_len;
+int shim_settings_save_count;
+
+int settings_save_one(const char *name, const void *value, size_t val_len) {
+    if (val_len > sizeof(stored_settings[0].value)) {
+        return -ENOMEM;
+    }
+    shim_settings_save_count++;
+    struct stored_setting *slot = NULL;
+    for (size_t i = 0; i < stored_settings_len; i++) {
+        if (strcmp(stored_settings[i].name, name) == 0) {
+            slot = &stored_settings[i];
+        }
+    }
+    if (!slot) {
+        if (stored_settings_len >= ARRAY_SIZE(stored_settings)) {
+            return -ENOMEM;
+        }
+        slot = &stored_settings[stored_settings_len++];
+        snprintf(slot->name, sizeof(slot->name), "%s", name);
+    }
+    memcpy(slot->value, value, val_len);
+    slot->len = val_len;
+    return 0;
+}
+
+int settings_delete(const char *name) { return settings_save_one(name, NULL, 0); }
+
+int settings_name_next(const char *name, const char **next) {
+    const char *sep = strchr(name, '/');
+    if (next) {
+        *next = sep ? sep + 1 : NULL;
+    }
+    return sep ? (int)(sep - name) : (int)strlen(name);
+}
+
+struct read_ctx {
+    const struct stored_setting *setting;
+};
+
+static ssize_t shim_read_cb(void *cb_arg, void *data, size_t len) {
+    const struct read_ctx *ctx = cb_arg;
+    size_t n = MIN(len, ctx->setting->len);
+    memcpy(data, ctx->setting->value, n);
+    return n;
+}
+
+int shim_settings_load(const struct settings_handler_static *handler) {
+    size_t prefix_len = strlen(handler->name);
+    for (size_t i = 0; i < stored_settings_len; i++) {
+        const struct stored_setting *setting = &stored_settings[i];
+        if (strncmp(setting->name, handler->name, prefix_len) != 0 ||
+            setting->name[prefix_len] != '/' || setting->len == 0) {
+            continue;
+        }
+        struct read_ctx ctx = {.setting = setting};
+        handler->h_set(setting->name + prefix_len + 1, setting->len, shim_read_cb, &ctx);
+    }
+    return handler->h_commit ? handler->h_commit() : 0;
+}
@@ -16,12 +16,151 @@ import {
   Response,
   InputProcessorInfo,
   Notification,
+  ProfileInfo,
+  GetProcessorStatsResponse,
+  TelemetrySample,
   AxisSnapMode,
+  AccelCurve,
+  ConfigField,
 } from "./proto/cormoran/rip/custom";
 
 // Custom subsystem identifier - must match firmware registration
 export const SUBSYSTEM_IDENTIFIER = "cormoran_rip";
 
+// Maximum number of acceleration lookup table points supported by firmware
+const ACCEL_LUT_MAX_POINTS = 16;
+
+// Stage names, in the order of GetProcessorStatsResponse.stageEvents
+const STATS_STAGE_NAMES = [
+  "Code Mapping",
+  "Temp-Layer",
+  "Rotation",
+  "Linear (Scale/Invert)",
+  "Axis Snap",
+  "Scale after Snap",
+  "Acceleration",
+  "Filter",
+  "Scroll",
+];
+
+// Format a hardware cycle count as microseconds when the frequency is known
+function formatCycles(cycles: number, cyclesPerSecond: number): string {
+  return cyclesPerSecond > 0
+    ? `${((cycles * 1e6) / cyclesPerSecond).toFixed(1)}µs`
+    : `${cycles} cycles`;
+}
+
+// Label a cycle histogram bucket: [0] 0 cycles, [i] 2^(i-1) to 2^i - 1 cycles
+function histogramBucketLabel(
+  index: number,
+  buckets: number,
+  cyclesPerSecond: number
+): string {
+  if (index === 0) return formatCycles(0, cyclesPerSecond);
+  const low = formatCycles(2 ** (index - 1), cyclesPerSecond);
+  if (index === buckets - 1) return `≥ ${low}`;
+  return `${low} - ${formatCycles(2 ** index - 1, cyclesPerSecond)}`;
+}
+
+// Parse a comma separated list of acceleration gains (percent)
+function parseAccelLut(text: string): number[] {
+  return text
+    .split(",")
+    .map((v) => parseInt(v.trim()))
+    .filter((v) => !isNaN(v) && v >= 0)
+    .slice(0, ACCEL_LUT_MAX_POINTS);
+}
+
+// Number of telemetry windows kept for the live plot
+const TELEMETRY_HISTORY = 120;
+
+// SVG polyline points for one telemetry series, centred on the plot's zero line
+function telemetryPoints(
+  values: number[],
+  width: number,
+  height: number,
+  range: number
+): string {
+  const step = width / (TELEMETRY_HISTORY - 1);
+  return values
+    .map((v, i) => `${i * step},${height / 2 - (v / range) * (height / 2)}`)
+    .join(" ");
+}
+
+// Describe the axis snap state at the end of a telemetry window
+function telemetrySnapLabel(sample: TelemetrySample): string {
+  if (sample.snapAxis < 0) return "Not locked";
+  const axis = sample.snapAxis === 0 ? "X" : "Y";
+  return sample.snapUnlocked
+    ? `Locked to ${axis}, threshold exceeded`
+    : `Locked to ${axis}`;
+}
+
+// Input (grey) and output (blue) motion per window for both input axes
+function TelemetryPlot({ samples }: { samples: TelemetrySample[] }) {
+  const width = 480;
+  const height = 120;
+  const range = Math.max(
+    1,
+    ...samples.flatMap((s) => [
+      Math.abs(s.inX),
+      Math.abs(s.inY),
+      Math.abs(s.outX),
+      Math.abs(s.outY),
+    ])
+  );
+  const axes = [
+    {
+      name: "X",
+      input: samples.map((s) => s.inX),
+      output: samples.map((s) => s.outX),
+    },
+    {
+      name: "Y",
+      input: samples.map((s) => s.inY),
+      output: samples.map((s) => s.outY),
+    },
+  ];
+
+  return (
+    <>
+      {axes.map((axis) => (
+        <div key={axis.name} style={{ marginBottom: "0.5rem" }}>
+          <div style={{ fontSize: "0.85em", color: "#666" }}>
+            {axis.name} (±{range})
+          </div>
+          <svg
+            viewBox={`0 0 ${width} ${height}`}
+            style={{ width: "100%", height: "auto", background: "#f8f8f8" }}
+            role="img"
+            aria-label={`${axis.name} telemetry`}
+          >
+            <line
+              x1={0}
+              y1={height / 2}
+              x2={width}
+              y2={height / 2}
+              stroke="#ddd"
+            />
+            <polyline
+              points={telemetryPoints(axis.input, width, height, range)}
+              fill="none"
+              stroke="#999"
+              strokeWidth={1.5}
+            />
+            <polyline
+              points={telemetryPoints(axis.output, width, height, range)}
+              fill="none"
+              stroke="#0066cc"
+              strokeWidth={1.5}
+            />
+          </svg>
+        </div>
+      ))}
+    </>
+  );
+}
+
 function App() {
   return (
     <div className="app">
@@ -104,6 +243,11 @@ export function InputProcessorManager() {
     useState<number>(100);
   const [tempLayerDeactivationDelay, setTempLayerDeactivationDelay] =
     useState<number>(500);
+  const [tempLayerActivationThreshold, setTempLayerActivationThreshold] =
+    useState<number>(0);
+  const [tempLayerReleaseThreshold, setTempLayerReleaseThreshold] =
+    useState<number>(0);
+  const [tempLayerMotionWindow, setTempLayerMotionWindow] = useState<number>(0);
 
   // Active layers state
   const [activeLayers, setActiveLayers] = useState<number>(0);
@@ -121,6 +265,36 @@ export function InputProcessorManager() {
   // Axis invert state
   const [xInvert, setXInvert] = useState<boolean>(false);
   const [yInvert, setYInvert] = useState<boolean>(false);
+  // Acceleration state
+  const [accelCurve, setAccelCurve] = useState<AccelCurve>(
+    AccelCurve.ACCEL_CURVE_NONE
+  );
+  const [accelSpeedMax, setAccelSpeedMax] = useState<number>(2000);
+  const [accelGainMax, setAccelGainMax] = useState<number>(200);
+  const [accelExponent, setAccelExponent] = useState<number>(200);
+  const [accelLut, setAccelLut] = useState<string>("");
+  // Jitter filter state
+  const [filterDeadZone, setFilterDeadZone] = useState<number>(0);
+  const [filterIirShift, setFilterIirShift] = useState<number>(0);
+  const [filterIdleMs, setFilterIdleMs] = useState<number>(0);
+  // Scroll sub-pipeline state
+  const [scrollScaleMultiplier, setScrollScaleMultiplier] = useState<number>(1);
+  const [scrollScaleDivisor, setScrollScaleDivisor] = useState<number>(0);
+  const [scrollHiresMultiplier, setScrollHiresMultiplier] = useState<number>(0);
+  const [scrollSnap, setScrollSnap] = useState<boolean>(false);
+  // Profile state
+  const [profiles, setProfiles] = useState<ProfileInfo[]>([]);
+  const [activeProfile, setActiveProfile] = useState<number>(-1);
+  const [profileIndex, setProfileIndex] = useState<number>(0);
+  const [profileName, setProfileName] = useState<string>("");
+  // Statistics state
+  const [stats, setStats] = useState<GetProcessorStatsResponse | null>(null);
+
+  const [telemetryEnabled, setTelemetryEnabled] = useState<boolean>(false);
+  const [telemetryIntervalMs, setTelemetryIntervalMs] = useState<number>(0);
+  const [telemetrySamples, setTelemetrySamples] = useState<TelemetrySample[]>(
+    []
+  );
 
   const subsystem = useMemo(
     () => zmkApp?.findSubsystem(SUBSYSTEM_IDENTIFIER),
@@ -157,7 +331,6 @@ export function InputProcessorManager() {
     setError(null);
 
     try {
-      // Request list of input processors - notifications will be sent for each processor
       const request = Request.create({
         listInputProcessors: {},
       });
@@ -166,7 +339,12 @@ export function InputProcessorManager() {
       if (resp?.error) {
         setError(resp.error.message);
       }
-      // Response is empty - processors will arrive via notifications
+      // Firmware without the list in the response reports each processor
+      // via notifications instead
+      const list = resp?.listInputProcessors?.processors ?? [];
+      if (list.length > 0) {
+        setProcessors(list);
+      }
     } catch (err) {
       setError(
         `Failed to load processors: ${err instanceof Error ? err.message : "Unknown error"}`
@@ -193,6 +371,69 @@ export function InputProcessorManager() {
     }
   }, [callRPC]);
 
+  const loadProfiles = useCallback(
+    async (id: number) => {
+      try {
+        const resp = await callRPC(Request.create({ listProfiles: { id } }));
+        if (resp?.listProfiles) {
+          setProfiles(resp.listProfiles.profiles);
+          setActiveProfile(resp.listProfiles.activeProfile);
+        } else {
+          // Firmware built without profile support
+          setProfiles([]);
+          setActiveProfile(-1);
+        }
+      } catch (err) {
+        console.error("Failed to load profiles:", err);
+      }
+    },
+    [callRPC]
+  );
+
+  const profileAction = useCallback(
+    async (request: Request) => {
+      if (selectedProcessorId === null) return;
+      setError(null);
+      try {
+        const resp = await callRPC(request);
+        if (resp?.error) {
+          setError(resp.error.message);
+        }
+        await loadProfiles(selectedProcessorId);
+      } catch (err) {
+        setError(
+          `Profile request failed: ${err instanceof Error ? err.message : "Unknown error"}`
+        );
+      }
+    },
+    [callRPC, loadProfiles, selectedProcessorId]
+  );
+
+  const loadStats = useCallback(
+    async (reset: boolean) => {
+      if (selectedProcessorId === null) return;
+      try {
+        const resp = await callRPC(
+          Request.create({
+            getProcessorStats: { id: selectedProcessorId, reset },
+          })
+        );
+        if (resp?.getProcessorStats) {
+          setStats(resp.getProcessorStats);
+        } else if (resp?.error) {
+          setError(
+            "Statistics are not available. Enable CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_STATS."
+          );
+        }
+      } catch (err) {
+        setError(
+          `Failed to load statistics: ${err instanceof Error ? err.message : "Unknown error"}`
+        );
+      }
+    },
+    [callRPC, selectedProcessorId]
+  );
+
   const updateProcessor = useCallback(async () => {
     if (selectedProcessorId === null) return;
 
@@ -206,232 +447,182 @@ export function InputProcessorManager() {
     setIsUpdating(true);
 
     try {
-      // Only send requests for fields that have actually changed
-      if (currentProcessor.scaleMultiplier !== scaleMultiplier) {
-        const mulRequest = Request.create({
-          setScaleMultiplier: {
-            id: selectedProcessorId,
-            value: scaleMultiplier,
-          },
-        });
-        const mulResp = await callRPC(mulRequest);
-        if (mulResp?.error) {
-          setError(mulResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.scaleDivisor !== scaleDivisor) {
-        const divRequest = Request.create({
-          setScaleDivisor: {
-            id: selectedProcessorId,
-            value: scaleDivisor,
-          },
-        });
-        const divResp = await callRPC(divRequest);
-        if (divResp?.error) {
-          setError(divResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.rotationDegrees !== rotationDegrees) {
-        const rotRequest = Request.create({
-          setRotation: {
-            id: selectedProcessorId,
-            value: rotationDegrees,
-          },
-        });
-        const rotResp = await callRPC(rotRequest);
-        if (rotResp?.error) {
-          setError(rotResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.tempLayerEnabled !== tempLayerEnabled) {
-        const enabledRequest = Request.create({
-          setTempLayerEnabled: {
-            id: selectedProcessorId,
-            enabled: tempLayerEnabled,
-          },
-        });
-        const enabledResp = await callRPC(enabledRequest);
-        if (enabledResp?.error) {
-          setError(enabledResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.tempLayerLayer !== tempLayerLayer) {
-        const layerRequest = Request.create({
-          setTempLayerLayer: {
-            id: selectedProcessorId,
-            layer: tempLayerLayer,
-          },
-        });
-        const layerResp = await callRPC(layerRequest);
-        if (layerResp?.error) {
-          setError(layerResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (
-        currentProcessor.tempLayerActivationDelayMs !== tempLayerActivationDelay
-      ) {
-        const actDelayRequest = Request.create({
-          setTempLayerActivationDelay: {
-            id: selectedProcessorId,
-            activationDelayMs: tempLayerActivationDelay,
-          },
-        });
-        const actDelayResp = await callRPC(actDelayRequest);
-        if (actDelayResp?.error) {
-          setError(actDelayResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (
-        currentProcessor.tempLayerDeactivationDelayMs !==
-        tempLayerDeactivationDelay
-      ) {
-        const deactDelayRequest = Request.create({
-          setTempLayerDeactivationDelay: {
-            id: selectedProcessorId,
-            deactivationDelayMs: tempLayerDeactivationDelay,
-          },
-        });
-        const deactDelayResp = await callRPC(deactDelayRequest);
-        if (deactDelayResp?.error) {
-          setError(deactDelayResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.activeLayers !== activeLayers) {
-        const activeLayersRequest = Request.create({
-          setActiveLayers: {
-            id: selectedProcessorId,
-            layers: activeLayers,
-          },
-        });
-        const activeLayersResp = await callRPC(activeLayersRequest);
-        if (activeLayersResp?.error) {
-          setError(activeLayersResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.axisSnapMode !== axisSnapMode) {
-        const axisSnapModeRequest = Request.create({
-          setAxisSnapMode: {
-            id: selectedProcessorId,
-            mode: axisSnapMode,
-          },
-        });
-        const axisSnapModeResp = await callRPC(axisSnapModeRequest);
-        if (axisSnapModeResp?.error) {
-          setError(axisSnapModeResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.axisSnapThreshold !== axisSnapThreshold) {
-        const axisSnapThresholdRequest = Request.create({
-          setAxisSnapThreshold: {
-            id: selectedProcessorId,
-            threshold: axisSnapThreshold,
-          },
-        });
-        const axisSnapThresholdResp = await callRPC(axisSnapThresholdRequest);
-        if (axisSnapThresholdResp?.error) {
-          setError(axisSnapThresholdResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.axisSnapTimeoutMs !== axisSnapTimeout) {
-        const axisSnapTimeoutRequest = Request.create({
-          setAxisSnapTimeout: {
-            id: selectedProcessorId,
-            timeoutMs: axisSnapTimeout,
-          },
-        });
-        const axisSnapTimeoutResp = await callRPC(axisSnapTimeoutRequest);
-        if (axisSnapTimeoutResp?.error) {
-          setError(axisSnapTimeoutResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.xyToScrollEnabled !== xyToScrollEnabled) {
-        const xyToScrollRequest = Request.create({
-          setXyToScrollEnabled: {
-            id: selectedProcessorId,
-            enabled: xyToScrollEnabled,
-          },
-        });
-        const xyToScrollResp = await callRPC(xyToScrollRequest);
-        if (xyToScrollResp?.error) {
-          setError(xyToScrollResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.xInvert !== xInvert) {
-        const xInvertRequest = Request.create({
-          setXInvert: {
-            id: selectedProcessorId,
-            invert: xInvert,
-          },
-        });
-        const xInvertResp = await callRPC(xInvertRequest);
-        if (xInvertResp?.error) {
-          setError(xInvertResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
-
-      if (currentProcessor.xySwapEnabled !== xySwapEnabled) {
-        const xySwapRequest = Request.create({
-          setXySwapEnabled: {
-            id: selectedProcessorId,
-            enabled: xySwapEnabled,
-          },
-        });
-        const xySwapResp = await callRPC(xySwapRequest);
-        if (xySwapResp?.error) {
-          setError(xySwapResp.error.message);
-          setIsLoading(false);
-          return;
-        }
-      }
+      // Collect changed fields and send them in a single request so the
+      // device applies them atomically with one notification and one save
+      const accelLutGains = parseAccelLut(accelLut);
+      const changes: [boolean, ConfigField][] = [
+        [
+          currentProcessor.scaleMultiplier !== scaleMultiplier,
+          ConfigField.CONFIG_FIELD_SCALE_MULTIPLIER,
+        ],
+        [
+          currentProcessor.scaleDivisor !== scaleDivisor,
+          ConfigField.CONFIG_FIELD_SCALE_DIVISOR,
+        ],
+        [
+          currentProcessor.rotationDegrees !== rotationDegrees,
+          ConfigField.CONFIG_FIELD_ROTATION_DEGREES,
+        ],
+        [
+          currentProcessor.tempLayerEnabled !== tempLayerEnabled,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_ENABLED,
+        ],
+        [
+          currentProcessor.tempLayerLayer !== tempLayerLayer,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_LAYER,
+        ],
+        [
+          currentProcessor.tempLayerActivationDelayMs !==
+            tempLayerActivationDelay,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_ACTIVATION_DELAY,
+        ],
+        [
+          currentProcessor.tempLayerDeactivationDelayMs !==
+            tempLayerDeactivationDelay,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_DEACTIVATION_DELAY,
+        ],
+        [
+          currentProcessor.tempLayerActivationThreshold !==
+            tempLayerActivationThreshold,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_ACTIVATION_THRESHOLD,
+        ],
+        [
+          currentProcessor.tempLayerReleaseThreshold !==
+            tempLayerReleaseThreshold,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_RELEASE_THRESHOLD,
+        ],
+        [
+          currentProcessor.tempLayerMotionWindowMs !== tempLayerMotionWindow,
+          ConfigField.CONFIG_FIELD_TEMP_LAYER_MOTION_WINDOW,
+        ],
+        [
+          currentProcessor.activeLayers !== activeLayers,
+          ConfigField.CONFIG_FIELD_ACTIVE_LAYERS,
+        ],
+        [
+          currentProcessor.axisSnapMode !== axisSnapMode,
+          ConfigField.CONFIG_FIELD_AXIS_SNAP_MODE,
+        ],
+        [
+          currentProcessor.axisSnapThreshold !== axisSnapThreshold,
+          ConfigField.CONFIG_FIELD_AXIS_SNAP_THRESHOLD,
+        ],
+        [
+          currentProcessor.axisSnapTimeoutMs !== axisSnapTimeout,
+          ConfigField.CONFIG_FIELD_AXIS_SNAP_TIMEOUT,
+        ],
+        [
+          currentProcessor.xyToScrollEnabled !== xyToScrollEnabled,
+          ConfigField.CONFIG_FIELD_XY_TO_SCROLL_ENABLED,
+        ],
+        [
+          currentProcessor.xySwapEnabled !== xySwapEnabled,
+          ConfigField.CONFIG_FIELD_XY_SWAP_ENABLED,
+        ],
+        [
+          currentProcessor.xInvert !== xInvert,
+          ConfigField.CONFIG_FIELD_X_INVERT,
+        ],
+        [
+          currentProcessor.yInvert !== yInvert,
+          ConfigField.CONFIG_FIELD_Y_INVERT,
+        ],
+        [
+          currentProcessor.accelCurve !== accelCurve,
+          ConfigField.CONFIG_FIELD_ACCEL_CURVE,
+        ],
+        [
+          currentProcessor.accelSpeedMax !== accelSpeedMax,
+          ConfigField.CONFIG_FIELD_ACCEL_SPEED_MAX,
+        ],
+        [
+          currentProcessor.accelGainMax !== accelGainMax,
+          ConfigField.CONFIG_FIELD_ACCEL_GAIN_MAX,
+        ],
+        [
+          currentProcessor.accelExponent !== accelExponent,
+          ConfigField.CONFIG_FIELD_ACCEL_EXPONENT,
+        ],
+        [
+          currentProcessor.accelLut.join(",") !== accelLutGains.join(","),
+          ConfigField.CONFIG_FIELD_ACCEL_LUT,
+        ],
+        [
+          currentProcessor.filterDeadZone !== filterDeadZone,
+          ConfigField.CONFIG_FIELD_FILTER_DEAD_ZONE,
+        ],
+        [
+          currentProcessor.filterIirShift !== filterIirShift,
+          ConfigField.CONFIG_FIELD_FILTER_IIR_SHIFT,
+        ],
+        [
+          currentProcessor.filterIdleMs !== filterIdleMs,
+          ConfigField.CONFIG_FIELD_FILTER_IDLE,
+        ],
+        [
+          currentProcessor.scrollScaleMultiplier !== scrollScaleMultiplier,
+          ConfigField.CONFIG_FIELD_SCROLL_SCALE_MULTIPLIER,
+        ],
+        [
+          currentProcessor.scrollScaleDivisor !== scrollScaleDivisor,
+          ConfigField.CONFIG_FIELD_SCROLL_SCALE_DIVISOR,
+        ],
+        [
+          currentProcessor.scrollHiresMultiplier !== scrollHiresMultiplier,
+          ConfigField.CONFIG_FIELD_SCROLL_HIRES,
+        ],
+        [
+          currentProcessor.scrollSnap !== scrollSnap,
+          ConfigField.CONFIG_FIELD_SCROLL_SNAP,
+        ],
+      ];
+      const fieldMask = changes.reduce(
+        (mask, [changed, field]) => (changed ? mask | field : mask),
+        0
+      );
 
-      if (currentProcessor.yInvert !== yInvert) {
-        const yInvertRequest = Request.create({
-          setYInvert: {
+      if (fieldMask !== 0) {
+        const configRequest = Request.create({
+          setInputProcessorConfig: {
             id: selectedProcessorId,
-            invert: yInvert,
+            fieldMask,
+            config: InputProcessorInfo.create({
+              scaleMultiplier,
+              scaleDivisor,
+              rotationDegrees,
+              tempLayerEnabled,
+              tempLayerLayer,
+              tempLayerActivationDelayMs: tempLayerActivationDelay,
+              tempLayerDeactivationDelayMs: tempLayerDeactivationDelay,
+              tempLayerActivationThreshold,
+              tempLayerReleaseThreshold,
+              tempLayerMotionWindowMs: tempLayerMotionWindow,
+              activeLayers,
+              axisSnapMode,
+              axisSnapThreshold,
+              axisSnapTimeoutMs: axisSnapTimeout,
+              xyToScrollEnabled,
+              xySwapEnabled,
+              xInvert,
+              yInvert,
+              accelCurve,
+              accelSpeedMax,
+              accelGainMax,
+              accelExponent,
+              accelLut: accelLutGains,
+              filterDeadZone,
+              filterIirShift,
+              filterIdleMs,
+              scrollScaleMultiplier,
+              scrollScaleDivisor,
+              scrollHiresMultiplier,
+              scrollSnap,
+            }),
           },
         });
-        const yInvertResp = await callRPC(yInvertRequest);
-        if (yInvertResp?.error) {
-          setError(yInvertResp.error.message);
+        const configResp = await callRPC(configRequest);
+        if (configResp?.error) {
+          setError(configResp.error.message);
           setIsLoading(false);
           return;
         }
@@ -457,6 +648,9 @@ export function InputProcessorManager() {
     tempLayerLayer,
     tempLayerActivationDelay,
     tempLayerDeactivationDelay,
+    tempLayerActivationThreshold,
+    tempLayerReleaseThreshold,
+    tempLayerMotionWindow,
     activeLayers,
     axisSnapMode,
     axisSnapThreshold,
@@ -465,6 +659,18 @@ export function InputProcessorManager() {
     xySwapEnabled,
     xInvert,
     yInvert,
+    accelCurve,
+    accelSpeedMax,
+    accelGainMax,
+    accelExponent,
+    accelLut,
+    filterDeadZone,
+    filterIirShift,
+    filterIdleMs,
+    scrollScaleMultiplier,
+    scrollScaleDivisor,
+    scrollHiresMultiplier,
+    scrollSnap,
   ]);
 
   const selectProcessor = useCallback(
@@ -479,6 +685,9 @@ export function InputProcessorManager() {
         setTempLayerLayer(proc.tempLayerLayer);
         setTempLayerActivationDelay(proc.tempLayerActivationDelayMs);
         setTempLayerDeactivationDelay(proc.tempLayerDeactivationDelayMs);
+        setTempLayerActivationThreshold(proc.tempLayerActivationThreshold);
+        setTempLayerReleaseThreshold(proc.tempLayerReleaseThreshold);
+        setTempLayerMotionWindow(proc.tempLayerMotionWindowMs);
         setActiveLayers(proc.activeLayers);
         setAxisSnapMode(proc.axisSnapMode);
         setAxisSnapThreshold(proc.axisSnapThreshold);
@@ -487,6 +696,18 @@ export function InputProcessorManager() {
         setXySwapEnabled(proc.xySwapEnabled);
         setXInvert(proc.xInvert);
         setYInvert(proc.yInvert);
+        setAccelCurve(proc.accelCurve);
+        setAccelSpeedMax(proc.accelSpeedMax);
+        setAccelGainMax(proc.accelGainMax);
+        setAccelExponent(proc.accelExponent);
+        setAccelLut(proc.accelLut.join(", "));
+        setFilterDeadZone(proc.filterDeadZone);
+        setFilterIirShift(proc.filterIirShift);
+        setFilterIdleMs(proc.filterIdleMs);
+        setScrollScaleMultiplier(proc.scrollScaleMultiplier);
+        setScrollScaleDivisor(proc.scrollScaleDivisor);
+        setScrollHiresMultiplier(proc.scrollHiresMultiplier);
+        setScrollSnap(proc.scrollSnap);
       }
     },
     [processors]
@@ -500,6 +721,51 @@ export function InputProcessorManager() {
     // eslint-disable-next-line react-hooks/exhaustive-deps
   }, [subsystem]);
 
+  // Select the first processor once the list has been loaded
+  useEffect(() => {
+    if (selectedProcessorId === null && processors.length > 0) {
+      selectProcessor(processors[0].id);
+    }
+  }, [processors, selectedProcessorId, selectProcessor]);
+
+  useEffect(() => {
+    if (selectedProcessorId !== null) {
+      loadProfiles(selectedProcessorId);
+    }
+    setStats(null);
+  }, [selectedProcessorId, loadProfiles]);
+
+  // Stream the telemetry of the selected processor while enabled. The cleanup
+  // stops it when it is switched off, another processor is selected or the
+  // component goes away.
+  useEffect(() => {
+    if (!telemetryEnabled || selectedProcessorId === null) return;
+    const id = selectedProcessorId;
+    setTelemetrySamples([]);
+    callRPC(Request.create({ setTelemetry: { id, enabled: true } }))
+      .then((resp) => {
+        if (resp?.setTelemetry) {
+          setTelemetryIntervalMs(resp.setTelemetry.intervalMs);
+        } else if (resp?.error) {
+          setError(
+            "Telemetry is not available. Enable CONFIG_ZMK_RUNTIME_INPUT_PROCESSOR_TELEMETRY."
+          );
+          setTelemetryEnabled(false);
+        }
+      })
+      .catch((err) => {
+        setError(
+          `Failed to start telemetry: ${err instanceof Error ? err.message : "Unknown error"}`
+        );
+        setTelemetryEnabled(false);
+      });
+    return () => {
+      callRPC(Request.create({ setTelemetry: { id, enabled: false } })).catch(
+        (err) => console.error("Failed to stop telemetry:", err)
+      );
+    };
+  }, [telemetryEnabled, selectedProcessorId, callRPC]);
+
   // Subscribe to notifications for processor changes
   useEffect(() => {
     if (!zmkApp || !subsystem) return;
@@ -511,6 +777,15 @@ export function InputProcessorManager() {
         try {
           // notification.payload contains the encoded Notification message
           const decoded = Notification.decode(notification.payload);
+          if (
+            decoded.telemetry &&
+            decoded.telemetry.id === selectedProcessorId
+          ) {
+            const samples = decoded.telemetry.samples;
+            setTelemetrySamples((prev) =>
+              [...prev, ...samples].slice(-TELEMETRY_HISTORY)
+            );
+          }
           if (decoded.inputProcessorChanged?.processor) {
             const proc = decoded.inputProcessorChanged.processor;
 
@@ -538,6 +813,11 @@ export function InputProcessorManager() {
               setTempLayerLayer(proc.tempLayerLayer);
               setTempLayerActivationDelay(proc.tempLayerActivationDelayMs);
               setTempLayerDeactivationDelay(proc.tempLayerDeactivationDelayMs);
+              setTempLayerActivationThreshold(
+                proc.tempLayerActivationThreshold
+              );
+              setTempLayerReleaseThreshold(proc.tempLayerReleaseThreshold);
+              setTempLayerMotionWindow(proc.tempLayerMotionWindowMs);
               setActiveLayers(proc.activeLayers);
               setAxisSnapMode(proc.axisSnapMode);
               setAxisSnapThreshold(proc.axisSnapThreshold);
@@ -546,6 +826,18 @@ export function InputProcessorManager() {
               setXySwapEnabled(proc.xySwapEnabled);
               setXInvert(proc.xInvert);
               setYInvert(proc.yInvert);
+              setAccelCurve(proc.accelCurve);
+              setAccelSpeedMax(proc.accelSpeedMax);
+              setAccelGainMax(proc.accelGainMax);
+              setAccelExponent(proc.accelExponent);
+              setAccelLut(proc.accelLut.join(", "));
+              setFilterDeadZone(proc.filterDeadZone);
+              setFilterIirShift(proc.filterIirShift);
+              setFilterIdleMs(proc.filterIdleMs);
+              setScrollScaleMultiplier(proc.scrollScaleMultiplier);
+              setScrollScaleDivisor(proc.scrollScaleDivisor);
+              setScrollHiresMultiplier(proc.scrollHiresMultiplier);
+              setScrollSnap(proc.scrollSnap);
             }
 
             // If no processor is selected yet, select the first one
@@ -558,6 +850,11 @@ export function InputProcessorManager() {
               setTempLayerLayer(proc.tempLayerLayer);
               setTempLayerActivationDelay(proc.tempLayerActivationDelayMs);
               setTempLayerDeactivationDelay(proc.tempLayerDeactivationDelayMs);
+              setTempLayerActivationThreshold(
+                proc.tempLayerActivationThreshold
+              );
+              setTempLayerReleaseThreshold(proc.tempLayerReleaseThreshold);
+              setTempLayerMotionWindow(proc.tempLayerMotionWindowMs);
               setActiveLayers(proc.activeLayers);
               setAxisSnapMode(proc.axisSnapMode);
               setAxisSnapThreshold(proc.axisSnapThreshold);
@@ -566,6 +863,18 @@ export function InputProcessorManager() {
               setXySwapEnabled(proc.xySwapEnabled);
               setXInvert(proc.xInvert);
               setYInvert(proc.yInvert);
+              setAccelCurve(proc.accelCurve);
+              setAccelSpeedMax(proc.accelSpeedMax);
+              setAccelGainMax(proc.accelGainMax);
+              setAccelExponent(proc.accelExponent);
+              setAccelLut(proc.accelLut.join(", "));
+              setFilterDeadZone(proc.filterDeadZone);
+              setFilterIirShift(proc.filterIirShift);
+              setFilterIdleMs(proc.filterIdleMs);
+              setScrollScaleMultiplier(proc.scrollScaleMultiplier);
+              setScrollScaleDivisor(proc.scrollScaleDivisor);
+              setScrollHiresMultiplier(proc.scrollHiresMultiplier);
+              setScrollSnap(proc.scrollSnap);
             }
           }
         } catch (err) {
@@ -579,6 +888,8 @@ export function InputProcessorManager() {
 
   if (!zmkApp) return null;
 
+  const latestTelemetry = telemetrySamples[telemetrySamples.length - 1];
+
   if (!subsystem) {
     return (
       <section className="card">
@@ -818,6 +1129,90 @@ export function InputProcessorManager() {
                   Delay before deactivating layer after input stops (0-5000ms)
                 </div>
               </div>
+
+              <div className="input-group">
+                <label htmlFor="activation-threshold">
+                  Activation Threshold (counts):
+                </label>
+                <input
+                  id="activation-threshold"
+                  type="number"
+                  min="0"
+                  max="65535"
+                  value={tempLayerActivationThreshold}
+                  onChange={(e) =>
+                    setTempLayerActivationThreshold(
+                      parseInt(e.target.value) || 0
+                    )
+                  }
+                />
+                <div
+                  style={{
+                    fontSize: "0.85em",
+                    color: "#666",
+                    marginTop: "0.25rem",
+                  }}
+                >
+                  Motion needed to activate the layer, so bumping the desk does
+                  not switch layers (0 = first motion)
+                </div>
+              </div>
+
+              {tempLayerActivationThreshold > 0 && (
+                <>
+                  <div className="input-group">
+                    <label htmlFor="release-threshold">
+                      Release Threshold (counts):
+                    </label>
+                    <input
+                      id="release-threshold"
+                      type="number"
+                      min="0"
+                      max={tempLayerActivationThreshold}
+                      value={tempLayerReleaseThreshold}
+                      onChange={(e) =>
+                        setTempLayerReleaseThreshold(
+                          parseInt(e.target.value) || 0
+                        )
+                      }
+                    />
+                    <div
+                      style={{
+                        fontSize: "0.85em",
+                        color: "#666",
+                        marginTop: "0.25rem",
+                      }}
+                    >
+                      Motion below this no longer keeps the layer active, so it
+                      is released once the pointer settles (0 = any motion)
+                    </div>
+                  </div>
+
+                  <div className="input-group">
+                    <label htmlFor="motion-window">Motion Window (ms):</label>
+                    <input
+                      id="motion-window"
+                      type="number"
+                      min="0"
+                      max="65535"
+                      step="10"
+                      value={tempLayerMotionWindow}
+                      onChange={(e) =>
+                        setTempLayerMotionWindow(parseInt(e.target.value) || 0)
+                      }
+                    />
+                    <div
+                      style={{
+                        fontSize: "0.85em",
+                        color: "#666",
+                        marginTop: "0.25rem",
+                      }}
+                    >
+                      Half-life of the accumulated motion (0 = per event)
+                    </div>
+                  </div>
+                </>
+              )}
             </>
           )}
 
@@ -934,6 +1329,9 @@ export function InputProcessorManager() {
               <option value={AxisSnapMode.AXIS_SNAP_MODE_Y}>
                 Snap to Y Axis
               </option>
+              <option value={AxisSnapMode.AXIS_SNAP_MODE_AUTO}>
+                Auto (Dominant Axis)
+              </option>
             </select>
             <div
               style={{
@@ -1028,6 +1426,103 @@ export function InputProcessorManager() {
             </div>
           </div>
 
+          {xyToScrollEnabled && (
+            <>
+              <div className="input-group">
+                <label htmlFor="scroll-scale-multiplier">
+                  Scroll Multiplier:
+                </label>
+                <input
+                  id="scroll-scale-multiplier"
+                  type="number"
+                  min="1"
+                  max="100"
+                  value={scrollScaleMultiplier}
+                  onChange={(e) =>
+                    setScrollScaleMultiplier(parseInt(e.target.value) || 1)
+                  }
+                />
+              </div>
+
+              <div className="input-group">
+                <label htmlFor="scroll-scale-divisor">Scroll Divisor:</label>
+                <input
+                  id="scroll-scale-divisor"
+                  type="number"
+                  min="0"
+                  max="1000"
+                  value={scrollScaleDivisor}
+                  onChange={(e) =>
+                    setScrollScaleDivisor(parseInt(e.target.value) || 0)
+                  }
+                />
+                <div
+                  style={{
+                    fontSize: "0.85em",
+                    color: "#666",
+                    marginTop: "0.25rem",
+                  }}
+                >
+                  Scroll multiplier / divisor detents per count, passed on in
+                  whole wheel units (0 = use the pointer scaling)
+                </div>
+              </div>
+
+              {scrollScaleDivisor > 0 && (
+                <>
+                  <div className="input-group">
+                    <label htmlFor="scroll-hires-multiplier">
+                      High-Resolution Units per Detent:
+                    </label>
+                    <input
+                      id="scroll-hires-multiplier"
+                      type="number"
+                      min="0"
+                      max="120"
+                      value={scrollHiresMultiplier}
+                      onChange={(e) =>
+                        setScrollHiresMultiplier(parseInt(e.target.value) || 0)
+                      }
+                    />
+                    <div
+                      style={{
+                        fontSize: "0.85em",
+                        color: "#666",
+                        marginTop: "0.25rem",
+                      }}
+                    >
+                      For hosts with high-resolution scrolling (0 = whole
+                      detents)
+                    </div>
+                  </div>
+
+                  <div className="input-group">
+                    <label htmlFor="scroll-snap">
+                      <input
+                        id="scroll-snap"
+                        type="checkbox"
+                        checked={scrollSnap}
+                        onChange={(e) => setScrollSnap(e.target.checked)}
+                        style={{ marginRight: "0.5rem" }}
+                      />
+                      Scroll Snap
+                    </label>
+                    <div
+                      style={{
+                        fontSize: "0.85em",
+                        color: "#666",
+                        marginTop: "0.25rem",
+                        marginLeft: "1.7rem",
+                      }}
+                    >
+                      Only scroll along the dominant axis
+                    </div>
+                  </div>
+                </>
+              )}
+            </>
+          )}
+
           <div className="input-group">
             <label htmlFor="xy-swap-enabled">
               <input
@@ -1101,6 +1596,190 @@ export function InputProcessorManager() {
             </div>
           </div>
 
+          <hr style={{ margin: "1.5rem 0", border: "1px solid #e0e0e0" }} />
+
+          <h3>Pointer Acceleration</h3>
+          <p style={{ fontSize: "0.9em", color: "#666", marginBottom: "1rem" }}>
+            Increase the gain as the input speed (sensor counts per second)
+            rises
+          </p>
+
+          <div className="input-group">
+            <label htmlFor="accel-curve">Curve:</label>
+            <select
+              id="accel-curve"
+              value={accelCurve}
+              onChange={(e) =>
+                setAccelCurve(parseInt(e.target.value) as AccelCurve)
+              }
+              style={{ padding: "0.5rem", fontSize: "1rem" }}
+            >
+              <option value={AccelCurve.ACCEL_CURVE_NONE}>None</option>
+              <option value={AccelCurve.ACCEL_CURVE_LINEAR}>Linear</option>
+              <option value={AccelCurve.ACCEL_CURVE_POWER}>Power</option>
+              <option value={AccelCurve.ACCEL_CURVE_LUT}>Lookup Table</option>
+            </select>
+          </div>
+
+          {accelCurve !== AccelCurve.ACCEL_CURVE_NONE && (
+            <>
+              <div className="input-group">
+                <label htmlFor="accel-speed-max">Max Speed (counts/s):</label>
+                <input
+                  id="accel-speed-max"
+                  type="number"
+                  min="1"
+                  max="65535"
+                  step="100"
+                  value={accelSpeedMax}
+                  onChange={(e) =>
+                    setAccelSpeedMax(parseInt(e.target.value) || 1)
+                  }
+                />
+                <div
+                  style={{
+                    fontSize: "0.85em",
+                    color: "#666",
+                    marginTop: "0.25rem",
+                  }}
+                >
+                  Speed where the curve reaches its last point
+                </div>
+              </div>
+
+              {accelCurve !== AccelCurve.ACCEL_CURVE_LUT && (
+                <div className="input-group">
+                  <label htmlFor="accel-gain-max">Max Gain (%):</label>
+                  <input
+                    id="accel-gain-max"
+                    type="number"
+                    min="0"
+                    max="2000"
+                    step="10"
+                    value={accelGainMax}
+                    onChange={(e) =>
+                      setAccelGainMax(parseInt(e.target.value) || 0)
+                    }
+                  />
+                </div>
+              )}
+
+              {accelCurve === AccelCurve.ACCEL_CURVE_POWER && (
+                <div className="input-group">
+                  <label htmlFor="accel-exponent">Exponent (x100):</label>
+                  <input
+                    id="accel-exponent"
+                    type="number"
+                    min="0"
+                    max="1000"
+                    step="10"
+                    value={accelExponent}
+                    onChange={(e) =>
+                      setAccelExponent(parseInt(e.target.value) || 0)
+                    }
+                  />
+                </div>
+              )}
+
+              {accelCurve === AccelCurve.ACCEL_CURVE_LUT && (
+                <div className="input-group">
+                  <label htmlFor="accel-lut">Gain Points (%):</label>
+                  <input
+                    id="accel-lut"
+                    type="text"
+                    value={accelLut}
+                    onChange={(e) => setAccelLut(e.target.value)}
+                    placeholder="100, 120, 180, 260, 300"
+                  />
+                  <div
+                    style={{
+                      fontSize: "0.85em",
+                      color: "#666",
+                      marginTop: "0.25rem",
+                    }}
+                  >
+                    2-16 comma separated gains at evenly spaced speeds from 0
+                    to max speed
+                  </div>
+                </div>
+              )}
+            </>
+          )}
+
+          <hr style={{ margin: "1.5rem 0", border: "1px solid #e0e0e0" }} />
+
+          <h3>Jitter Filter</h3>
+          <p style={{ fontSize: "0.9em", color: "#666", marginBottom: "1rem" }}>
+            Drop sensor noise while the pointer rests and smooth the motion
+          </p>
+
+          <div className="input-group">
+            <label htmlFor="filter-dead-zone">Dead Zone (counts):</label>
+            <input
+              id="filter-dead-zone"
+              type="number"
+              min="0"
+              max="1000"
+              value={filterDeadZone}
+              onChange={(e) => setFilterDeadZone(parseInt(e.target.value) || 0)}
+            />
+            <div
+              style={{
+                fontSize: "0.85em",
+                color: "#666",
+                marginTop: "0.25rem",
+              }}
+            >
+              Travel needed to wake the pointer from rest (0 = off)
+            </div>
+          </div>
+
+          {filterDeadZone > 0 && (
+            <div className="input-group">
+              <label htmlFor="filter-idle">Idle Window (ms):</label>
+              <input
+                id="filter-idle"
+                type="number"
+                min="0"
+                max="65535"
+                step="10"
+                value={filterIdleMs}
+                onChange={(e) => setFilterIdleMs(parseInt(e.target.value) || 0)}
+              />
+              <div
+                style={{
+                  fontSize: "0.85em",
+                  color: "#666",
+                  marginTop: "0.25rem",
+                }}
+              >
+                Travel is summed over this window; the pointer rests again when
+                a window ends within the dead zone (0 = per event)
+              </div>
+            </div>
+          )}
+
+          <div className="input-group">
+            <label htmlFor="filter-iir-shift">Smoothing:</label>
+            <input
+              id="filter-iir-shift"
+              type="number"
+              min="0"
+              max="8"
+              value={filterIirShift}
+              onChange={(e) => setFilterIirShift(parseInt(e.target.value) || 0)}
+            />
+            <div
+              style={{
+                fontSize: "0.85em",
+                color: "#666",
+                marginTop: "0.25rem",
+              }}
+            >
+              Each step halves the weight of a new sample (0 = off)
+            </div>
+          </div>
+
           <button
             className="btn btn-primary"
             onClick={updateProcessor}
@@ -1110,6 +1789,257 @@ export function InputProcessorManager() {
           </button>
         </section>
       )}
+
+      {selectedProcessorId !== null && (
+        <section className="card">
+          <h2>Profiles</h2>
+          <p style={{ fontSize: "0.9em", color: "#666", marginBottom: "1rem" }}>
+            Store the saved configuration on the device and switch between
+            stored profiles instantly
+          </p>
+
+          {profiles.length === 0 && <p>No stored profiles.</p>}
+          {profiles.map((profile) => (
+            <div
+              key={profile.index}
+              style={{
+                display: "flex",
+                gap: "0.5rem",
+                alignItems: "center",
+                margin: "0.5rem 0",
+              }}
+            >
+              <span style={{ flex: 1 }}>
+                {profile.index}: {profile.name}
+                {activeProfile === profile.index && " (active)"}
+              </span>
+              <button
+                className="btn btn-primary"
+                onClick={() =>
+                  profileAction(
+                    Request.create({
+                      selectProfile: {
+                        id: selectedProcessorId,
+                        index: profile.index,
+                        persistent: true,
+                      },
+                    })
+                  )
+                }
+              >
+                Select
+              </button>
+              <button
+                className="btn btn-secondary"
+                onClick={() =>
+                  profileAction(
+                    Request.create({
+                      deleteProfile: {
+                        id: selectedProcessorId,
+                        index: profile.index,
+                      },
+                    })
+                  )
+                }
+              >
+                Delete
+              </button>
+            </div>
+          ))}
+
+          <div className="input-group">
+            <label htmlFor="profile-index">Profile Index:</label>
+            <input
+              id="profile-index"
+              type="number"
+              min="0"
+              max="7"
+              value={profileIndex}
+              onChange={(e) => setProfileIndex(parseInt(e.target.value) || 0)}
+            />
+          </div>
+
+          <div className="input-group">
+            <label htmlFor="profile-name">Profile Name:</label>
+            <input
+              id="profile-name"
+              type="text"
+              value={profileName}
+              onChange={(e) => setProfileName(e.target.value)}
+            />
+          </div>
+
+          <button
+            className="btn btn-primary"
+            onClick={() =>
+              profileAction(
+                Request.create({
+                  saveProfile: {
+                    id: selectedProcessorId,
+                    index: profileIndex,
+                    name: profileName,
+                  },
+                })
+              )
+            }
+          >
+            💾 Save Current as Profile
+          </button>
+        </section>
+      )}
+
+      {selectedProcessorId !== null && (
+        <section className="card">
+          <h2>Statistics</h2>
+          <p style={{ fontSize: "0.9em", color: "#666", marginBottom: "1rem" }}>
+            Event counts and event handler timing collected on the device
+          </p>
+
+          <div style={{ display: "flex", gap: "0.5rem", marginBottom: "1rem" }}>
+            <button
+              className="btn btn-primary"
+              onClick={() => loadStats(false)}
+            >
+              📊 Load Statistics
+            </button>
+            <button
+              className="btn btn-secondary"
+              onClick={() => loadStats(true)}
+            >
+              Load and Reset
+            </button>
+          </div>
+
+          {stats && (
+            <>
+              <table style={{ width: "100%", marginBottom: "1rem" }}>
+                <tbody>
+                  <tr>
+                    <td>Events</td>
+                    <td>{stats.events}</td>
+                  </tr>
+                  <tr>
+                    <td>Processed</td>
+                    <td>{stats.processed}</td>
+                  </tr>
+                  {stats.stageEvents.map((count, i) => (
+                    <tr key={i}>
+                      <td>
+                        &nbsp;&nbsp;{STATS_STAGE_NAMES[i] ?? `Stage ${i}`}
+                      </td>
+                      <td>{count}</td>
+                    </tr>
+                  ))}
+                  <tr>
+                    <td>Suppressed by Axis Snap</td>
+                    <td>{stats.snapSuppressed}</td>
+                  </tr>
+                  <tr>
+                    <td>Dropped by Rotation Pairing</td>
+                    <td>{stats.rotationDropped}</td>
+                  </tr>
+                  <tr>
+                    <td>Saturated Values</td>
+                    <td>{stats.overflows}</td>
+                  </tr>
+                  <tr>
+                    <td>Temp-Layer Activations</td>
+                    <td>{stats.tempLayerActivations}</td>
+                  </tr>
+                  <tr>
+                    <td>Held Back by Coalescing</td>
+                    <td>{stats.coalesced}</td>
+                  </tr>
+                  <tr>
+                    <td>Dropped by Filter</td>
+                    <td>{stats.filterDropped}</td>
+                  </tr>
+                  <tr>
+                    <td>Held Below a Scroll Unit</td>
+                    <td>{stats.scrollHeld}</td>
+                  </tr>
+                </tbody>
+              </table>
+
+              <h3>Event Handler Duration</h3>
+              <table style={{ width: "100%" }}>
+                <tbody>
+                  {stats.cycleHistogram.map((count, i) =>
+                    count > 0 ? (
+                      <tr key={i}>
+                        <td>
+                          {histogramBucketLabel(
+                            i,
+                            stats.cycleHistogram.length,
+                            stats.cyclesPerSecond
+                          )}
+                        </td>
+                        <td>{count}</td>
+                      </tr>
+                    ) : null
+                  )}
+                  <tr>
+                    <td>Max</td>
+                    <td>
+                      {formatCycles(stats.cyclesMax, stats.cyclesPerSecond)}
+                    </td>
+                  </tr>
+                </tbody>
+              </table>
+            </>
+          )}
+        </section>
+      )}
+
+      {selectedProcessorId !== null && (
+        <section className="card">
+          <h2>Live Telemetry</h2>
+          <p style={{ fontSize: "0.9em", color: "#666", marginBottom: "1rem" }}>
+            Input (grey) and output (blue) motion summed over short windows on
+            the device
+            {telemetryIntervalMs > 0 && ` (${telemetryIntervalMs} ms each)`}
+          </p>
+
+          <div className="input-group">
+            <label htmlFor="telemetry-enabled">
+              <input
+                id="telemetry-enabled"
+                type="checkbox"
+                checked={telemetryEnabled}
+                onChange={(e) => setTelemetryEnabled(e.target.checked)}
+                style={{ marginRight: "0.5rem" }}
+              />
+              Stream Telemetry
+            </label>
+          </div>
+
+          {telemetryEnabled && telemetrySamples.length > 0 && (
+            <>
+              <TelemetryPlot samples={telemetrySamples} />
+              <table style={{ width: "100%", marginTop: "0.5rem" }}>
+                <tbody>
+                  <tr>
+                    <td>Axis Snap</td>
+                    <td>{telemetrySnapLabel(latestTelemetry)}</td>
+                  </tr>
+                  <tr>
+                    <td>Temp-Layer</td>
+                    <td>
+                      {latestTelemetry.tempLayerActive ? "Active" : "Inactive"}
+                    </td>
+                  </tr>
+                  <tr>
+                    <td>Windows Lost</td>
+                    <td>
+                      {telemetrySamples.reduce((n, s) => n + s.lost, 0)}
+                    </td>
+                  </tr>
+                </tbody>
+              </table>
+            </>
+          )}
+        </section>
+      )}
     </>
   );
 }